@@ -23,7 +23,9 @@ enum class GameAction
 	PAUSE,
 	RETURN,
 	PLAY,
-	OPTIONS
+	OPTIONS,
+	SAVE,
+	LOAD
 };
 
 extern std::atomic<GameAction> game_action;
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "AliveSet.h"
+#include "Bits.h"
+
+#include <cstring>
+
+void AliveSet::reset(int formation_rows, int formation_columns)
+{
+	columns = formation_columns;
+	count = formation_rows * formation_columns;
+
+	std::memset(words, 0, sizeof(words));
+	std::memset(rows, 0, sizeof(rows));
+
+	//whole words first, then the bits of the last one
+	for (int i = 0; i < count / 64; i++)
+	{
+		words[i] = ~0ull;
+	}
+
+	if (count % 64)
+	{
+		words[count / 64] = (1ull << (count % 64)) - 1;
+	}
+
+	uint64_t row = (columns == 64) ? ~0ull : ((1ull << columns) - 1);
+
+	for (int i = 0; i < formation_rows; i++)
+	{
+		rows[i] = row;
+	}
+}
+
+
+
+void AliveSet::rebuild(const Life* life, int formation_rows,
+	int formation_columns)
+{
+	columns = formation_columns;
+	count = 0;
+
+	std::memset(words, 0, sizeof(words));
+	std::memset(rows, 0, sizeof(rows));
+
+	for (int i = 0; i < formation_rows * formation_columns; i++)
+	{
+		if (life[i].alive)
+		{
+			words[i / 64] |= 1ull << (i % 64);
+			rows[i / columns] |= 1ull << (i % columns);
+			count++;
+		}
+	}
+}
+
+
+
+void AliveSet::kill(int alien)
+{
+	uint64_t bit = 1ull << (alien % 64);
+
+	if (words[alien / 64] & bit)
+	{
+		words[alien / 64] &= ~bit;
+		rows[alien / columns] &= ~(1ull << (alien % columns));
+		count--;
+	}
+}
+
+
+
+const bool AliveSet::isAlive(int alien)
+{
+	return (words[alien / 64] >> (alien % 64)) & 1;
+}
+
+
+
+const bool AliveSet::isEmpty()
+{
+	return count == 0;
+}
+
+
+
+const int AliveSet::getCount()
+{
+	return count;
+}
+
+
+
+const uint64_t AliveSet::getRow(int row)
+{
+	return rows[row];
+}
+
+
+
+const int AliveSet::next(int alien)
+{
+	if ((alien < 0) || (alien >= ALIVE_WORDS * 64))
+	{
+		return -1;
+	}
+
+	//rest of the word alien is in, then whole words
+	int word = alien / 64;
+	uint64_t bits = words[word] & (~0ull << (alien % 64));
+
+	while (bits == 0)
+	{
+		if (++word == ALIVE_WORDS)
+		{
+			return -1;
+		}
+
+		bits = words[word];
+	}
+
+	return word * 64 + lowestBit(bits);
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+
+#include "Components.h"
+#include "WaveConfig.h"
+
+/** @file AliveSet.h
+    @brief   Which aliens are alive, one bit each.
+    @details Bits are packed into 64 bit words in formation order, with a
+             second copy per row indexed by column and a count of the set
+             bits. Loops over living aliens jump from one set bit to the
+             next with a trailing zero count, so the dead slots of a late
+             wave cost nothing. Whether the wave is cleared is just the
+             count. The set mirrors the aliens' Life::alive and is changed
+             alongside it, on a kill, a new wave or a restore.
+*/
+
+constexpr int ALIVE_WORDS = (MAX_ALIENS + 63) / 64; /**< words in the set */
+
+static_assert(MAX_WAVE_COLUMNS <= 64, "a row is one 64 bit mask");
+
+class AliveSet
+{
+public:
+	AliveSet() = default;
+	~AliveSet() = default;
+
+	void reset(int rows, int columns); //every alien alive
+	void rebuild(const Life* life, int rows, int columns); //from alive flags
+	void kill(int alien); //clear alien's bit
+
+	const bool isAlive(int alien); //alien's bit is set
+	const bool isEmpty(); //the wave has been cleared
+	const int getCount(); //aliens alive
+	const uint64_t getRow(int row); //bit per column of row
+
+	//first living alien at or after alien, -1 if there are none, so
+	//for (int i = set.next(0); i >= 0; i = set.next(i + 1)) visits each
+	const int next(int alien);
+
+private:
+	uint64_t words[ALIVE_WORDS] = {}; //bit per alien in formation order
+	uint64_t rows[MAX_WAVE_ROWS] = {}; //bit per column, by row
+	int columns = 0; //aliens per row
+	int count =   0; //set bits
+};
@@ -0,0 +1,390 @@
+#include "AssetPack.h"
+
+#include <irrKlang.h>
+
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	/**
+	*   @brief   irrKlang file reader over a view into the mapped archive.
+	*   @details Used for RAW entries (anything the packer could not decode
+	*            to PCM), irrKlang still decodes these itself but reads the
+	*            bytes from memory instead of opening another file.
+	*/
+	class PackFileReader :
+		public irrklang::IFileReader
+	{
+	public:
+		PackFileReader(const unsigned char* bytes, irrklang::ik_s32 length,
+			const char* file_name)
+			: data(bytes), size(length), name(file_name)
+		{
+
+		}
+
+		irrklang::ik_s32 read(void* buffer, irrklang::ik_u32 size_to_read) override
+		{
+			irrklang::ik_s32 remaining = size - position;
+			irrklang::ik_s32 count = (irrklang::ik_s32)size_to_read < remaining ?
+				(irrklang::ik_s32)size_to_read : remaining;
+
+			memcpy(buffer, data + position, count);
+			position += count;
+
+			return count;
+		}
+
+		bool seek(irrklang::ik_s32 final_pos, bool relative_movement) override
+		{
+			irrklang::ik_s32 target = relative_movement ?
+				position + final_pos : final_pos;
+
+			if ((target < 0) || (target > size))
+			{
+				return false;
+			}
+
+			position = target;
+			return true;
+		}
+
+		irrklang::ik_s32 getSize() override
+		{
+			return size;
+		}
+
+		irrklang::ik_s32 getPos() override
+		{
+			return position;
+		}
+
+		const irrklang::ik_c8* getFileName() override
+		{
+			return name;
+		}
+
+	private:
+		const unsigned char* data = nullptr;
+		irrklang::ik_s32 size =     0;
+		irrklang::ik_s32 position = 0;
+		const char* name =          nullptr;
+	};
+
+
+
+	/**
+	*   @brief   irrKlang file factory backed by the archive.
+	*   @details Returns 0 for names that are not in the archive so irrKlang
+	*            falls back to its own file access.
+	*/
+	class PackFileFactory :
+		public irrklang::IFileFactory
+	{
+	public:
+		explicit PackFileFactory(AssetPack* assets)
+			: pack(assets)
+		{
+
+		}
+
+		irrklang::IFileReader* createFileReader(
+			const irrklang::ik_c8* file_name) override
+		{
+			const PackEntry* entry = pack->find(file_name);
+
+			if (!entry || entry->type != (uint32_t)PackEntryType::RAW)
+			{
+				return nullptr;
+			}
+
+			return new PackFileReader(
+				static_cast<const unsigned char*>(pack->getData(entry)),
+				(irrklang::ik_s32)entry->size, entry->name);
+		}
+
+	private:
+		AssetPack* pack = nullptr;
+	};
+}
+
+
+
+AssetPack::~AssetPack()
+{
+	close();
+}
+
+
+
+bool AssetPack::open(const char* file_name)
+{
+	close();
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(file_name, GENERIC_READ, FILE_SHARE_READ,
+		nullptr, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(
+		file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	if (!mapping)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+	if (!view)
+	{
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	file_handle = file;
+	mapping_handle = mapping;
+	size = (size_t)file_size.QuadPart;
+#else
+	int fd = ::open(file_name, O_RDONLY);
+
+	if (fd < 0)
+	{
+		return false;
+	}
+
+	struct stat file_stat;
+	if ((fstat(fd, &file_stat) != 0) || (file_stat.st_size == 0))
+	{
+		::close(fd);
+		return false;
+	}
+
+	void* view = mmap(nullptr, (size_t)file_stat.st_size,
+		PROT_READ, MAP_PRIVATE, fd, 0);
+
+	if (view == MAP_FAILED)
+	{
+		::close(fd);
+		return false;
+	}
+
+	file_descriptor = fd;
+	size = (size_t)file_stat.st_size;
+#endif
+
+	data = static_cast<const unsigned char*>(view);
+
+	if (!validate())
+	{
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+
+
+void AssetPack::close()
+{
+	if (!data)
+	{
+		return;
+	}
+
+#ifdef _WIN32
+	UnmapViewOfFile(data);
+	CloseHandle(mapping_handle);
+	CloseHandle(file_handle);
+
+	mapping_handle = nullptr;
+	file_handle = nullptr;
+#else
+	munmap(const_cast<unsigned char*>(data), size);
+	::close(file_descriptor);
+
+	file_descriptor = -1;
+#endif
+
+	data = nullptr;
+	size = 0;
+	entries = nullptr;
+	entry_count = 0;
+}
+
+
+
+const bool AssetPack::isOpen()
+{
+	return data != nullptr;
+}
+
+
+
+bool AssetPack::validate()
+{
+	//header must be present and match this build
+	if (size < sizeof(PackHeader))
+	{
+		return false;
+	}
+
+	const PackHeader* header = reinterpret_cast<const PackHeader*>(data);
+
+	if ((memcmp(header->magic, "IPAK", 4) != 0) ||
+		(header->version != PACK_VERSION))
+	{
+		return false;
+	}
+
+	//index and every payload must sit inside the mapping, the index is
+	//read in place so has to be aligned for its fields too, the mapping
+	//itself starts on a page
+	size_t index_end = (size_t)header->index_offset +
+		(size_t)header->entry_count * sizeof(PackEntry);
+
+	if ((index_end > size) ||
+		(header->index_offset % alignof(PackEntry) != 0))
+	{
+		return false;
+	}
+
+	const PackEntry* index =
+		reinterpret_cast<const PackEntry*>(data + header->index_offset);
+
+	for (uint32_t i = 0; i < header->entry_count; i++)
+	{
+		const PackEntry& entry = index[i];
+
+		if ((size_t)entry.offset + entry.size > size)
+		{
+			return false;
+		}
+
+		//names are handed on as C strings
+		if (!memchr(entry.name, '\0', sizeof(entry.name)))
+		{
+			return false;
+		}
+
+		//irrKlang reads frames of 16 bit samples straight from the mapping
+		if ((entry.type == (uint32_t)PackEntryType::PCM) &&
+			((entry.channels == 0) ||
+			((uint64_t)entry.frames * entry.channels * 2 > entry.size)))
+		{
+			return false;
+		}
+	}
+
+	entries = index;
+	entry_count = header->entry_count;
+
+	return true;
+}
+
+
+
+const PackEntry* AssetPack::find(const char* name)
+{
+	//index is sorted by name so binary search it
+	uint32_t low = 0;
+	uint32_t high = entry_count;
+
+	while (low < high)
+	{
+		uint32_t mid = (low + high) / 2;
+		int compare = strncmp(name, entries[mid].name, sizeof(PackEntry::name));
+
+		if (compare == 0)
+		{
+			return &entries[mid];
+		}
+
+		else if (compare < 0)
+		{
+			high = mid;
+		}
+
+		else
+		{
+			low = mid + 1;
+		}
+	}
+
+	return nullptr;
+}
+
+
+
+const void* AssetPack::getData(const PackEntry* entry)
+{
+	return data + entry->offset;
+}
+
+
+
+int AssetPack::registerSounds(irrklang::ISoundEngine* engine)
+{
+	using namespace irrklang;
+
+	if (!data)
+	{
+		return 0;
+	}
+
+	int registered = 0;
+
+	for (uint32_t i = 0; i < entry_count; i++)
+	{
+		if (entries[i].type != (uint32_t)PackEntryType::PCM)
+		{
+			continue;
+		}
+
+		SAudioStreamFormat format;
+		format.ChannelCount = entries[i].channels;
+		format.FrameCount = (ik_s32)entries[i].frames;
+		format.SampleRate = (ik_s32)entries[i].sample_rate;
+		format.SampleFormat = ESF_S16;
+
+		//mapping outlives the engine so irrKlang can borrow the samples
+		void* samples = const_cast<void*>(getData(&entries[i]));
+
+		if (engine->addSoundSourceFromPCMData(samples,
+			(ik_s32)entries[i].size, entries[i].name, format, false))
+		{
+			registered++;
+		}
+	}
+
+	//everything else is served to irrKlang from the mapping as a file
+	PackFileFactory* factory = new PackFileFactory(this);
+	engine->addFileFactory(factory);
+	factory->drop();
+
+	return registered;
+}
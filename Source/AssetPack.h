@@ -0,0 +1,92 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/** @file AssetPack.h
+    @brief   Packed asset archive shared by the game and the asset packer.
+    @details Resources.pak is a single indexed file that is memory mapped
+             at start up. Sound entries are stored as decoded 16-bit PCM so
+             irrKlang can play straight out of the mapped view without any
+             copying or WAV parsing.
+*/
+
+namespace irrklang
+{
+	class ISoundEngine;
+}
+
+constexpr uint32_t PACK_VERSION =   1;  /**< Current archive format version. */
+constexpr uint32_t PACK_ALIGNMENT = 16; /**< Payload alignment in bytes. */
+
+/** @enum PackEntryType
+*   @brief how an archive entry payload is stored
+*/
+enum class PackEntryType : uint32_t
+{
+	RAW = 0, /**< file bytes copied unchanged */
+	PCM = 1  /**< decoded signed 16-bit little endian samples */
+};
+
+/** @struct PackHeader
+*   @brief fixed header at the start of every archive
+*/
+struct PackHeader
+{
+	char     magic[4];     /**< always "IPAK" */
+	uint32_t version;      /**< PACK_VERSION the archive was built with */
+	uint32_t entry_count;  /**< number of entries in the index */
+	uint32_t index_offset; /**< byte offset of the first PackEntry */
+};
+
+/** @struct PackEntry
+*   @brief index record, entries are sorted by name for binary search
+*/
+struct PackEntry
+{
+	char     name[48];    /**< path relative to Resources, e.g. "Audio/Laser1.wav" */
+	uint32_t type;        /**< PackEntryType */
+	uint32_t offset;      /**< byte offset of the payload */
+	uint32_t size;        /**< payload size in bytes */
+	uint32_t sample_rate; /**< PCM only, samples per second */
+	uint32_t frames;      /**< PCM only, number of sample frames */
+	uint16_t channels;    /**< PCM only, 1 = mono, 2 = stereo */
+	uint16_t reserved;    /**< padding, always zero */
+};
+
+static_assert(sizeof(PackHeader) == 16, "PackHeader layout changed");
+static_assert(sizeof(PackEntry) == 72, "PackEntry layout changed");
+
+class AssetPack
+{
+public:
+	AssetPack() = default;
+	~AssetPack();
+
+	AssetPack(const AssetPack&) = delete;
+	AssetPack& operator=(const AssetPack&) = delete;
+
+	bool open(const char* file_name); //map archive into memory
+	void close(); //unmap archive
+	const bool isOpen(); //is an archive mapped
+
+	const PackEntry* find(const char* name); //look up entry by name
+	const void* getData(const PackEntry* entry); //view of entry payload
+
+	//hand every sound entry to irrKlang without copying
+	int registerSounds(irrklang::ISoundEngine* engine);
+
+private:
+	bool validate(); //check header and index bounds
+
+	const unsigned char* data = nullptr; //mapped archive bytes
+	size_t size =               0; //mapped size in bytes
+	const PackEntry* entries =  nullptr; //index table inside mapping
+	uint32_t entry_count =      0; //number of index entries
+
+#ifdef _WIN32
+	void* file_handle =    nullptr; //win32 file handle
+	void* mapping_handle = nullptr; //win32 file mapping handle
+#else
+	int file_descriptor = -1; //posix file descriptor
+#endif
+};
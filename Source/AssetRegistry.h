@@ -0,0 +1,98 @@
+#pragma once
+#include <cstdint>
+
+/** @file AssetRegistry.h
+    @brief   Every asset the game uses, generated by Tools/AssetRegistry.
+    @details Do not edit, the build regenerates this from Resources and
+             the enumerators mentioned in Source. An Asset is also the
+             AssetId its name interns to, InvadersGame interns them in
+             order at start up.
+*/
+
+/** @enum AssetFormat
+*   @brief what an asset's bytes are
+*/
+enum class AssetFormat : uint8_t
+{
+	DATA = 0, /**< anything else, or generated by the build */
+	PNG =  1,
+	JPEG = 2,
+	WAV =  3,
+	TTF =  4
+};
+
+/** @struct AssetInfo
+*   @brief what the generator read from an asset's file
+*/
+struct AssetInfo
+{
+	const char* name;      /**< path relative to Resources */
+	AssetFormat format;
+	uint16_t    width;     /**< textures only, pixels */
+	uint16_t    height;    /**< textures only, pixels */
+	uint32_t    duration;  /**< sounds only, milliseconds */
+};
+
+enum Asset : int32_t
+{
+	SOUND_ALARM = 0,
+	SOUND_EXPLOSION1,
+	SOUND_EXPLOSION2,
+	SOUND_LASER1,
+	SOUND_LASER2,
+	DATA_CONFIG_WAVES,
+	FONT_COMIC,
+	DATA_RESOURCES,
+	TEXTURE_ALIEN1,
+	TEXTURE_ALIEN2,
+	TEXTURE_BARRIER_PIXEL,
+	TEXTURE_BULLET,
+	TEXTURE_EXPLOSION,
+	TEXTURE_INVADER,
+	TEXTURE_PLAYER,
+	TEXTURE_SPACESHIP,
+	TEXTURE_COMPUTER_KEY_A,
+	TEXTURE_COMPUTER_KEY_D,
+	TEXTURE_COMPUTER_KEY_ESC,
+	TEXTURE_COMPUTER_KEY_P,
+	TEXTURE_COMPUTER_KEY_SPACE_BAR,
+	TEXTURE_COMPUTER_KEY_NUM_ROW_1,
+	TEXTURE_COMPUTER_KEY_NUM_ROW_2,
+	TEXTURE_COMPUTER_KEY_NUM_ROW_3,
+	DATA_WAVES,
+	ASSET_COUNT
+};
+
+constexpr AssetInfo ASSET_INFO[ASSET_COUNT] =
+{
+	{ "Audio/Alarm.wav", AssetFormat::WAV, 0, 0, 400 },
+	{ "Audio/Explosion1.wav", AssetFormat::WAV, 0, 0, 635 },
+	{ "Audio/Explosion2.wav", AssetFormat::WAV, 0, 0, 237 },
+	{ "Audio/Laser1.wav", AssetFormat::WAV, 0, 0, 322 },
+	{ "Audio/Laser2.wav", AssetFormat::WAV, 0, 0, 346 },
+	{ "Config/Waves.txt", AssetFormat::DATA, 0, 0, 0 },
+	{ "Fonts/Comic.ttf", AssetFormat::TTF, 0, 0, 0 },
+	{ "Resources.pak", AssetFormat::DATA, 0, 0, 0 },
+	{ "Textures/Alien1.png", AssetFormat::PNG, 550, 300, 0 },
+	{ "Textures/Alien2.png", AssetFormat::PNG, 266, 199, 0 },
+	{ "Textures/BarrierPixel.png", AssetFormat::PNG, 1, 1, 0 },
+	{ "Textures/Bullet.png", AssetFormat::PNG, 1, 4, 0 },
+	{ "Textures/Explosion.png", AssetFormat::PNG, 317, 292, 0 },
+	{ "Textures/Invader.jpg", AssetFormat::JPEG, 548, 548, 0 },
+	{ "Textures/Player.png", AssetFormat::PNG, 1024, 630, 0 },
+	{ "Textures/Spaceship.png", AssetFormat::PNG, 980, 429, 0 },
+	{ "Textures/computer_key_A.png", AssetFormat::PNG, 100, 100, 0 },
+	{ "Textures/computer_key_D.png", AssetFormat::PNG, 100, 100, 0 },
+	{ "Textures/computer_key_Esc.png", AssetFormat::PNG, 100, 100, 0 },
+	{ "Textures/computer_key_P.png", AssetFormat::PNG, 100, 100, 0 },
+	{ "Textures/computer_key_Space_bar.png", AssetFormat::PNG, 190, 100, 0 },
+	{ "Textures/computer_key_num_row_1.png", AssetFormat::PNG, 100, 100, 0 },
+	{ "Textures/computer_key_num_row_2.png", AssetFormat::PNG, 100, 100, 0 },
+	{ "Textures/computer_key_num_row_3.png", AssetFormat::PNG, 100, 100, 0 },
+	{ "Waves.bin", AssetFormat::DATA, 0, 0, 0 }
+};
+
+//not referenced by the game, stripped
+//  Fonts/DroidSansMono.ttf
+//  Fonts/Monkey.ttf
+//  Textures/Thumbs.db
@@ -1,75 +1,261 @@
 #include "Barrier.h"
-#include "Game.h"
+#include "Bits.h"
 
-Barrier::Barrier()
+#include <Engine/Renderer.h>
+
+#include <algorithm>
+#include <cstring>
+
+static_assert(BARRIER_WIDTH == 64, "a barrier row is one 64 bit mask");
+static_assert(BARRIER_HEIGHT <= 64, "dirty rows are tracked in one mask");
+
+namespace
 {
-	health = 3;
-}
+	//gap cut into the bottom of the barrier, columns and first row
+	constexpr int ARCH_LEFT =  17;
+	constexpr int ARCH_RIGHT = 46;
+	constexpr int ARCH_TOP =   33;
 
+	//dirty bit for every row
+	constexpr uint64_t ALL_ROWS = (BARRIER_HEIGHT == 64) ? ~0ull :
+		((1ull << BARRIER_HEIGHT) - 1);
 
+	//half width of the crater on each row from top to bottom
+	constexpr int BLAST_SPAN[BARRIER_BLAST * 2 + 1] =
+		{ 1, 3, 3, 4, 4, 4, 3, 3, 1 };
+
+	//bits first to last inclusive, clipped to the row
+	uint64_t spanMask(int first, int last)
+	{
+		first = std::max(first, 0);
+		last = std::min(last, BARRIER_WIDTH - 1);
+
+		if (first > last)
+		{
+			return 0;
+		}
+
+		uint64_t below_last = (last == 63) ? ~0ull : ((1ull << (last + 1)) - 1);
+		return below_last & ~((1ull << first) - 1);
+	}
+}
 
-void Barrier::loadBarrier(std::shared_ptr<ASGE::Renderer> renderer)
+Barrier::Barrier()
 {
-	//create and set position of sprite
-	barrier = renderer->createSprite();
-	barrier->position[0] = -10;
-	barrier->position[1] = -10;
-	barrier->scale = 1;
-	barrier->loadTexture("..\\..\\Resources\\Textures\\Barrier.png");
+	resetBarrier();
 }
 
 
 
-const int Barrier::getXPosition()
+void Barrier::render(std::shared_ptr<ASGE::Renderer> renderer,
+	ASGE::Sprite& pixel, int x, int y)
 {
-	if (barrier)
+	//only rows hit since the last frame have their runs rebuilt
+	if (dirty != 0)
+	{
+		buildRuns();
+	}
+
+	//rows with identical masks are drawn as one block, an untouched
+	//barrier is three draws
+	int row = 0;
+
+	while (row < BARRIER_HEIGHT)
 	{
-		return barrier->position[0];
+		int height = 1;
+
+		while ((row + height < BARRIER_HEIGHT) &&
+			(rows[row + height] == rows[row]))
+		{
+			height++;
+		}
+
+		for (int i = 0; i < run_count[row]; i++)
+		{
+			pixel.position[0] = x + run_start[row][i];
+			pixel.position[1] = y + row;
+			pixel.size[0] = run_length[row][i];
+			pixel.size[1] = height;
+			pixel.render(renderer);
+		}
+
+		row += height;
 	}
 }
 
 
 
-const int Barrier::getYPosition()
+void Barrier::resetBarrier()
 {
-	if (barrier)
+	//solid block with an arch cut out of the bottom
+	for (int i = 0; i < BARRIER_HEIGHT; i++)
 	{
-		return barrier->position[1];
+		rows[i] = ~0ull;
+
+		if (i >= ARCH_TOP)
+		{
+			rows[i] &= ~spanMask(ARCH_LEFT, ARCH_RIGHT);
+		}
 	}
+
+	dirty = ALL_ROWS;
+	updateState();
 }
 
 
 
-void Barrier::changeBarrier()
+const int Barrier::hitTest(int left, int top, int right, int bottom,
+	bool upward)
 {
-	//set barrier sprite depending on current health
-	if (health == 3)
+	//columns outside the barrier drop off the mask
+	uint64_t columns = spanMask(left, right);
+	int first = std::max(top, 0);
+	int last = std::min(bottom, BARRIER_HEIGHT - 1);
+
+	if ((columns == 0) || (first > last))
 	{
-		barrier->loadTexture("..\\..\\Resources\\Textures\\Barrier.png");
+		return -1;
 	}
 
-	else if (health == 2)
+	//search in the direction of travel so the nearest face is hit
+	if (upward)
 	{
-		barrier->loadTexture("..\\..\\Resources\\Textures\\Barrier2.png");
+		for (int i = last; i >= first; i--)
+		{
+			if (rows[i] & columns)
+			{
+				return i;
+			}
+		}
 	}
 
-	else if (health == 1)
+	else
 	{
-		barrier->loadTexture("..\\..\\Resources\\Textures\\Barrier3.png");
+		for (int i = first; i <= last; i++)
+		{
+			if (rows[i] & columns)
+			{
+				return i;
+			}
+		}
 	}
 
-	//if health == 0 then barrier is dead
-	else
+	return -1;
+}
+
+
+
+const int Barrier::erode(int column, int row)
+{
+	int before = pixels;
+
+	for (int i = 0; i < BARRIER_BLAST * 2 + 1; i++)
 	{
-		is_alive = false;
+		int target = row - BARRIER_BLAST + i;
+
+		if ((target < 0) || (target >= BARRIER_HEIGHT))
+		{
+			continue;
+		}
+
+		uint64_t blast = spanMask(column - BLAST_SPAN[i],
+			column + BLAST_SPAN[i]);
+
+		if (rows[target] & blast)
+		{
+			rows[target] &= ~blast;
+			dirty |= 1ull << target;
+		}
 	}
+
+	updateState();
+
+	return before - pixels;
 }
 
 
 
-void Barrier::resetBarrier()
+const int Barrier::getPixels()
 {
-	//reset barrier back to full health for new game
-	is_alive = true;
-	health = 3;
+	return pixels;
+}
+
+
+
+const int Barrier::getHealth()
+{
+	//percentage left, any pixel at all counts as some
+	constexpr int FULL = BARRIER_WIDTH * ARCH_TOP +
+		(BARRIER_WIDTH - (ARCH_RIGHT - ARCH_LEFT + 1)) *
+		(BARRIER_HEIGHT - ARCH_TOP);
+
+	return (pixels * 100 + FULL - 1) / FULL;
+}
+
+
+
+const bool Barrier::getAlive()
+{
+	return pixels > 0;
+}
+
+
+
+const uint64_t* Barrier::getRows()
+{
+	return rows;
+}
+
+
+
+void Barrier::setRows(const uint64_t* masks)
+{
+	std::memcpy(rows, masks, sizeof(rows));
+
+	dirty = ALL_ROWS;
+	updateState();
+}
+
+
+
+void Barrier::updateState()
+{
+	pixels = 0;
+
+	for (int i = 0; i < BARRIER_HEIGHT; i++)
+	{
+		pixels += bitCount(rows[i]);
+	}
+}
+
+
+
+void Barrier::buildRuns()
+{
+	while (dirty != 0)
+	{
+		int row = lowestBit(dirty);
+		dirty &= dirty - 1;
+
+		uint64_t mask = rows[row];
+		int count = 0;
+
+		while (mask != 0)
+		{
+			//start of the run, then the first gap above it
+			int start = lowestBit(mask);
+			uint64_t gaps = ~(mask >> start);
+			int length = gaps ? lowestBit(gaps) : BARRIER_WIDTH;
+
+			run_start[row][count] = (uint8_t)start;
+			run_length[row][count] = (uint8_t)length;
+			count++;
+
+			//bits below start are already clear
+			mask = (start + length >= BARRIER_WIDTH) ? 0 :
+				mask & (~0ull << (start + length));
+		}
+
+		run_count[row] = (uint8_t)count;
+	}
 }
@@ -2,30 +2,63 @@
 #include <Engine/OGLGame.h>
 #include <Engine/Sprite.h>
 
+#include <cstdint>
 #include <string>
 
-#include "GameActor.h"
+#include "Components.h"
 
 namespace ASGE {
 	class Renderer;
 	class Sprite;
 }
 
-class Barrier :
-	public GameActor
+constexpr int BARRIER_WIDTH =  64; //pixels across, one bit each per row
+constexpr int BARRIER_HEIGHT = 48; //pixel rows
+constexpr int BARRIER_BLAST =  4;  //radius of the crater a bullet leaves
+
+/**
+*   Barrier component. The pixels left of one barrier, as a mask per row.
+*   Coords are relative to the barrier's top left, its Position says
+*   where that is on screen.
+*/
+class Barrier
 {
 public:
+	static constexpr ComponentId ID = SHIELD;
+
 	Barrier();
 	~Barrier() = default;
-	
-	//load barrier sprite details
-	void loadBarrier(std::shared_ptr<ASGE::Renderer> renderer); 
-	void changeBarrier(); //change sprite
-	void resetBarrier(); //reset to full health
 
-	const int getXPosition(); //get x coord
-	const int getYPosition(); //get y coord
+	void resetBarrier(); //restore every pixel
 
-	std::unique_ptr<ASGE::Sprite> barrier = nullptr; //barrier sprite
-};
+	//draw solid pixels with top left at x and y, pixel is one solid
+	//pixel stretched over each run
+	void render(std::shared_ptr<ASGE::Renderer> renderer,
+		ASGE::Sprite& pixel, int x, int y);
+
+	//first row a box sweeping through the barrier touches, searched
+	//upwards for shots from below, -1 if it passes through a gap
+	const int hitTest(int left, int top, int right, int bottom, bool upward);
+
+	//blow a crater centred on column and row, returns pixels lost
+	const int erode(int column, int row);
 
+	const int getPixels(); //solid pixels left
+	const int getHealth(); //percentage of pixels left, rounded up
+	const bool getAlive(); //any pixel left
+	const uint64_t* getRows(); //row masks, bit n is n pixels from the left
+	void setRows(const uint64_t* masks); //replace every row
+
+private:
+	void updateState(); //recount pixels
+	void buildRuns(); //refresh runs of dirty rows
+
+	uint64_t rows[BARRIER_HEIGHT]; //solid pixels, bit per column
+	uint64_t dirty = 0; //bit per row changed since runs were built
+	int pixels = 0; //solid pixels left
+
+	//solid spans of each row as start and length, built when dirty
+	uint8_t run_start[BARRIER_HEIGHT][BARRIER_WIDTH / 2];
+	uint8_t run_length[BARRIER_HEIGHT][BARRIER_WIDTH / 2];
+	uint8_t run_count[BARRIER_HEIGHT];
+};
@@ -0,0 +1,311 @@
+#include "BatchSim.h"
+#include "Constants.h"
+#include "GameWorld.h"
+#include "JobSystem.h"
+
+#include <cstring>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace
+{
+	//player, player bullet, mothership, formation
+	constexpr int PLAYER_FEATURES =     3;
+	constexpr int SHOT_FEATURES =       3;
+	constexpr int MOTHERSHIP_FEATURES = 2;
+	constexpr int FORMATION_FEATURES =  3;
+
+	//alive, x, y per enemy bullet, share of pixels left per barrier,
+	//alive per alien slot, slots past the end of the formation are
+	//always zero
+	constexpr int BULLET_FEATURES =     5 * 3;
+	constexpr int BARRIER_FEATURES =    3;
+	constexpr int ALIEN_FEATURES =      MAX_ALIENS;
+
+	constexpr int OBSERVATION_SIZE = PLAYER_FEATURES + SHOT_FEATURES +
+		MOTHERSHIP_FEATURES + FORMATION_FEATURES + BULLET_FEATURES +
+		BARRIER_FEATURES + ALIEN_FEATURES;
+}
+
+struct InvadersBatch
+{
+	JobSystem jobs;                                 //fans instances out
+	std::vector<std::unique_ptr<GameWorld>> worlds; //one per instance
+};
+
+
+
+/**
+*   @brief   Writes one instance's observation.
+*   @details Positions are scaled to roughly [0, 1] by the window size.
+*            Values are strided by the batch size so each feature is a
+*            contiguous run across instances.
+*/
+static void observe(GameWorld& world, float* out, int stride)
+{
+	const float width = WINDOW_WIDTH;
+	const float height = WINDOW_HEIGHT;
+	int f = 0;
+
+	auto write = [&](float value)
+	{
+		out[f * stride] = value;
+		f++;
+	};
+
+	EntityStore& entities = world.entities;
+
+	write(entities.get<Position>(GameWorld::PLAYER)->x / width);
+	write(entities.get<Life>(GameWorld::PLAYER)->health / 3.0f);
+	write(world.isRespawning() ? 1.0f : 0.0f);
+
+	const Position& bullet = *entities.get<Position>(GameWorld::PLAYER_SHOT);
+	write(entities.get<Life>(GameWorld::PLAYER_SHOT)->alive ? 1.0f : 0.0f);
+	write(bullet.x / width);
+	write(bullet.y / height);
+
+	write(entities.get<Life>(GameWorld::MOTHERSHIP)->alive ? 1.0f : 0.0f);
+	write(entities.get<Position>(GameWorld::MOTHERSHIP)->x / width);
+
+	//every alien moves with the first, so it locates the whole formation
+	const Position* alien = entities.get<Position>(GameWorld::ALIENS);
+	write(alien[0].x / width);
+	write(alien[0].y / height);
+	write(entities.get<March>(GameWorld::ALIENS)->direction > 0 ? 1.0f : -1.0f);
+
+	const Position* shot = entities.get<Position>(GameWorld::ALIEN_SHOTS);
+	const Life* shot_life = entities.get<Life>(GameWorld::ALIEN_SHOTS);
+
+	for (int i = 0; i < entities.getCount(GameWorld::ALIEN_SHOTS); i++)
+	{
+		write(shot_life[i].alive ? 1.0f : 0.0f);
+		write(shot[i].x / width);
+		write(shot[i].y / height);
+	}
+
+	Barrier* barrier = entities.get<Barrier>(GameWorld::BARRIERS);
+
+	for (int i = 0; i < entities.getCount(GameWorld::BARRIERS); i++)
+	{
+		write(barrier[i].getHealth() / 100.0f);
+	}
+
+	int aliens = entities.getCount(GameWorld::ALIENS);
+	const Life* alien_life = entities.get<Life>(GameWorld::ALIENS);
+
+	for (int i = 0; i < aliens; i++)
+	{
+		write(alien_life[i].alive ? 1.0f : 0.0f);
+	}
+
+	for (int i = aliens; i < MAX_ALIENS; i++)
+	{
+		write(0.0f);
+	}
+}
+
+
+
+INVADERS_API InvadersBatch* invaders_batch_create(int count, uint32_t seed)
+{
+	if (count <= 0)
+	{
+		return nullptr;
+	}
+
+	InvadersBatch* batch = new (std::nothrow) InvadersBatch();
+
+	if (!batch)
+	{
+		return nullptr;
+	}
+
+	//instances step on the batch's threads, so each world runs serially
+	for (int i = 0; i < count; i++)
+	{
+		uint32_t instance_seed = seed + (uint32_t)i * 0x9E3779B9u;
+		batch->worlds.push_back(
+			std::make_unique<GameWorld>(instance_seed, nullptr));
+	}
+
+	return batch;
+}
+
+
+
+INVADERS_API bool invaders_batch_load_waves(InvadersBatch* batch,
+	const char* path)
+{
+	WaveTable waves;
+
+	if (!batch || !path || !loadWaves(path, waves))
+	{
+		return false;
+	}
+
+	for (auto& world : batch->worlds)
+	{
+		world->setWaves(waves);
+		world->reset();
+	}
+
+	return true;
+}
+
+
+
+INVADERS_API void invaders_batch_destroy(InvadersBatch* batch)
+{
+	delete batch;
+}
+
+
+
+INVADERS_API int invaders_batch_count(InvadersBatch* batch)
+{
+	return batch ? (int)batch->worlds.size() : 0;
+}
+
+
+
+INVADERS_API int invaders_batch_observation_size()
+{
+	return OBSERVATION_SIZE;
+}
+
+
+
+INVADERS_API void invaders_batch_reset(InvadersBatch* batch,
+	float* observations)
+{
+	if (!batch)
+	{
+		return;
+	}
+
+	int count = (int)batch->worlds.size();
+
+	batch->jobs.parallelFor(0, count, BATCH_GRAIN,
+		[batch, observations, count](int first, int last)
+	{
+		for (int i = first; i < last; i++)
+		{
+			GameWorld& world = *batch->worlds[i];
+			world.reset();
+
+			if (observations)
+			{
+				observe(world, observations + i, count);
+			}
+		}
+	});
+}
+
+
+
+INVADERS_API void invaders_batch_step(InvadersBatch* batch,
+	const uint8_t* actions, float* observations, float* rewards,
+	uint8_t* dones)
+{
+	if (!batch)
+	{
+		return;
+	}
+
+	int count = (int)batch->worlds.size();
+
+	batch->jobs.parallelFor(0, count, BATCH_GRAIN,
+		[=](int first, int last)
+	{
+		for (int i = first; i < last; i++)
+		{
+			GameWorld& world = *batch->worlds[i];
+
+			WorldInput input;
+			uint8_t action = actions ? actions[i] : 0;
+
+			if (action & INVADERS_LEFT)
+			{
+				input.move = -1;
+			}
+
+			else if (action & INVADERS_RIGHT)
+			{
+				input.move = 1;
+			}
+
+			input.shoot = (action & INVADERS_SHOOT) != 0;
+
+			int score = world.entities.get<Pilot>(GameWorld::PLAYER)->score;
+
+			world.step(SIM_TIME_STEP, input);
+
+			bool done = world.isGameOver();
+
+			if (rewards)
+			{
+				rewards[i] = (float)(world.entities.get<Pilot>(GameWorld::PLAYER)->score - score);
+			}
+
+			if (dones)
+			{
+				dones[i] = done ? 1 : 0;
+			}
+
+			if (done)
+			{
+				world.reset();
+			}
+
+			if (observations)
+			{
+				observe(world, observations + i, count);
+			}
+		}
+	});
+}
+
+
+
+INVADERS_API int invaders_batch_state_size()
+{
+	return (int)sizeof(GameSnapshot);
+}
+
+
+
+INVADERS_API bool invaders_batch_save(InvadersBatch* batch, int index,
+	void* state)
+{
+	if (!batch || !state || (index < 0) ||
+		(index >= (int)batch->worlds.size()))
+	{
+		return false;
+	}
+
+	GameSnapshot snapshot;
+	batch->worlds[index]->save(snapshot);
+
+	//caller's buffer may not be aligned for the struct
+	std::memcpy(state, &snapshot, sizeof(snapshot));
+
+	return true;
+}
+
+
+
+INVADERS_API bool invaders_batch_restore(InvadersBatch* batch, int index,
+	const void* state)
+{
+	if (!batch || !state || (index < 0) ||
+		(index >= (int)batch->worlds.size()))
+	{
+		return false;
+	}
+
+	GameSnapshot snapshot;
+	std::memcpy(&snapshot, state, sizeof(snapshot));
+
+	return batch->worlds[index]->restore(snapshot);
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <cstdint>
+
+/** @file BatchSim.h
+    @brief   C interface for stepping many headless games at once.
+    @details A batch owns K independent GameWorlds which are all advanced
+             by one call, split across cores with the job system. Nothing
+             is rendered and no sound is played, so the library can be
+             loaded from Python with ctypes and driven at full speed.
+             Per instance data is passed in caller owned arrays laid out
+             structure of arrays: actions, rewards and dones are K long,
+             observations are feature major, so feature f of instance i
+             lives at observations[f * K + i].
+*/
+
+#if defined(_WIN32)
+#define INVADERS_API extern "C" __declspec(dllexport)
+#else
+#define INVADERS_API extern "C" __attribute__((visibility("default")))
+#endif
+
+/** @enum InvadersAction
+*   @brief action bits, one byte per instance
+*/
+enum InvadersAction
+{
+	INVADERS_LEFT =  1, /**< move left */
+	INVADERS_RIGHT = 2, /**< move right, ignored if left is also set */
+	INVADERS_SHOOT = 4  /**< fire */
+};
+
+struct InvadersBatch;
+
+//create count games, each seeded from seed, null on failure
+INVADERS_API InvadersBatch* invaders_batch_create(int count, uint32_t seed);
+
+//use the formation and difficulty compiled into a Waves.bin file and
+//reset every instance, false if the file can't be loaded
+INVADERS_API bool invaders_batch_load_waves(InvadersBatch* batch,
+	const char* path);
+
+//destroy a batch created with invaders_batch_create
+INVADERS_API void invaders_batch_destroy(InvadersBatch* batch);
+
+//number of instances in the batch
+INVADERS_API int invaders_batch_count(InvadersBatch* batch);
+
+//floats per instance written to the observation array
+INVADERS_API int invaders_batch_observation_size();
+
+//start every instance on a new game and write observations, a null
+//batch does nothing
+INVADERS_API void invaders_batch_reset(InvadersBatch* batch,
+	float* observations);
+
+//advance every instance by one fixed tick. rewards are score gained this
+//tick, dones are set when a game ends and that instance is reset, the
+//observations written are then those of the new game. A null batch does
+//nothing
+INVADERS_API void invaders_batch_step(InvadersBatch* batch,
+	const uint8_t* actions, float* observations, float* rewards,
+	uint8_t* dones);
+
+//bytes needed to hold one instance's saved state
+INVADERS_API int invaders_batch_state_size();
+
+//copy instance index's full state into state, false if out of range
+INVADERS_API bool invaders_batch_save(InvadersBatch* batch, int index,
+	void* state);
+
+//replace instance index's state with one saved by invaders_batch_save
+INVADERS_API bool invaders_batch_restore(InvadersBatch* batch, int index,
+	const void* state);
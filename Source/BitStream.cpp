@@ -0,0 +1,155 @@
+#include "BitStream.h"
+
+namespace
+{
+	//0, -1, 1, -2, 2 ... to 0, 1, 2, 3, 4 ...
+	uint32_t fold(int32_t value)
+	{
+		return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+	}
+
+	int32_t unfold(uint32_t value)
+	{
+		return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+	}
+
+	int bitLength(uint32_t value)
+	{
+		int length = 0;
+
+		while (value)
+		{
+			value >>= 1;
+			length++;
+		}
+
+		return length;
+	}
+}
+
+
+
+BitWriter::BitWriter(std::vector<uint8_t>& buffer)
+	: buffer(buffer)
+{
+}
+
+
+
+void BitWriter::write(uint32_t value, int bits)
+{
+	if (bits < 32)
+	{
+		value &= (1u << bits) - 1;
+	}
+
+	pending |= (uint64_t)value << pending_bits;
+	pending_bits += bits;
+	written += bits;
+
+	while (pending_bits >= 8)
+	{
+		buffer.push_back((uint8_t)pending);
+		pending >>= 8;
+		pending_bits -= 8;
+	}
+}
+
+
+
+void BitWriter::writeBool(bool value)
+{
+	write(value ? 1 : 0, 1);
+}
+
+
+
+void BitWriter::writeSigned(int32_t value)
+{
+	uint32_t folded = fold(value);
+	int length = bitLength(folded);
+
+	//a length of 32 doesn't fit in 5 bits, 31 says 32 follow
+	write(length == 32 ? 31 : length, 5);
+	write(folded, length == 31 ? 32 : length);
+}
+
+
+
+void BitWriter::finish()
+{
+	if (pending_bits > 0)
+	{
+		buffer.push_back((uint8_t)pending);
+		written += 8 - pending_bits;
+		pending = 0;
+		pending_bits = 0;
+	}
+}
+
+
+
+const int BitWriter::getBits()
+{
+	return written;
+}
+
+
+
+BitReader::BitReader(const uint8_t* data, int size)
+	: data(data), size(size)
+{
+}
+
+
+
+const uint32_t BitReader::read(int bits)
+{
+	while (pending_bits < bits)
+	{
+		if (position < size)
+		{
+			pending |= (uint64_t)data[position++] << pending_bits;
+		}
+		else
+		{
+			overrun = true;
+		}
+
+		pending_bits += 8;
+	}
+
+	uint32_t value = (uint32_t)(pending & ((1ull << bits) - 1));
+	pending >>= bits;
+	pending_bits -= bits;
+
+	return value;
+}
+
+
+
+const bool BitReader::readBool()
+{
+	return read(1) != 0;
+}
+
+
+
+const int32_t BitReader::readSigned()
+{
+	int length = (int)read(5);
+
+	if (length == 31)
+	{
+		length = 32;
+	}
+
+	return unfold(read(length));
+}
+
+
+
+const bool BitReader::isOverrun()
+{
+	return overrun;
+}
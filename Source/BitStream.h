@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+/** @file BitStream.h
+    @brief   Bit packed writing and reading for network messages.
+    @details Values are written with just the bits they need, least
+             significant bit first, through a 64 bit accumulator that is
+             emptied a byte at a time. Signed values are zigzag folded so
+             small changes either way stay short, then written as their
+             length in 5 bits followed by that many bits, so a change of
+             0 costs 5 bits and a step of one 6 or 7. Reading past the end
+             returns zeros and sets a flag rather than failing each call.
+*/
+
+class BitWriter
+{
+public:
+	explicit BitWriter(std::vector<uint8_t>& buffer);
+	~BitWriter() = default;
+
+	void write(uint32_t value, int bits); //low bits of value, bits <= 32
+	void writeBool(bool value);
+	void writeSigned(int32_t value); //length then zigzag folded value
+
+	void finish(); //pad the last byte out and append it
+	const int getBits(); //bits written so far
+
+private:
+	std::vector<uint8_t>& buffer; //appended to
+	uint64_t pending = 0; //bits not yet appended
+	int pending_bits = 0; //bits in pending
+	int written = 0;      //bits written
+};
+
+class BitReader
+{
+public:
+	BitReader(const uint8_t* data, int size);
+	~BitReader() = default;
+
+	const uint32_t read(int bits); //bits <= 32
+	const bool readBool();
+	const int32_t readSigned();
+
+	//read past the end of the data, everything after was zero
+	const bool isOverrun();
+
+private:
+	const uint8_t* data; //message being read
+	int size =         0; //bytes in data
+	int position =     0; //next byte to load
+	uint64_t pending = 0; //bits loaded but not read
+	int pending_bits = 0; //bits in pending
+	bool overrun = false; //asked for more bits than there were
+};
@@ -0,0 +1,36 @@
+#pragma once
+#include <bitset>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/** @file Bits.h
+    @brief   Bit scans shared by the packed masks.
+*/
+
+//index of the lowest set bit, mask must not be zero
+inline int lowestBit(uint64_t mask)
+{
+#if defined(_MSC_VER)
+	//32 bit scans so x86 builds work too
+	unsigned long index;
+
+	if (_BitScanForward(&index, (unsigned long)mask))
+	{
+		return (int)index;
+	}
+
+	_BitScanForward(&index, (unsigned long)(mask >> 32));
+	return (int)index + 32;
+#else
+	return __builtin_ctzll(mask);
+#endif
+}
+
+//set bits in mask
+inline int bitCount(uint64_t mask)
+{
+	return (int)std::bitset<64>(mask).count();
+}
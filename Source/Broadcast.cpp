@@ -0,0 +1,324 @@
+#include "Broadcast.h"
+#include "Connection.h"
+#include "Replication.h"
+#include "StateDelta.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+	const GameSnapshot EMPTY = {}; //base every keyframe is written against
+}
+
+
+
+Broadcast::Broadcast()
+	: events(POLL_BATCH), stream(BROADCAST_STREAM)
+{
+}
+
+
+
+const bool Broadcast::start(uint16_t port)
+{
+	stop();
+
+	if (!listener.listen(port, BROADCAST_BACKLOG))
+	{
+		return false;
+	}
+
+	//a listener is readable when someone is waiting to be accepted
+	poller.add(listener.getHandle(), -1);
+
+	return true;
+}
+
+
+
+void Broadcast::stop()
+{
+	for (int id = 0; id < (int)viewers.size(); id++)
+	{
+		if (viewers[id].next != 0)
+		{
+			drop(id);
+		}
+	}
+
+	if (listener.isOpen())
+	{
+		poller.remove(listener.getHandle());
+		listener.close();
+	}
+}
+
+
+
+void Broadcast::update(GameWorld& world)
+{
+	publish(world);
+
+	//new viewers, viewers with room again and hang ups, spectators send
+	//nothing so anything read is only drained
+	int count;
+
+	do
+	{
+		count = poller.wait(events.data(), (int)events.size(), 0);
+
+		for (int i = 0; i < count; i++)
+		{
+			const PollEvent& event = events[i];
+
+			if (event.id < 0)
+			{
+				acceptViewers();
+				continue;
+			}
+
+			Viewer& viewer = viewers[event.id];
+
+			if (viewer.next == 0)
+			{
+				continue;
+			}
+
+			if (event.readable || event.closed)
+			{
+				uint8_t drain[256];
+
+				if (event.closed || (viewer.socket.receive(drain,
+					sizeof(drain)) < 0))
+				{
+					drop(event.id);
+					continue;
+				}
+			}
+
+			if (event.writable)
+			{
+				viewer.blocked = false;
+				poller.setWritable(viewer.socket.getHandle(), event.id, false);
+			}
+		}
+	} while (count == (int)events.size());
+
+	//this tick's turn, one call each however many ticks it is behind
+	for (int id = sequence % BROADCAST_BATCH; id < (int)viewers.size();
+		id += BROADCAST_BATCH)
+	{
+		if (viewers[id].next != 0)
+		{
+			send(id);
+		}
+	}
+}
+
+
+
+const int Broadcast::getViewers()
+{
+	return viewer_count;
+}
+
+
+
+const uint16_t Broadcast::getPort()
+{
+	return listener.getPort();
+}
+
+
+
+const uint32_t Broadcast::getSequence()
+{
+	return sequence;
+}
+
+
+
+const uint64_t Broadcast::getBytesSent()
+{
+	return bytes_sent;
+}
+
+
+
+const uint64_t Broadcast::getSkips()
+{
+	return skips;
+}
+
+
+
+const uint64_t Broadcast::getDropped()
+{
+	return dropped;
+}
+
+
+
+void Broadcast::acceptViewers()
+{
+	while (true)
+	{
+		Socket socket = listener.accept();
+
+		if (!socket.isOpen())
+		{
+			break;
+		}
+
+		socket.setSendBuffer(BROADCAST_SEND_BUFFER);
+
+		int id = (int)viewers.size();
+
+		if (!free_ids.empty())
+		{
+			id = free_ids.back();
+			free_ids.pop_back();
+		}
+		else
+		{
+			viewers.emplace_back();
+		}
+
+		if (!poller.add(socket.getHandle(), id))
+		{
+			free_ids.push_back(id);
+			continue;
+		}
+
+		//from the newest keyframe, there is always one once update has run
+		Viewer& viewer = viewers[id];
+		viewer.socket = std::move(socket);
+		viewer.next = keyframe;
+		viewer.position = starts[keyframe % BROADCAST_TICKS];
+		viewer.blocked = false;
+		viewer_count++;
+	}
+}
+
+
+
+void Broadcast::publish(GameWorld& world)
+{
+	sequence++;
+
+	world.save(current);
+	keepReplicated(current);
+
+	//a keyframe is also due once half the ring has gone by since the
+	//last, so a skip always has one to land on
+	bool key = (keyframe == 0) ||
+		(sequence - keyframe >= BROADCAST_KEYFRAME) ||
+		(head - starts[keyframe % BROADCAST_TICKS] >= BROADCAST_STREAM / 2);
+
+	message.assign(MESSAGE_HEADER, 0);
+	writeState(sequence, key ? 0 : 1, key ? EMPTY : previous, current,
+		message);
+
+	int size = (int)message.size() - MESSAGE_HEADER;
+	message[0] = (uint8_t)size;
+	message[1] = (uint8_t)(size >> 8);
+	message[2] = (uint8_t)MessageType::STATE;
+
+	//framed once here, every viewer is sent these bytes as they are
+	int offset = (int)(head % BROADCAST_STREAM);
+	int first = std::min((int)message.size(), BROADCAST_STREAM - offset);
+
+	std::memcpy(stream.data() + offset, message.data(), first);
+	std::memcpy(stream.data(), message.data() + first,
+		message.size() - first);
+
+	starts[sequence % BROADCAST_TICKS] = head;
+	head += message.size();
+
+	if (key)
+	{
+		keyframe = sequence;
+	}
+
+	std::memcpy(&previous, &current, sizeof(current));
+}
+
+
+
+void Broadcast::send(int id)
+{
+	Viewer& viewer = viewers[id];
+
+	if (viewer.position == head)
+	{
+		return;
+	}
+
+	//too far behind to catch up tick by tick, only between messages and
+	//only once it reads again
+	if (!viewer.blocked && (sequence - viewer.next > BROADCAST_LAG) &&
+		(viewer.position == starts[viewer.next % BROADCAST_TICKS]))
+	{
+		viewer.next = keyframe;
+		viewer.position = starts[keyframe % BROADCAST_TICKS];
+		skips++;
+	}
+
+	//lapped part way through a message or without reading at all
+	if ((sequence - viewer.next >= BROADCAST_TICKS) ||
+		(head - viewer.position > BROADCAST_STREAM))
+	{
+		dropped++;
+		drop(id);
+		return;
+	}
+
+	while (!viewer.blocked && (viewer.position < head))
+	{
+		int offset = (int)(viewer.position % BROADCAST_STREAM);
+		int length = (int)std::min<uint64_t>(head - viewer.position,
+			BROADCAST_STREAM - offset);
+
+		int sent = viewer.socket.send(stream.data() + offset, length);
+
+		if (sent < 0)
+		{
+			drop(id);
+			return;
+		}
+
+		viewer.position += sent;
+		bytes_sent += sent;
+
+		//full, epoll says when there is room again
+		if (sent < length)
+		{
+			viewer.blocked = true;
+			poller.setWritable(viewer.socket.getHandle(), id, true);
+		}
+	}
+
+	//past the end of the newest tick is the start of the one to come
+	while ((viewer.next <= sequence) && (viewer.position >= ((viewer.next ==
+		sequence) ? head : starts[(viewer.next + 1) % BROADCAST_TICKS])))
+	{
+		viewer.next++;
+	}
+}
+
+
+
+void Broadcast::drop(int id)
+{
+	Viewer& viewer = viewers[id];
+
+	poller.remove(viewer.socket.getHandle());
+	viewer.socket.close();
+	viewer.next = 0;
+	viewer.position = 0;
+	viewer.blocked = false;
+
+	free_ids.push_back(id);
+	viewer_count--;
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "GameSnapshot.h"
+#include "GameWorld.h"
+#include "Poller.h"
+#include "Socket.h"
+
+/** @file Broadcast.h
+    @brief   One game's tick stream sent to any number of spectators.
+    @details Each tick is encoded once, as a delta against the tick
+             before or every BROADCAST_KEYFRAME ticks as a keyframe, in
+             the same messages the replicated mode sends so that a
+             ReplicationClient can watch. The messages go one after the
+             other into a single ring of bytes and every viewer is sent
+             straight out of it, keeping only its place, so a viewer
+             costs the same few bytes however far behind it is plus a
+             kernel send queue capped at BROADCAST_SEND_BUFFER.
+             Viewers are sent to in turn, a BROADCAST_BATCH'th of them a
+             tick and everything new in one call. A new viewer starts at
+             the newest keyframe and one more than BROADCAST_LAG ticks
+             behind skips ahead to it. A viewer whose socket is full waits
+             for epoll to say there is room, and is dropped if the ring
+             laps it first.
+*/
+
+constexpr int BROADCAST_STREAM =      256 * 1024; /**< bytes of stream held */
+constexpr int BROADCAST_TICKS =       256; /**< ticks of stream held */
+constexpr int BROADCAST_KEYFRAME =    120; /**< ticks between keyframes */
+constexpr int BROADCAST_LAG =         128; /**< ticks behind before skipping */
+constexpr int BROADCAST_BATCH =       4;   /**< ticks between sends to a viewer */
+constexpr int BROADCAST_SEND_BUFFER = 16 * 1024; /**< kernel queue per viewer */
+constexpr int BROADCAST_BACKLOG =     1024; /**< viewers waiting to be accepted */
+
+static_assert((BROADCAST_KEYFRAME <= BROADCAST_LAG) &&
+	(BROADCAST_LAG + BROADCAST_BATCH < BROADCAST_TICKS),
+	"a skip has to land nearer than the lag and inside the ring");
+
+class Broadcast
+{
+public:
+	Broadcast();
+	~Broadcast() = default;
+
+	const bool start(uint16_t port); //listen on loopback, 0 picks a port
+	void stop(); //disconnect every viewer
+
+	//take new viewers, encode world's state and send viewers their turn
+	void update(GameWorld& world);
+
+	const int getViewers(); //connected now
+	const uint16_t getPort();
+	const uint32_t getSequence(); //ticks broadcast
+	const uint64_t getBytesSent(); //to every viewer, ever
+	const uint64_t getSkips(); //times a viewer skipped to a keyframe
+	const uint64_t getDropped(); //viewers dropped for falling behind
+
+private:
+	struct Viewer
+	{
+		Socket socket;
+		uint64_t position = 0; //next byte of the stream to send
+		uint32_t next = 0; //tick that byte is in, 0 if the slot is free
+		bool blocked = false; //socket full, waiting for epoll
+	};
+
+	void acceptViewers();
+	void publish(GameWorld& world); //encode the next tick into the ring
+	void send(int id); //everything new, or as much as the socket takes
+	void drop(int id);
+
+	Socket listener;
+	Poller poller;
+	std::vector<Viewer> viewers; //by id, the poller's id
+	std::vector<int> free_ids;   //slots of dropped viewers
+	std::vector<PollEvent> events; //one wait's worth
+
+	std::vector<uint8_t> stream;  //framed messages, wrapping
+	std::vector<uint8_t> message; //the newest, before it is copied in
+	uint64_t starts[BROADCAST_TICKS] = {}; //stream position of each tick
+	uint64_t head = 0;     //stream bytes ever written
+	uint32_t sequence = 0; //newest tick in the ring
+	uint32_t keyframe = 0; //newest keyframe in the ring
+	GameSnapshot previous; //state of the last tick encoded
+	GameSnapshot current;  //state being encoded
+
+	int viewer_count =    0;
+	uint64_t bytes_sent = 0;
+	uint64_t skips =      0;
+	uint64_t dropped =    0;
+};
@@ -0,0 +1,93 @@
+#pragma once
+#include <cstdint>
+
+/** @file Components.h
+    @brief   Plain data an entity is made of.
+    @details Every actor in the world is a row in an archetype, one dense
+             column per component it has. Components are trivially
+             copyable structs, new rows are zeroed and filled in by whoever
+             creates them. The rules that act on them live in GameWorld's
+             systems, only Barrier keeps the bookkeeping of its pixel masks.
+             Tags have no data, they only keep otherwise identical
+             archetypes apart.
+*/
+
+/** @enum ComponentId
+*   @brief bit of each component in an archetype's mask
+*/
+enum ComponentId : uint32_t
+{
+	POSITION = 0, /**< Position */
+	LIFE =     1, /**< Life */
+	PILOT =    2, /**< Pilot */
+	MARCH =    3, /**< March */
+	SHOT =     4, /**< Shot */
+	SHIELD =   5, /**< Barrier, see Barrier.h */
+	HOSTILE =  6, /**< tag, on the aliens' side */
+	COMPONENT_TYPES
+};
+
+using ComponentMask = uint32_t;
+
+//mask with the bit of each component id given
+template<typename... Ids>
+constexpr ComponentMask componentMask(Ids... ids)
+{
+	return (0u | ... | (1u << ids));
+}
+
+/** @struct Position
+*   @brief screen coords, copied to a sprite on render
+*/
+struct Position
+{
+	static constexpr ComponentId ID = POSITION;
+
+	int32_t x; /**< screen x coord */
+	int32_t y; /**< screen y coord */
+};
+
+/** @struct Life
+*   @brief health and whether the entity is still in play
+*/
+struct Life
+{
+	static constexpr ComponentId ID = LIFE;
+
+	int32_t health; /**< remaining health */
+	bool alive;     /**< in play, dead entities keep their row */
+};
+
+/** @struct Pilot
+*   @brief what belongs to the player rather than the ship
+*/
+struct Pilot
+{
+	static constexpr ComponentId ID = PILOT;
+
+	int32_t score;      /**< player score */
+	int32_t multiplier; /**< score multiplier */
+	bool death;         /**< respawning after being shot */
+};
+
+/** @struct March
+*   @brief an alien's place in the formation's march
+*/
+struct March
+{
+	static constexpr ComponentId ID = MARCH;
+
+	int32_t direction; /**< step and direction per move tick */
+	int32_t start_y;   /**< height the formation spawns at */
+};
+
+/** @struct Shot
+*   @brief a bullet in flight
+*/
+struct Shot
+{
+	static constexpr ComponentId ID = SHOT;
+
+	int32_t speed; /**< pixels per second, negative is up */
+	bool missed;   /**< left the screen since last checked */
+};
@@ -0,0 +1,187 @@
+#include "Connection.h"
+
+#include <utility>
+
+namespace
+{
+	constexpr int RECEIVE_CHUNK = 4096; //bytes read per receive
+}
+
+
+
+Connection::Connection(Socket&& socket)
+	: socket(std::move(socket))
+{
+}
+
+
+
+const bool Connection::send(MessageType type, const uint8_t* data, int size)
+{
+	if (!socket.isOpen() || (size > MESSAGE_MAX))
+	{
+		return false;
+	}
+
+	if (getBacklog() + MESSAGE_HEADER + size > CONNECTION_BACKLOG)
+	{
+		close();
+		return false;
+	}
+
+	outbound.push_back((uint8_t)size);
+	outbound.push_back((uint8_t)(size >> 8));
+	outbound.push_back((uint8_t)type);
+	outbound.insert(outbound.end(), data, data + size);
+
+	return true;
+}
+
+
+
+const bool Connection::flush()
+{
+	while (sent_offset < (int)outbound.size())
+	{
+		int sent = socket.send(outbound.data() + sent_offset,
+			(int)outbound.size() - sent_offset);
+
+		if (sent < 0)
+		{
+			close();
+			return false;
+		}
+
+		if (sent == 0)
+		{
+			break;
+		}
+
+		sent_offset += sent;
+		bytes_sent += sent;
+	}
+
+	//keep the allocation, just forget what has gone, a slow reader's
+	//queue is moved down once most of it has been sent
+	if (sent_offset == (int)outbound.size())
+	{
+		outbound.clear();
+		sent_offset = 0;
+	}
+	else if (sent_offset > (int)outbound.size() / 2)
+	{
+		outbound.erase(outbound.begin(), outbound.begin() + sent_offset);
+		sent_offset = 0;
+	}
+
+	return socket.isOpen();
+}
+
+
+
+const bool Connection::poll()
+{
+	//drop the messages already handed out
+	if (read_offset > 0)
+	{
+		inbound.erase(inbound.begin(), inbound.begin() + read_offset);
+		read_offset = 0;
+	}
+
+	uint8_t chunk[RECEIVE_CHUNK];
+
+	//one largest message is always enough to make progress, a peer
+	//sending faster than that is read from waits in the socket instead
+	while (socket.isOpen() &&
+		((int)inbound.size() < MESSAGE_HEADER + MESSAGE_MAX))
+	{
+		int received = socket.receive(chunk, RECEIVE_CHUNK);
+
+		if (received < 0)
+		{
+			close();
+		}
+
+		if (received <= 0)
+		{
+			break;
+		}
+
+		inbound.insert(inbound.end(), chunk, chunk + received);
+		bytes_received += received;
+	}
+
+	return socket.isOpen();
+}
+
+
+
+const bool Connection::receive(MessageType& type, const uint8_t*& data,
+	int& size)
+{
+	int available = (int)inbound.size() - read_offset;
+
+	if (available < MESSAGE_HEADER)
+	{
+		return false;
+	}
+
+	const uint8_t* header = inbound.data() + read_offset;
+	int length = header[0] | (header[1] << 8);
+
+	if (available < MESSAGE_HEADER + length)
+	{
+		return false;
+	}
+
+	//a type this build doesn't know means the stream is garbage
+	if (header[2] >= (uint8_t)MessageType::COUNT)
+	{
+		close();
+		return false;
+	}
+
+	type = (MessageType)header[2];
+	data = header + MESSAGE_HEADER;
+	size = length;
+	read_offset += MESSAGE_HEADER + length;
+
+	return true;
+}
+
+
+
+void Connection::close()
+{
+	socket.close();
+	outbound.clear();
+	sent_offset = 0;
+}
+
+
+
+const bool Connection::isOpen()
+{
+	return socket.isOpen();
+}
+
+
+
+const int Connection::getBacklog()
+{
+	return (int)outbound.size() - sent_offset;
+}
+
+
+
+const uint64_t Connection::getBytesSent()
+{
+	return bytes_sent;
+}
+
+
+
+const uint64_t Connection::getBytesReceived()
+{
+	return bytes_received;
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Socket.h"
+
+/** @file Connection.h
+    @brief   Framed messages over a non-blocking socket.
+    @details Every message is a 2 byte length, a type byte and its
+             payload. Messages are queued and go out on flush(), as many
+             as the socket will take, the rest wait for the next flush.
+             A connection that can't keep up isn't waited for, its
+             backlog grows and the sender decides what to skip, past
+             CONNECTION_BACKLOG bytes it is dropped. Reads are buffered
+             the same way until a whole message has arrived, never more
+             than the largest message ahead of what has been handed out.
+*/
+
+constexpr int MESSAGE_HEADER =     3;          /**< length and type bytes */
+constexpr int MESSAGE_MAX =        0xFFFF;     /**< largest payload */
+constexpr int CONNECTION_BACKLOG = 256 * 1024; /**< queued bytes before dropping */
+
+/** @enum MessageType
+*   @brief what a message's payload holds
+*/
+enum class MessageType : uint8_t
+{
+	STATE =      0, /**< host to client, sequence, baseline and state delta */
+	INPUT =      1, /**< client to host, newest sequence received and input */
+	PEER_START = 2, /**< peer host to peer, snapshot both start from */
+	PEER_INPUT = 3, /**< either way, encoded input of the next ticks */
+	PEER_HASH =  4, /**< either way, tick and the hash of its state */
+	COUNT
+};
+
+class Connection
+{
+public:
+	Connection() = default;
+	explicit Connection(Socket&& socket);
+	~Connection() = default;
+
+	Connection(Connection&&) = default;
+	Connection& operator=(Connection&&) = default;
+
+	//queue a message, false and closed if the backlog overflows
+	const bool send(MessageType type, const uint8_t* data, int size);
+	const bool flush(); //send what the socket takes, false once closed
+	const bool poll(); //read what has arrived, false once closed
+
+	//take the next whole message, data stays valid until the next poll
+	const bool receive(MessageType& type, const uint8_t*& data, int& size);
+
+	void close();
+	const bool isOpen();
+	const int getBacklog(); //bytes queued but not yet sent
+	const uint64_t getBytesSent();
+	const uint64_t getBytesReceived();
+
+private:
+	Socket socket;
+	std::vector<uint8_t> outbound; //queued messages
+	std::vector<uint8_t> inbound;  //received bytes
+	int sent_offset =     0; //outbound bytes already sent
+	int read_offset =     0; //inbound bytes already handed out
+	uint64_t bytes_sent = 0;
+	uint64_t bytes_received = 0;
+};
@@ -6,4 +6,15 @@
 */
 
 constexpr int WINDOW_WIDTH = 1280;  /**< The window width. Defines how wide the game window is. */
-constexpr int WINDOW_HEIGHT = 720;  /**< The window height. Defines the height of the game window */
\ No newline at end of file
+constexpr int WINDOW_HEIGHT = 720;  /**< The window height. Defines the height of the game window */
+constexpr float LOAD_BUDGET = 0.008f; /**< Load budget. Seconds per frame spent loading assets behind the menu. */
+constexpr int JOB_GRAIN = 64;         /**< Job grain. Smallest number of actors handed to another thread in one job. */
+constexpr int PARTICLE_GRAIN = 1024;  /**< Particle grain. Smallest number of particles handed to another thread in one job, must be a multiple of 4. */
+constexpr float SIM_TIME_STEP = 1.0f / 60.0f; /**< Sim time step. Seconds advanced per step by the headless batch simulation. */
+constexpr int BATCH_GRAIN = 16;       /**< Batch grain. Smallest number of headless game instances handed to another thread in one job. */
+constexpr int MAX_PARTICLES = 4096;   /**< Max particles. Debris particles alive at once across every explosion, must be a multiple of 4. */
+constexpr float PARTICLE_GRAVITY = 400.0f; /**< Particle gravity. Downward pull on debris in pixels per second squared. */
+constexpr int DEBRIS_ALIEN = 48;      /**< Alien debris. Particles thrown when an alien is shot. */
+constexpr int DEBRIS_BARRIER = 16;    /**< Barrier debris. Particles thrown when a barrier is hit. */
+constexpr int DEBRIS_MOTHERSHIP = 160; /**< Mothership debris. Particles thrown when the mothership is shot. */
+constexpr int DEBRIS_PLAYER = 128;    /**< Player debris. Particles thrown when the player is shot. */
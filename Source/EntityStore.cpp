@@ -0,0 +1,51 @@
+#include "EntityStore.h"
+
+const int EntityStore::create(ArchetypeId archetype, int count)
+{
+	Archetype& target = archetypes[archetype];
+	int first = target.count;
+
+	target.count += count;
+
+	for (Column& column : target.columns)
+	{
+		//resize value initialises, so new rows start zeroed
+		column.data.resize((size_t)target.count * column.size);
+	}
+
+	return first;
+}
+
+
+
+void EntityStore::clear(ArchetypeId archetype)
+{
+	Archetype& target = archetypes[archetype];
+	target.count = 0;
+
+	for (Column& column : target.columns)
+	{
+		column.data.clear();
+	}
+}
+
+
+
+const int EntityStore::getCount(ArchetypeId archetype)
+{
+	return archetypes[archetype].count;
+}
+
+
+
+const int EntityStore::getArchetypeCount()
+{
+	return (int)archetypes.size();
+}
+
+
+
+const ComponentMask EntityStore::getMask(ArchetypeId archetype)
+{
+	return archetypes[archetype].mask;
+}
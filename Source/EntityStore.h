@@ -0,0 +1,118 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "Components.h"
+
+/** @file EntityStore.h
+    @brief   Archetype storage for every entity in a world.
+    @details An archetype is a fixed set of components, and an entity is a
+             row in exactly one archetype. Each component of an archetype
+             is one dense column, so a system walks a column or two from
+             start to end with no pointer to chase and no virtual call.
+             Systems ask each() for the components they need and are called
+             once per archetype that has all of them. Rows are never
+             removed, a dead entity keeps its row so indices handed out in
+             events and snapshots stay valid. Growing an archetype may move
+             its columns, so column pointers are fetched again after
+             create().
+*/
+
+using ArchetypeId = int;
+
+class EntityStore
+{
+public:
+	EntityStore() = default;
+	~EntityStore() = default;
+
+	//new archetype of components C plus any tags, ids count up from 0
+	template<typename... C>
+	const ArchetypeId addArchetype(ComponentMask tags = 0);
+
+	//append count zeroed rows, returns the first of them
+	const int create(ArchetypeId archetype, int count = 1);
+	void clear(ArchetypeId archetype); //drop every row
+
+	const int getCount(ArchetypeId archetype); //rows in archetype
+	const int getArchetypeCount(); //archetypes added
+	const ComponentMask getMask(ArchetypeId archetype); //components and tags
+
+	//column of component C, null if the archetype doesn't have one
+	template<typename C>
+	C* get(ArchetypeId archetype);
+
+	//call func(archetype, count, C*...) for every archetype with all of C
+	//and none of the excluded components or tags
+	template<typename... C, typename Func>
+	void each(Func func, ComponentMask exclude = 0);
+
+private:
+	struct Column
+	{
+		std::vector<uint8_t> data; //count * size bytes
+		uint32_t size = 0;         //bytes per row, 0 if not in archetype
+	};
+
+	struct Archetype
+	{
+		ComponentMask mask = 0;
+		int count = 0;
+		Column columns[COMPONENT_TYPES]; //by component id
+	};
+
+	std::vector<Archetype> archetypes;
+};
+
+
+
+template<typename... C>
+const ArchetypeId EntityStore::addArchetype(ComponentMask tags)
+{
+	static_assert((std::is_trivially_copyable<C>::value && ...),
+		"components are stored and copied as raw bytes");
+
+	Archetype archetype;
+	archetype.mask = tags | componentMask(C::ID...);
+	((archetype.columns[C::ID].size = (uint32_t)sizeof(C)), ...);
+
+	archetypes.push_back(std::move(archetype));
+
+	return (ArchetypeId)archetypes.size() - 1;
+}
+
+
+
+template<typename C>
+C* EntityStore::get(ArchetypeId archetype)
+{
+	Column& column = archetypes[archetype].columns[C::ID];
+
+	if (column.size == 0)
+	{
+		return nullptr;
+	}
+
+	//vector storage is aligned for any fundamental type
+	return reinterpret_cast<C*>(column.data.data());
+}
+
+
+
+template<typename... C, typename Func>
+void EntityStore::each(Func func, ComponentMask exclude)
+{
+	const ComponentMask include = componentMask(C::ID...);
+
+	for (ArchetypeId i = 0; i < (ArchetypeId)archetypes.size(); i++)
+	{
+		ComponentMask mask = archetypes[i].mask;
+
+		if (((mask & include) == include) && ((mask & exclude) == 0))
+		{
+			func(i, archetypes[i].count, get<C>(i)...);
+		}
+	}
+}
@@ -0,0 +1,108 @@
+#include "EventBus.h"
+
+void EventBus::publish(GameEventType type, const GameEvent& event)
+{
+	Channel& channel = channels[(int)type];
+
+	if (channel.count == EVENT_CAPACITY)
+	{
+		dropped++;
+		return;
+	}
+
+	channel.events[channel.count] = event;
+	channel.count++;
+}
+
+
+
+const bool EventBus::subscribe(GameEventType type, Handler handler,
+	void* context)
+{
+	Channel& channel = channels[(int)type];
+
+	if (channel.subscriber_count == EVENT_SUBSCRIBERS)
+	{
+		return false;
+	}
+
+	channel.subscribers[channel.subscriber_count] = { handler, context, false };
+	channel.subscriber_count++;
+
+	return true;
+}
+
+
+
+const bool EventBus::subscribeEffect(GameEventType type, Handler handler,
+	void* context)
+{
+	if (!subscribe(type, handler, context))
+	{
+		return false;
+	}
+
+	Channel& channel = channels[(int)type];
+	channel.subscribers[channel.subscriber_count - 1].effect = true;
+
+	return true;
+}
+
+
+
+void EventBus::setSilenced(bool silenced)
+{
+	this->silenced = silenced;
+}
+
+
+
+void EventBus::dispatch()
+{
+	for (Channel& channel : channels)
+	{
+		if (channel.count == 0)
+		{
+			continue;
+		}
+
+		for (int i = 0; i < channel.subscriber_count; i++)
+		{
+			Subscriber& subscriber = channel.subscribers[i];
+
+			if (subscriber.effect && silenced)
+			{
+				continue;
+			}
+
+			subscriber.handler(subscriber.context, channel.events,
+				channel.count);
+		}
+
+		channel.count = 0;
+	}
+}
+
+
+
+void EventBus::clear()
+{
+	for (Channel& channel : channels)
+	{
+		channel.count = 0;
+	}
+}
+
+
+
+const int EventBus::getCount(GameEventType type)
+{
+	return channels[(int)type].count;
+}
+
+
+
+const int EventBus::getDropped()
+{
+	return dropped;
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <cstdint>
+
+/** @file EventBus.h
+    @brief   Fixed capacity gameplay event queue.
+    @details Collision and rules code publishes events while it runs,
+             nothing reacts straight away. Once the tick's collisions are
+             done the world calls dispatch(), which hands each subscriber
+             every event of the type it asked for as one contiguous batch.
+             Storage is fixed at compile time so publishing never
+             allocates, events past capacity are counted and dropped.
+             Rules and effects subscribe separately so a tick can be
+             stepped again with the rules applied but nothing replayed.
+*/
+
+/** @enum GameEventType
+*   @brief what happened, subscribers are called in this order
+*/
+enum class GameEventType
+{
+	SHOT_MISSED =       0, /**< player bullet left the screen or hit a barrier */
+	ALIEN_KILLED =      1, /**< index is the alien, value its score */
+	WAVE_CLEARED =      2, /**< every alien is dead */
+	PLAYER_HIT =        3, /**< player shot by an alien */
+	BARRIER_HIT =       4, /**< index is the barrier, value 1 if player shot */
+	MOTHERSHIP_KILLED = 5, /**< value is its score */
+	PLAYER_SHOT =       6, /**< player fired */
+	ALIEN_SHOT =        7, /**< index is the alien that fired */
+	ALARM =             8, /**< mothership alarm is due */
+	COUNT
+};
+
+/** @struct GameEvent
+*   @brief one event, fields not used by a type are zero
+*/
+struct GameEvent
+{
+	int32_t x;     /**< screen x of whatever was involved */
+	int32_t y;     /**< screen y of whatever was involved */
+	int32_t index; /**< actor index within its group */
+	int32_t value; /**< type specific, see GameEventType */
+};
+
+constexpr int EVENT_CAPACITY =       64; /**< events per type per dispatch */
+constexpr int EVENT_SUBSCRIBERS =    4;  /**< subscribers per type */
+
+class EventBus
+{
+public:
+	//called with every event of one type since the last dispatch
+	using Handler = void(*)(void* context, const GameEvent* events,
+		int count);
+
+	EventBus() = default;
+	~EventBus() = default;
+
+	//queue an event, dropped and counted if its buffer is full
+	void publish(GameEventType type, const GameEvent& event);
+
+	//call handler with context on each dispatch that has events of type
+	const bool subscribe(GameEventType type, Handler handler, void* context);
+
+	//same, for a handler that only presents events, sounds and debris,
+	//which is skipped while the bus is silenced
+	const bool subscribeEffect(GameEventType type, Handler handler,
+		void* context);
+
+	//skip effect handlers, for ticks that are being stepped again
+	void setSilenced(bool silenced);
+
+	void dispatch(); //run subscribers then clear every buffer
+	void clear(); //forget queued events without dispatching
+
+	const int getCount(GameEventType type); //events queued of type
+	const int getDropped(); //events lost to full buffers, ever
+
+private:
+	struct Subscriber
+	{
+		Handler handler;
+		void* context;
+		bool effect; //skipped while silenced
+	};
+
+	struct Channel
+	{
+		GameEvent events[EVENT_CAPACITY];
+		int count = 0;
+		Subscriber subscribers[EVENT_SUBSCRIBERS];
+		int subscriber_count = 0;
+	};
+
+	Channel channels[(int)GameEventType::COUNT]; //one per event type
+	int dropped = 0; //publishes that didn't fit
+	bool silenced = false; //effect handlers are skipped
+};
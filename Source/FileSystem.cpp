@@ -0,0 +1,303 @@
+#include "FileSystem.h"
+#include "AssetPack.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+DirectoryMount::DirectoryMount(const std::string& directory)
+	: root(directory)
+{
+
+}
+
+
+
+bool DirectoryMount::exists(const std::string& name)
+{
+	std::error_code error;
+	return fs::is_regular_file(fs::path(root) / name, error);
+}
+
+
+
+std::string DirectoryMount::getNativePath(const std::string& name)
+{
+	//names use forward slashes, let the platform pick its separator
+	fs::path path = fs::path(root) / name;
+	return path.make_preferred().string();
+}
+
+
+
+const void* DirectoryMount::getData(const std::string&, size_t& size)
+{
+	size = 0;
+	return nullptr;
+}
+
+
+
+PackMount::PackMount(AssetPack& archive)
+	: pack(archive)
+{
+
+}
+
+
+
+bool PackMount::exists(const std::string& name)
+{
+	//index names are fixed length, longer names can't be in the pack
+	return (name.size() < sizeof(PackEntry::name)) &&
+		(pack.find(name.c_str()) != nullptr);
+}
+
+
+
+std::string PackMount::getNativePath(const std::string&)
+{
+	return std::string();
+}
+
+
+
+const void* PackMount::getData(const std::string& name, size_t& size)
+{
+	const PackEntry* entry = (name.size() < sizeof(PackEntry::name)) ?
+		pack.find(name.c_str()) : nullptr;
+
+	if (!entry || (entry->type != (uint32_t)PackEntryType::RAW))
+	{
+		size = 0;
+		return nullptr;
+	}
+
+	size = entry->size;
+	return pack.getData(entry);
+}
+
+
+
+void MemoryMount::add(const std::string& name, std::vector<uint8_t> bytes)
+{
+	files[FileSystem::normalise(name.c_str())] = std::move(bytes);
+}
+
+
+
+bool MemoryMount::exists(const std::string& name)
+{
+	return files.count(name) != 0;
+}
+
+
+
+std::string MemoryMount::getNativePath(const std::string&)
+{
+	return std::string();
+}
+
+
+
+const void* MemoryMount::getData(const std::string& name, size_t& size)
+{
+	auto file = files.find(name);
+
+	if (file == files.end())
+	{
+		size = 0;
+		return nullptr;
+	}
+
+	size = file->second.size();
+	return file->second.data();
+}
+
+
+
+void FileSystem::mount(std::unique_ptr<FileMount> file_mount)
+{
+	mounts.push_back(std::move(file_mount));
+
+	//the new mount may shadow names already resolved
+	for (Record& record : records)
+	{
+		resolve(record);
+	}
+}
+
+
+
+AssetId FileSystem::intern(const char* name)
+{
+	std::string normalised = normalise(name);
+	auto found = ids.find(normalised);
+
+	if (found != ids.end())
+	{
+		return found->second;
+	}
+
+	AssetId id = (AssetId)records.size();
+
+	records.push_back({ normalised, std::string(), nullptr });
+	resolve(records.back());
+	ids.emplace(normalised, id);
+
+	return id;
+}
+
+
+
+AssetId FileSystem::find(const char* name)
+{
+	auto found = ids.find(normalise(name));
+	return (found != ids.end()) ? found->second : NO_ASSET;
+}
+
+
+
+const bool FileSystem::exists(AssetId id)
+{
+	return (id >= 0) && (id < (AssetId)records.size()) &&
+		(records[id].mount != nullptr);
+}
+
+
+
+const char* FileSystem::getName(AssetId id)
+{
+	if ((id < 0) || (id >= (AssetId)records.size()))
+	{
+		return "";
+	}
+
+	return records[id].name.c_str();
+}
+
+
+
+const char* FileSystem::getPath(AssetId id)
+{
+	if ((id < 0) || (id >= (AssetId)records.size()))
+	{
+		return "";
+	}
+
+	return records[id].path.c_str();
+}
+
+
+
+const void* FileSystem::getData(AssetId id, size_t& size)
+{
+	if (!exists(id))
+	{
+		size = 0;
+		return nullptr;
+	}
+
+	return records[id].mount->getData(records[id].name, size);
+}
+
+
+
+const bool FileSystem::read(AssetId id, std::vector<uint8_t>& bytes)
+{
+	size_t size = 0;
+	const void* data = getData(id, size);
+
+	if (data)
+	{
+		bytes.resize(size);
+		std::memcpy(bytes.data(), data, size);
+		return true;
+	}
+
+	//loose file
+	const char* path = getPath(id);
+
+	if (path[0] == '\0')
+	{
+		return false;
+	}
+
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+
+	if (!file)
+	{
+		return false;
+	}
+
+	bytes.resize((size_t)file.tellg());
+	file.seekg(0);
+
+	return (bool)file.read(reinterpret_cast<char*>(bytes.data()), bytes.size());
+}
+
+
+
+const int FileSystem::getCount()
+{
+	return (int)records.size();
+}
+
+
+
+std::string FileSystem::normalise(const char* name)
+{
+	std::string normalised(name);
+
+	for (char& c : normalised)
+	{
+		if (c == '\\')
+		{
+			c = '/';
+		}
+	}
+
+	//strip leading "./" and "/" so every spelling interns to one id
+	size_t start = 0;
+
+	while (start < normalised.size())
+	{
+		if (normalised.compare(start, 2, "./") == 0)
+		{
+			start += 2;
+		}
+
+		else if (normalised[start] == '/')
+		{
+			start++;
+		}
+
+		else
+		{
+			break;
+		}
+	}
+
+	return normalised.substr(start);
+}
+
+
+
+void FileSystem::resolve(Record& record)
+{
+	record.mount = nullptr;
+	record.path.clear();
+
+	//newest mount wins
+	for (auto mount = mounts.rbegin(); mount != mounts.rend(); ++mount)
+	{
+		if ((*mount)->exists(record.name))
+		{
+			record.mount = mount->get();
+			record.path = (*mount)->getNativePath(record.name);
+			return;
+		}
+	}
+}
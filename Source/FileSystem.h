@@ -0,0 +1,143 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/** @file FileSystem.h
+    @brief   Virtual filesystem the game resolves its assets through.
+    @details Assets are named by their path relative to Resources with
+             forward slashes, e.g. "Textures/Player.png", whatever the
+             platform. Names are interned to integer ids once at start up
+             and resolved against the mounts at the same time, so every
+             later lookup is a table index. Mounts are searched newest
+             first, which lets a packed archive shadow the loose files it
+             was built from and an in-memory mount shadow both.
+*/
+
+class AssetPack;
+
+using AssetId = int32_t;
+constexpr AssetId NO_ASSET = -1; /**< id of a name never interned */
+
+/**
+*   @brief   Somewhere assets can be found.
+*   @details Directory mounts have files a native API can open, archive and
+*            memory mounts only hold bytes.
+*/
+class FileMount
+{
+public:
+	virtual ~FileMount() = default;
+
+	virtual bool exists(const std::string& name) = 0; //is name in this mount
+	virtual std::string getNativePath(const std::string& name) = 0; //"" if not on disk
+	virtual const void* getData(const std::string& name, size_t& size) = 0; //nullptr if not in memory
+};
+
+
+
+/**
+*   @brief   Loose files under a root directory.
+*/
+class DirectoryMount :
+	public FileMount
+{
+public:
+	explicit DirectoryMount(const std::string& directory);
+
+	bool exists(const std::string& name) override;
+	std::string getNativePath(const std::string& name) override;
+	const void* getData(const std::string& name, size_t& size) override;
+
+private:
+	std::string root; //directory names are relative to
+};
+
+
+
+/**
+*   @brief   Entries of a mapped Resources.pak.
+*   @details Only RAW entries are served as bytes, PCM entries are decoded
+*            samples rather than the file and reach irrKlang through
+*            AssetPack::registerSounds instead. The pack must stay open for
+*            as long as it is mounted.
+*/
+class PackMount :
+	public FileMount
+{
+public:
+	explicit PackMount(AssetPack& archive);
+
+	bool exists(const std::string& name) override;
+	std::string getNativePath(const std::string& name) override;
+	const void* getData(const std::string& name, size_t& size) override;
+
+private:
+	AssetPack& pack;
+};
+
+
+
+/**
+*   @brief   Files held in memory, for defaults built into a binary and
+*            for tools that generate assets without touching the disk.
+*/
+class MemoryMount :
+	public FileMount
+{
+public:
+	void add(const std::string& name, std::vector<uint8_t> bytes); //replaces name
+
+	bool exists(const std::string& name) override;
+	std::string getNativePath(const std::string& name) override;
+	const void* getData(const std::string& name, size_t& size) override;
+
+private:
+	std::unordered_map<std::string, std::vector<uint8_t>> files;
+};
+
+
+
+class FileSystem
+{
+public:
+	FileSystem() = default;
+	~FileSystem() = default;
+
+	FileSystem(const FileSystem&) = delete;
+	FileSystem& operator=(const FileSystem&) = delete;
+
+	//searched before everything mounted earlier, interned names are
+	//resolved again
+	void mount(std::unique_ptr<FileMount> file_mount);
+
+	AssetId intern(const char* name); //same name always gives the same id
+	AssetId find(const char* name); //NO_ASSET if never interned
+
+	const bool exists(AssetId id); //found in any mount
+	const char* getName(AssetId id); //interned name, "" for NO_ASSET
+	const char* getPath(AssetId id); //native path, "" if not a loose file
+	const void* getData(AssetId id, size_t& size); //bytes if held in memory
+	const bool read(AssetId id, std::vector<uint8_t>& bytes); //from any mount
+	const int getCount(); //names interned
+
+	//forward slashes, no leading "./" or "/"
+	static std::string normalise(const char* name);
+
+private:
+	struct Record
+	{
+		std::string name; //normalised name
+		std::string path; //native path when the mount is a directory
+		FileMount* mount; //newest mount holding name, nullptr if none
+	};
+
+	void resolve(Record& record); //find the mount serving record
+
+	std::vector<std::unique_ptr<FileMount>> mounts; //oldest first
+	std::vector<Record> records; //indexed by AssetId
+	std::unordered_map<std::string, AssetId> ids; //name to id, start up only
+};
@@ -0,0 +1,249 @@
+#include "FileWatcher.h"
+
+#include <chrono>
+#include <filesystem>
+#include <set>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+FileWatcher::~FileWatcher()
+{
+	stop();
+}
+
+
+
+bool FileWatcher::start(const std::vector<std::string>& directories,
+	Callback callback)
+{
+	stop();
+
+	on_change = std::move(callback);
+
+#ifdef __linux__
+	inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+	if (inotify_fd < 0)
+	{
+		return false;
+	}
+
+	for (const std::string& directory : directories)
+	{
+		watchTree(directory, "");
+	}
+
+	if (watches.empty())
+	{
+		close(inotify_fd);
+		inotify_fd = -1;
+		return false;
+	}
+#else
+	for (const std::string& directory : directories)
+	{
+		std::error_code error;
+
+		if (fs::is_directory(directory, error))
+		{
+			roots.push_back(directory);
+		}
+	}
+
+	if (roots.empty())
+	{
+		return false;
+	}
+
+	//what is there now isn't a change
+	scan(false);
+#endif
+
+	running = true;
+	thread = std::thread(&FileWatcher::run, this);
+
+	return true;
+}
+
+
+
+void FileWatcher::stop()
+{
+	running = false;
+
+	if (thread.joinable())
+	{
+		thread.join();
+	}
+
+#ifdef __linux__
+	if (inotify_fd >= 0)
+	{
+		close(inotify_fd);
+		inotify_fd = -1;
+	}
+
+	watches.clear();
+#else
+	roots.clear();
+	times.clear();
+#endif
+}
+
+
+
+const bool FileWatcher::isRunning()
+{
+	return running;
+}
+
+
+
+#ifdef __linux__
+void FileWatcher::watchTree(const std::string& root,
+	const std::string& directory)
+{
+	fs::path path = directory.empty() ? fs::path(root) : fs::path(root) / directory;
+
+	//written in place or saved elsewhere and renamed over, new directories
+	//get watches of their own
+	int wd = inotify_add_watch(inotify_fd, path.c_str(),
+		IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR);
+
+	if (wd < 0)
+	{
+		return;
+	}
+
+	watches[wd] = { root, directory };
+
+	std::error_code error;
+
+	for (const fs::directory_entry& entry : fs::directory_iterator(path, error))
+	{
+		if (entry.is_directory(error))
+		{
+			fs::path child = fs::path(directory) / entry.path().filename();
+			watchTree(root, child.generic_string());
+		}
+	}
+}
+
+
+
+void FileWatcher::run()
+{
+	alignas(inotify_event) char buffer[4096];
+
+	while (running)
+	{
+		//wake now and then to see if we should stop
+		pollfd descriptor = { inotify_fd, POLLIN, 0 };
+
+		if (poll(&descriptor, 1, 200) <= 0)
+		{
+			continue;
+		}
+
+		//editors often write a file more than once per save
+		std::set<std::pair<std::string, std::string>> changed;
+		ssize_t length = 0;
+
+		while ((length = read(inotify_fd, buffer, sizeof(buffer))) > 0)
+		{
+			for (char* next = buffer; next < buffer + length;)
+			{
+				const inotify_event* event =
+					reinterpret_cast<const inotify_event*>(next);
+				next += sizeof(inotify_event) + event->len;
+
+				auto watch = watches.find(event->wd);
+
+				if ((watch == watches.end()) || (event->len == 0))
+				{
+					continue;
+				}
+
+				fs::path name = fs::path(watch->second.directory) / event->name;
+
+				if (event->mask & IN_ISDIR)
+				{
+					if (event->mask & IN_CREATE)
+					{
+						watchTree(watch->second.root, name.generic_string());
+					}
+				}
+
+				else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+				{
+					changed.emplace(watch->second.root, name.generic_string());
+				}
+			}
+		}
+
+		for (const auto& file : changed)
+		{
+			on_change(file.first, file.second);
+		}
+	}
+}
+#else
+void FileWatcher::scan(bool report)
+{
+	for (const std::string& root : roots)
+	{
+		std::error_code error;
+
+		for (const fs::directory_entry& entry :
+			fs::recursive_directory_iterator(root, error))
+		{
+			if (!entry.is_regular_file(error))
+			{
+				continue;
+			}
+
+			long long time = (long long)
+				entry.last_write_time(error).time_since_epoch().count();
+			std::string path = entry.path().string();
+			auto seen = times.find(path);
+
+			if (seen == times.end())
+			{
+				times.emplace(path, time);
+			}
+
+			else if (seen->second != time)
+			{
+				seen->second = time;
+			}
+
+			else
+			{
+				continue;
+			}
+
+			if (report)
+			{
+				on_change(root, entry.path().lexically_relative(root).generic_string());
+			}
+		}
+	}
+}
+
+
+
+void FileWatcher::run()
+{
+	while (running)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(500));
+		scan(true);
+	}
+}
+#endif
@@ -0,0 +1,63 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/** @file FileWatcher.h
+    @brief   Reports files written under a set of directories.
+    @details A background thread waits on inotify on Linux and compares
+             modification times twice a second elsewhere. Changes are
+             handed to the callback on that thread, once per file per batch
+             of events, so whatever the callback does with the file stays
+             off the game loop. Only files that are written or moved into
+             place are reported, not deletions.
+*/
+
+class FileWatcher
+{
+public:
+	//root is the watched directory, name is relative to it with
+	//forward slashes, called on the watcher's thread
+	using Callback = std::function<void(const std::string& root,
+		const std::string& name)>;
+
+	FileWatcher() = default;
+	~FileWatcher();
+
+	FileWatcher(const FileWatcher&) = delete;
+	FileWatcher& operator=(const FileWatcher&) = delete;
+
+	//watch every directory, and those below them, false if none could be
+	bool start(const std::vector<std::string>& directories, Callback callback);
+	void stop(); //joins the watcher thread
+	const bool isRunning(); //between start and stop
+
+private:
+	void run(); //watcher thread
+
+	Callback on_change;
+	std::thread thread;
+	std::atomic<bool> running{ false };
+
+#ifdef __linux__
+	//directory a watch descriptor watches
+	struct Watch
+	{
+		std::string root;      //directory given to start
+		std::string directory; //relative to root, "" for root itself
+	};
+
+	void watchTree(const std::string& root, const std::string& directory);
+
+	int inotify_fd = -1;
+	std::unordered_map<int, Watch> watches; //by watch descriptor
+#else
+	void scan(bool report); //compare modification times
+
+	std::vector<std::string> roots; //directories given to start
+	std::unordered_map<std::string, long long> times; //last seen, by path
+#endif
+};
@@ -0,0 +1,99 @@
+#include "FrontLine.h"
+
+void FrontLine::reset(int formation_rows, int formation_columns)
+{
+	rows = formation_rows;
+	columns = formation_columns;
+
+	for (int c = 0; c < columns; c++)
+	{
+		front[c] = (int8_t)(rows - 1);
+	}
+
+	collect();
+}
+
+
+
+void FrontLine::rebuild(AliveSet& alive, int formation_rows,
+	int formation_columns)
+{
+	rows = formation_rows;
+	columns = formation_columns;
+
+	//lowest living alien of each column
+	for (int c = 0; c < columns; c++)
+	{
+		int row = rows - 1;
+
+		while ((row >= 0) && !((alive.getRow(row) >> c) & 1))
+		{
+			row--;
+		}
+
+		front[c] = (int8_t)row;
+	}
+
+	collect();
+}
+
+
+
+void FrontLine::kill(int alien, AliveSet& alive)
+{
+	int column = alien % columns;
+	int row = alien / columns;
+
+	//aliens behind the front don't change who shoots
+	if (front[column] != row)
+	{
+		return;
+	}
+
+	row--;
+
+	while ((row >= 0) && !((alive.getRow(row) >> column) & 1))
+	{
+		row--;
+	}
+
+	front[column] = (int8_t)row;
+	collect();
+}
+
+
+
+const int* FrontLine::getShooters()
+{
+	return shooters;
+}
+
+
+
+const int FrontLine::getCount()
+{
+	return count;
+}
+
+
+
+const bool FrontLine::isShooter(int alien)
+{
+	return front[alien % columns] == alien / columns;
+}
+
+
+
+void FrontLine::collect()
+{
+	count = 0;
+
+	for (int c = 0; c < columns; c++)
+	{
+		if (front[c] >= 0)
+		{
+			shooters[count] = front[c] * columns + c;
+			count++;
+		}
+	}
+}
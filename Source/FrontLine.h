@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+
+#include "AliveSet.h"
+#include "WaveConfig.h"
+
+/** @file FrontLine.h
+    @brief   Which aliens are allowed to shoot.
+    @details Only the lowest living alien in each column can shoot. The
+             front row of every column is kept here and only changes when
+             one of those aliens is killed, the alien above it is then
+             found by climbing that column's bits in the AliveSet. A new
+             wave puts every column back to its bottom row. The shooters
+             are kept as a list, so choosing who fires costs the same
+             however deep the formation is.
+*/
+
+class FrontLine
+{
+public:
+	FrontLine() = default;
+	~FrontLine() = default;
+
+	void reset(int rows, int columns); //full formation, bottom row shoots
+	void rebuild(AliveSet& alive, int rows, int columns); //restored games
+
+	//alien has just been cleared from alive, the one above takes over if
+	//it was the shooter
+	void kill(int alien, AliveSet& alive);
+
+	const int* getShooters(); //alien index per column with one, left first
+	const int getCount(); //columns with a living alien
+	const bool isShooter(int alien); //lowest living alien in its column
+
+private:
+	void collect(); //list the shooters from front
+
+	int rows =    0; //formation size
+	int columns = 0;
+	int8_t front[MAX_WAVE_COLUMNS] = {}; //lowest living row, -1 if cleared
+	int shooters[MAX_WAVE_COLUMNS] = {}; //alien index of each front
+	int count =   0; //shooters listed
+};
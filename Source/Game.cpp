@@ -2,8 +2,12 @@
 #include "Actions.h"
 #include "Constants.h"
 #include "GameFont.h"
+#include "TextureScales.h"
 
+#include <algorithm>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <sstream>
 
 #include <Engine/Input.h>
@@ -14,12 +18,147 @@
 #include <chrono>
 #include <random>
 
+//Resources as seen from the working directory, copied next to the
+//binary by the build or two levels up from the Visual Studio project,
+//the first is searched first
+static const char* RESOURCE_DIRECTORIES[] =
+{
+	"Resources",
+	"../../Resources"
+};
+
+//textures shrunk to the size they are drawn at by TextureImporter, in
+//the same order
+static const char* IMPORTED_DIRECTORIES[] =
+{
+	"Resources/Imported",
+	"../../Resources/Imported"
+};
+
+//quick save written from the pause screen
+static const char* QUICK_SAVE_FILE = "quicksave.sav";
+
+//inputs of the last game played, written at game over
+static const char* REPLAY_FILE = "last_game.rpl";
+
+
+
+
+/**
+*   @brief   Reads texture files into the OS file cache.
+*   @details ASGE decodes textures on the main thread inside loadTexture,
+*            reading them ahead here means those loads don't also wait on
+*            the disk.
+*   @param   paths native paths of the game's textures
+*   @return  True if every file could be read.
+*/
+static bool prefetchTextures(const std::vector<std::string>& paths)
+{
+	bool all_read = true;
+	std::vector<char> buffer(64 * 1024);
+
+	for (const std::string& path : paths)
+	{
+		std::ifstream file(path, std::ios::binary);
+
+		if (!file)
+		{
+			all_read = false;
+			continue;
+		}
+
+		while (file.read(buffer.data(), buffer.size()))
+		{
+
+		}
+	}
+
+	return all_read;
+}
+
+
+
+/**
+*   @brief   Draws a sprite at an entity's position.
+*   @details One sprite stands in for every entity that looks alike, it is
+*            moved to each in turn.
+*   @param   renderer the renderer to draw with
+*   @param   sprite the entity's look
+*   @param   at where the entity is
+*/
+static void renderAt(std::shared_ptr<ASGE::Renderer>& renderer,
+	ASGE::Sprite& sprite, const Position& at)
+{
+	sprite.position[0] = at.x;
+	sprite.position[1] = at.y;
+	sprite.render(renderer);
+}
+
+
+
+/**
+*   @brief   Scales a sprite to the size its texture is drawn at.
+*   @details The file loaded may be an import already shrunk towards that
+*            size, the scale is taken against whichever was loaded.
+*   @param   sprite sprite that has just loaded texture
+*   @param   texture the asset it loaded
+*/
+static void fitScale(ASGE::Sprite& sprite, Asset texture)
+{
+	float scale = getTextureScale(texture);
+
+	if (sprite.size[0] > 0)
+	{
+		scale *= (float)ASSET_INFO[texture].width / sprite.size[0];
+	}
+
+	sprite.scale = scale;
+}
+
+
+
+/**
+*   @brief   Draws every listed item of a look.
+*   @param   renderer the renderer to draw with
+*   @param   sprite the look's sprite, moved to each item
+*   @param   list this frame's render list
+*   @param   look which group of the list to draw
+*/
+static void renderLook(std::shared_ptr<ASGE::Renderer>& renderer,
+	ASGE::Sprite& sprite, RenderList& list, RenderLook look)
+{
+	const Position* items = list.getItems(look);
+
+	for (int i = 0; i < list.getCount(look); i++)
+	{
+		renderAt(renderer, sprite, items[i]);
+	}
+}
+
+
+
+/**
+*   @brief   On screen size of a sprite.
+*   @param   list the render list culling with it
+*   @param   look the items drawn with sprite
+*   @param   sprite the look's sprite
+*/
+static void setExtent(RenderList& list, RenderLook look,
+	ASGE::Sprite& sprite)
+{
+	list.setExtent(look, (int)(sprite.size[0] * sprite.scale),
+		(int)(sprite.size[1] * sprite.scale));
+}
+
+
+
 /**
 *   @brief   Default Constructor.
 */
 InvadersGame::InvadersGame()
+	: world(std::random_device()(), &jobs)
 {
-
+	subscribeEvents();
 }
 
 
@@ -30,7 +169,14 @@ InvadersGame::InvadersGame()
 */
 InvadersGame::~InvadersGame()
 {
-	audio_engine->stopAllSounds();
+	//audio may still be starting up on another thread
+	load_queue.cancel();
+	hot_reload.stop();
+
+	if (audio_engine)
+	{
+		audio_engine->stopAllSounds();
+	}
 
 	this->inputs->unregisterCallback(callback_id);
 }
@@ -39,9 +185,11 @@ InvadersGame::~InvadersGame()
 
 /**
 *   @brief   Initialises the game.
-*   @details The game window is created and all assets required to
-			 run the game are loaded. The input callback should also
-			 be set in the initialise function. 
+*   @details The game window is created and the assets needed by the
+			 main menu are loaded. Everything else is queued and loaded
+			 a few milliseconds per frame while the menu is showing,
+			 audio is started on a background thread. The input callback
+			 should also be set in the initialise function. 
 *   @return  True if the game initialised correctly.
 */
 bool InvadersGame::init()
@@ -61,9 +209,12 @@ bool InvadersGame::init()
 	state_callback_id = this->inputs->addCallbackFnc(
 	&InvadersGame::stateInput, this);
 
+	//every asset is looked up by id from here on
+	mountResources();
+
 	// load fonts we need
 	GameFont::fonts[0] = new GameFont(renderer->loadFont(
-	"..\\..\\Resources\\Fonts\\Comic.ttf", 42), "default", 42);
+	getAssetPath(FONT_COMIC), 42), "default", 42);
 	
 	if (GameFont::fonts[0]->id == -1)
 	{
@@ -75,45 +226,169 @@ bool InvadersGame::init()
 	invader->position[0] = 700;
 	invader->position[1] = 250;
 
-	if (!invader->loadTexture("..\\..\\Resources\\Textures\\Invader.jpg"))
+	if (!invader->loadTexture(getAssetPath(TEXTURE_INVADER)))
 	{
 		return false;
 	}
 
-	//load explosion sprite
-	explosion = renderer->createSprite();
-	explosion->loadTexture("..\\..\\Resources\\Textures\\Explosion.png");
-	explosion->scale = 0.1;
-	explosion->position[0] = -30;
-	explosion->position[1] = -30;
+	//menu button sprites
+	loadMenuUI();
+
+	//tuning art and balance shouldn't need a restart
+	std::vector<std::string> directories(std::begin(RESOURCE_DIRECTORIES),
+		std::end(RESOURCE_DIRECTORIES));
+
+	hot_reload.start(directories);
+
+	//start audio and read ahead textures off the main thread
+	load_queue.addBackground("audio", [this]()
+	{
+		return initAudio();
+	});
+
+	//copied so the prefetch thread owns what it reads
+	std::vector<std::string> paths;
+
+	for (int i = 0; i < ASSET_COUNT; i++)
+	{
+		AssetFormat format = ASSET_INFO[i].format;
+
+		if ((format == AssetFormat::PNG) || (format == AssetFormat::JPEG))
+		{
+			paths.push_back(getAssetPath((Asset)i));
+		}
+	}
+
+	load_queue.addBackground("texture prefetch", [paths]()
+	{
+		return prefetchTextures(paths);
+	});
+
+	//gameplay assets are loaded in steps from the menu
+	load_queue.add("debris", [this]()
+	{
+		debris = loadSprite(TEXTURE_EXPLOSION);
+	});
+
+	load_queue.add("ui", [this]()
+	{
+		loadUI();
+	});
 
-	loadUI();
+	// load player sprite
+	load_queue.add("player", [this]()
+	{
+		player = loadSprite(TEXTURE_PLAYER);
+	});
 
-	// load player and player sprite
-	player_one = std::make_unique<Player>();
-	player_one->loadPlayer(renderer);
+	// load bullet sprite, shared by the player and the aliens
+	load_queue.add("bullets", [this]()
+	{
+		bullet = loadSprite(TEXTURE_BULLET);
+	});
 
-	// load bullet and bullet sprite
-	bullet_one = std::make_unique<Bullet>();
-	bullet_one->loadBullet(renderer);
+	// load mothership sprite
+	load_queue.add("mothership", [this]()
+	{
+		mothership = loadSprite(TEXTURE_SPACESHIP);
+	});
 
-	// load mothership and mothership sprite
-	mothership_one = std::make_unique<Mothership>();
-	mothership_one->loadEnemy(renderer);
+	//formation and difficulty, compiled from Config/Waves.txt
+	WaveTable waves;
 
-	loadEnemies();
+	if (loadWaves(getAssetPath(DATA_WAVES), waves))
+	{
+		world.setWaves(waves);
+	}
 
-	loadBullets();
+	load_queue.add("aliens", [this]()
+	{
+		loadAliens();
+	});
 
-	loadBarriers();
+	// one solid pixel, stretched over each run of a barrier
+	load_queue.add("barriers", [this]()
+	{
+		barrier_pixel = loadSprite(TEXTURE_BARRIER_PIXEL);
+	});
 
-	initAudio();
+	//clients can join the host any time, joining needs a host up already
+	if ((network_mode == NetworkMode::HOST) && !net_host.start(network_port))
+	{
+		std::cout << "could not host on port " << network_port << "\n";
+		return false;
+	}
+
+	if ((network_mode == NetworkMode::JOIN) &&
+		!net_client.connect(network_port))
+	{
+		std::cout << "no game hosted on port " << network_port << "\n";
+		return false;
+	}
+
+	if ((network_mode == NetworkMode::BROADCAST) &&
+		!broadcast.start(network_port))
+	{
+		std::cout << "could not broadcast on port " << network_port << "\n";
+		return false;
+	}
+
+	if ((network_mode == NetworkMode::SPECTATE) &&
+		!net_client.connect(network_port))
+	{
+		std::cout << "no game broadcast on port " << network_port << "\n";
+		return false;
+	}
+
+	if ((network_mode == NetworkMode::LOCKSTEP_HOST) &&
+		!lockstep.host(network_port))
+	{
+		std::cout << "could not host on port " << network_port << "\n";
+		return false;
+	}
+
+	if ((network_mode == NetworkMode::LOCKSTEP_JOIN) &&
+		!lockstep.join(network_port))
+	{
+		std::cout << "no game hosted on port " << network_port << "\n";
+		return false;
+	}
+
+	if ((network_mode == NetworkMode::ROLLBACK_HOST) &&
+		!rollback.host(network_port))
+	{
+		std::cout << "could not host on port " << network_port << "\n";
+		return false;
+	}
+
+	if ((network_mode == NetworkMode::ROLLBACK_JOIN) &&
+		!rollback.join(network_port))
+	{
+		std::cout << "no game hosted on port " << network_port << "\n";
+		return false;
+	}
 
 	return true;
 }
 
 
 
+void InvadersGame::setNetwork(NetworkMode mode, uint16_t port)
+{
+	network_mode = mode;
+	network_port = port;
+}
+
+
+
+const bool InvadersGame::isPredicting()
+{
+	return (network_mode == NetworkMode::ROLLBACK_HOST) ||
+		(network_mode == NetworkMode::ROLLBACK_JOIN);
+}
+
+
+
 /**
 *   @brief   The main game loop. 
 *   @details The main loop should be responsible for updating the game
@@ -128,6 +403,15 @@ bool InvadersGame::run()
 		//update tick start
 		auto start = std::chrono::steady_clock::now();
 
+		//keep loading gameplay assets behind the menu
+		if (!load_queue.isDone())
+		{
+			load_queue.process(LOAD_BUDGET);
+		}
+
+		//edited assets are only swapped in between frames
+		applyReloads();
+
 		//menu
 		if (game_state == GameState::MAIN_MENU)
 		{
@@ -164,6 +448,9 @@ bool InvadersGame::run()
 			this->exit = true;
 		}
 
+		//first frame has been shown
+		load_queue.markInteractive();
+
 		//update tick end
 		auto end = std::chrono::steady_clock::now();
 
@@ -224,79 +511,54 @@ void InvadersGame::loadUI()
 {
 	renderer->setFont(GameFont::fonts[0]->id);
 
-	//x position of life sprites
-	int counter = 1060;
-
-	//load life sprites
-	for (int i = 0; i < 3; i++)
-	{
-		lives.push_back(std::make_unique<Player>());
-		lives[i]->loadPlayer(renderer);
-		lives[i]->player->position[0] = counter;
-		lives[i]->player->position[1] = 375;
-
-		counter += 70;
-	}
+	//life sprite, positioned per life on render
+	life = loadSprite(TEXTURE_PLAYER);
 
 	//escape button sprite
-	escape = renderer->createSprite();
-	escape->loadTexture("..\\..\\Resources\\Textures\\computer_key_Esc.png");
-	escape->scale = 0.5;
+	escape = loadSprite(TEXTURE_COMPUTER_KEY_ESC);
 	escape->position[0] = 1200;
 	escape->position[1] = 60;
 
 	//P button sprite
-	letterP = renderer->createSprite();
-	letterP->loadTexture("..\\..\\Resources\\Textures\\computer_key_P.png");
-	letterP->scale = 0.5;
+	letterP = loadSprite(TEXTURE_COMPUTER_KEY_P);
 	letterP->position[0] = 420;
 	letterP->position[1] = 260;
 
 	//space button sprite
-	space = renderer->createSprite();
-	space->scale = 0.5;
+	space = loadSprite(TEXTURE_COMPUTER_KEY_SPACE_BAR);
 	space->position[0] = 420;
 	space->position[1] = 360;
-	space->loadTexture(
-	"..\\..\\Resources\\Textures\\computer_key_space_Bar.png");
 	
 	//A button sprite
-	left = renderer->createSprite();
-	left->loadTexture("..\\..\\Resources\\Textures\\computer_key_A.png");
-	left->scale = 0.5;
+	left = loadSprite(TEXTURE_COMPUTER_KEY_A);
 	left->position[0] = 420;
 	left->position[1] = 460;
 
 	//D button sprite
-	right = renderer->createSprite();
-	right->loadTexture("..\\..\\Resources\\Textures\\computer_key_D.png");
-	right->scale = 0.5;
+	right = loadSprite(TEXTURE_COMPUTER_KEY_D);
 	right->position[0] = 470;
 	right->position[1] = 460;
 
+}
+
+
+
+void InvadersGame::loadMenuUI()
+{
 	//1 button sprite
-	one = renderer->createSprite();
-	one->scale = 0.5;
+	one = loadSprite(TEXTURE_COMPUTER_KEY_NUM_ROW_1);
 	one->position[0] = 310;
 	one->position[1] = 340;
-	one->loadTexture(
-	"..\\..\\Resources\\Textures\\computer_key_num_row_1.png");
 
 	//2 button sprite
-	two = renderer->createSprite();
-	two->scale = 0.5;
+	two = loadSprite(TEXTURE_COMPUTER_KEY_NUM_ROW_2);
 	two->position[0] = 310;
 	two->position[1] = 425;
-	two->loadTexture(
-	"..\\..\\Resources\\Textures\\computer_key_num_row_2.png");
 
 	//3 button sprite
-	three = renderer->createSprite();
-	three->scale = 0.5;
+	three = loadSprite(TEXTURE_COMPUTER_KEY_NUM_ROW_3);
 	three->position[0] = 310;
 	three->position[1] = 505;
-	three->loadTexture(
-	"..\\..\\Resources\\Textures\\computer_key_num_row_3.png");	
 }
 
 
@@ -313,7 +575,9 @@ void InvadersGame::renderUI()
 	//player score
 	renderer->renderText("SCORE: ", 1060, 200, 0.75, ASGE::COLOURS::GREEN);
 
-	std::string playerScore = std::to_string(player_one->getScore());
+	const Pilot& pilot = *world.entities.get<Pilot>(GameWorld::PLAYER);
+
+	std::string playerScore = std::to_string(pilot.score);
 
 	renderer->renderText(
 	playerScore.c_str(), 1155, 200, 0.75, ASGE::COLOURS::WHITE);
@@ -321,7 +585,8 @@ void InvadersGame::renderUI()
 	//player score multiplier
 	renderer->renderText("x", 1060, 250, 0.75, ASGE::COLOURS::GREEN);
 
-	std::string playerMultiplier = std::to_string(player_one->getMultiplier());
+	std::string playerMultiplier =
+	std::to_string(pilot.multiplier);
 
 	renderer->renderText(
 	playerMultiplier.c_str(), 1090, 250, 0.75, ASGE::COLOURS::WHITE);
@@ -330,9 +595,11 @@ void InvadersGame::renderUI()
 	renderer->renderText("LIVES: ", 1060, 350, 0.75, ASGE::COLOURS::GREEN);
 
 	//show life sprites depending on player life
-	for (int i = 0; i < player_one->getHealth(); i++)
+	int health = world.entities.get<Life>(GameWorld::PLAYER)->health;
+
+	for (int i = 0; i < health; i++)
 	{
-		lives[i]->player->render(renderer);
+		renderAt(renderer, *life, { 1060 + i * 70, 375 });
 	}
 
 
@@ -461,6 +728,24 @@ void InvadersGame::input(int key, int action)
 				game_action = GameAction::NONE;
 			}
 		}
+
+		//quick save
+		else if (key == ASGE::KEYS::KEY_S)
+		{
+			if (action == ASGE::KEYS::KEY_PRESSED)
+			{
+				game_action = GameAction::SAVE;
+			}
+		}
+
+		//quick load
+		else if (key == ASGE::KEYS::KEY_L)
+		{
+			if (action == ASGE::KEYS::KEY_PRESSED)
+			{
+				game_action = GameAction::LOAD;
+			}
+		}
 	}
 
 	//return to main menu
@@ -498,7 +783,7 @@ void InvadersGame::input(int key, int action)
 		{
 			if (action == ASGE::KEYS::KEY_PRESSED)
 			{
-				if (player_one->getDeath() == false)
+				if (world.isRespawning() == false)
 				{
 					game_action = GameAction::SHOOT;
 				}
@@ -515,7 +800,7 @@ void InvadersGame::input(int key, int action)
 		{
 			if (action == ASGE::KEYS::KEY_PRESSED)
 			{
-				if (player_one->getDeath() == false)
+				if (world.isRespawning() == false)
 				{
 					game_action = GameAction::LEFT;
 				}
@@ -525,7 +810,7 @@ void InvadersGame::input(int key, int action)
 			{
 				if (game_action == GameAction::LEFT)
 				{
-					if (player_one->getDeath() == false)
+					if (world.isRespawning() == false)
 					{
 						game_action = GameAction::NONE;
 					}
@@ -622,6 +907,9 @@ void InvadersGame::processGameActions()
 	//show controls
 	else if (game_action == GameAction::OPTIONS)
 	{
+		//control screen uses gameplay key sprites
+		load_queue.finish();
+
 		game_state = GameState::OPTIONS;
 	}
 
@@ -634,135 +922,270 @@ void InvadersGame::processGameActions()
 
 			game_state = GameState::PLAYING;
 		}
-	}
 
-	else if (game_state == GameState::PLAYING)
-	{
-		//pause game
-		if (game_action == GameAction::PAUSE)
+		//write the current game to disk
+		else if (game_action == GameAction::SAVE)
 		{
 			game_action = GameAction::NONE;
 
-			game_state = GameState::PAUSE;
-		}
+			GameSnapshot snapshot;
+			world.save(snapshot);
 
-		//move player sprite right
-		if (game_action == GameAction::RIGHT)
-		{
-			if (player_one->getXPosition() < 990)
+			if (!saveSnapshot(QUICK_SAVE_FILE, snapshot))
 			{
-				player_one->movePlayer(400 * time_difference);
+				std::cout << "could not write " << QUICK_SAVE_FILE << "\n";
 			}
 		}
 
-		//move player sprite left
-		else if (game_action == GameAction::LEFT)
+		//resume the saved game, still paused
+		else if (game_action == GameAction::LOAD)
 		{
-			if (player_one->getXPosition() > 10)
+			game_action = GameAction::NONE;
+
+			GameSnapshot snapshot;
+
+			if (!loadSnapshot(QUICK_SAVE_FILE, snapshot) ||
+				!world.restore(snapshot))
+			{
+				std::cout << "no usable save in " << QUICK_SAVE_FILE << "\n";
+			}
+
+			//recording carries on from the loaded game
+			else
 			{
-				player_one->movePlayer(-300 * time_difference);
+				replay.begin(world);
 			}
+
+			particles.clear();
 		}
+	}
 
-		//player shoot
-		if (game_action == GameAction::SHOOT)
+	else if (game_state == GameState::PLAYING)
+	{
+		//pause game
+		if (game_action == GameAction::PAUSE)
 		{
 			game_action = GameAction::NONE;
 
-			if (bullet_one->getAlive() != true)
-			{
-				int x = player_one->getXPosition() + 24;
-				int y = player_one->getYPosition();
+			game_state = GameState::PAUSE;
+		}
 
-				bullet_one->setBullet(x, y);
+	}
+}
 
-				audio_engine->play2D(
-				"..\\..\\Resources\\Audio\\Laser1.wav", false);
-			}
-		}
+
+
+const WorldInput InvadersGame::readPlayerInput()
+{
+	//translate the held action into world input
+	WorldInput world_input;
+
+	//move player right
+	if (game_action == GameAction::RIGHT)
+	{
+		world_input.move = 1;
+	}
+
+	//move player left
+	else if (game_action == GameAction::LEFT)
+	{
+		world_input.move = -1;
+	}
+
+	//player shoot
+	if (game_action == GameAction::SHOOT)
+	{
+		game_action = GameAction::NONE;
+
+		world_input.shoot = true;
 	}
+
+	return world_input;
 }
 
 
 
 void InvadersGame::updateGame()
 {
+	//player input for this tick
+	WorldInput world_input = readPlayerInput();
+
+	//a joined game draws the host's world and only sends input, nothing
+	//is stepped so there are no events, sounds or debris, a spectator
+	//doesn't even send input
+	if ((network_mode == NetworkMode::JOIN) ||
+		(network_mode == NetworkMode::SPECTATE))
+	{
+		bool connected = (network_mode == NetworkMode::SPECTATE) ?
+			net_client.receive() : net_client.update(world_input);
+
+		if (!connected)
+		{
+			std::cout << "lost the host\n";
+			game_state = GameState::GAME_OVER;
+		}
+
+		//a state this world can't take, another formation, is as good
+		//as no host at all, drawing the last one would look frozen
+		else if (net_client.hasState() &&
+			!world.restore(net_client.getState()))
+		{
+			std::cout << "the host's game doesn't match this one\n";
+			game_state = GameState::GAME_OVER;
+		}
+	}
+
+	//both peers step fixed ticks once both inputs for the tick are in,
+	//waiting on the other peer holds the game still
+	else if ((network_mode == NetworkMode::LOCKSTEP_HOST) ||
+		(network_mode == NetworkMode::LOCKSTEP_JOIN))
+	{
+		updateLockstep(world_input);
+	}
+
+	//both peers step on guesses of the other's input and go back to
+	//correct them, the corrected ticks play no sounds or debris
+	else if (isPredicting())
+	{
+		updateRollback(world_input);
+	}
+
+	//advance aliens, bullets, mothership and collisions then move and
+	//shoot, sounds and explosions are started by the event handlers
+	else
+	{
+		if (network_mode == NetworkMode::HOST)
+		{
+			world_input = net_host.mergeInput(world_input);
+		}
+
+		world.step(time_difference, world_input);
+		replay.record(time_difference, world_input);
+
+		if (network_mode == NetworkMode::HOST)
+		{
+			net_host.update(world);
+		}
+
+		else if (network_mode == NetworkMode::BROADCAST)
+		{
+			broadcast.update(world);
+		}
+	}
+
+	//move debris from this and earlier explosions
+	particles.update(time_difference, &jobs);
+
 	beginFrame();
 	renderer->setFont(GameFont::fonts[0]->id);	
-
-	//check if player is currently respawning
-	deathDelay();
+	buildRenderList();
 
 	//check if player is dead
 	checkPlayerAlive();
 
+	//keep the finished game, it can be added to the PGO training corpus
+	if ((game_state == GameState::GAME_OVER) && replay.isRecording())
+	{
+		replay.finish(world);
+
+		if (!replay.save(REPLAY_FILE))
+		{
+			std::cout << "could not write " << REPLAY_FILE << "\n";
+		}
+	}
+
 	//render GUI
 	renderUI();
 
-	//check what sprite each barrier should be showing
-	changeBarriers();
-
 	//render barrier sprites
 	renderBarriers();
 
-	//render player bullet
-	bullet_one->bullet->render(renderer);
-
 	//render alien sprites
 	renderAliens();
 
-	//move alien sprites
-	moveAliens();
-
 	//render mothership sprite
 	renderMothership();
 
-	//spawn and move mothership
-	deployMothership();
+	//render explosion debris
+	renderParticles();
+
+	//render player and enemy bullets
+	renderBullets();
+
+	processGameActions();
+	endFrame();
+}
 
-	//change speed of aliens
-	changeAlienSpeed();
 
-	//move player bullet
-	bullet_one->moveBullet(-800 * time_difference);
 
-	//if player bullet missed then reset multipler
-	if (bullet_one->getMissed() == true)
+void InvadersGame::updateLockstep(const WorldInput& world_input)
+{
+	//the game is recorded from the state both peers start in
+	bool was_started = lockstep.isStarted();
+	lockstep.poll(world);
+
+	if (!was_started && lockstep.isStarted())
 	{
-		player_one->setMultiplier(1);
-		bullet_one->setMissed(false);
+		replay.begin(world);
 	}
 
-	//alien shooting
-	enemyShoot();
+	lockstep.setInput(world_input);
 
-	//aliens being shot
-	checkCollision();
+	//a stall doesn't bank time to catch up with in one go
+	lockstep_time = std::min(lockstep_time + time_difference,
+		SIM_TIME_STEP * LOCKSTEP_DELAY);
 
-	//check if all aliens are dead
-	checkAlienLives();
+	WorldInput merged;
 
-	//check if player has been shot
-	checkPlayerCollision();
+	while ((lockstep_time >= SIM_TIME_STEP) && lockstep.nextInput(merged))
+	{
+		world.step(SIM_TIME_STEP, merged);
+		replay.record(SIM_TIME_STEP, merged);
+		lockstep.endTick(world);
 
-	//check if barriers have been shot
-	checkBarrierCollision();
+		lockstep_time -= SIM_TIME_STEP;
+	}
 
-	//check if mothership has been shot
-	checkMothershipCollision();
+	if (lockstep.isDesynced())
+	{
+		std::cout << "desync, state written to " <<
+			lockstep.getDumpPath() << "\n";
+		game_state = GameState::GAME_OVER;
+	}
 
-	//render explosion
-	explosion->render(renderer);
+	else if (lockstep.isStarted() && !lockstep.isConnected())
+	{
+		std::cout << "lost the other player\n";
+		game_state = GameState::GAME_OVER;
+	}
+}
 
-	//hide explosion
-	explosion->position[0] = -30;
-	explosion->position[1] = -30;	
 
-	//render enemy bullets
-	renderBullets();
 
-	processGameActions();
-	endFrame();
+void InvadersGame::updateRollback(const WorldInput& world_input)
+{
+	rollback.poll(world);
+	rollback.setInput(world_input);
+
+	//a wait at the window doesn't bank time to catch up with in one go
+	lockstep_time = std::min(lockstep_time + time_difference,
+		SIM_TIME_STEP * ROLLBACK_WINDOW);
+
+	int ticks = (int)(lockstep_time / SIM_TIME_STEP);
+	lockstep_time -= SIM_TIME_STEP * rollback.update(world, ticks);
+
+	if (rollback.isDesynced())
+	{
+		std::cout << "desync, state written to " <<
+			rollback.getDumpPath() << "\n";
+		game_state = GameState::GAME_OVER;
+	}
+
+	else if (rollback.isStarted() && !rollback.isConnected())
+	{
+		std::cout << "lost the other player\n";
+		game_state = GameState::GAME_OVER;
+	}
 }
 
 
@@ -804,6 +1227,7 @@ const void InvadersGame::updatePause()
 	//pause screen
 	beginFrame();
 	renderer->setFont(GameFont::fonts[0]->id);
+	buildRenderList();
 
 	renderUI();
 
@@ -811,8 +1235,7 @@ const void InvadersGame::updatePause()
 
 	checkPlayerAlive();
 
-	bullet_one->bullet->render(renderer);
-	explosion->render(renderer);
+	renderParticles();
 
 	renderAliens();
 
@@ -822,6 +1245,9 @@ const void InvadersGame::updatePause()
 
 	renderer->renderText("PAUSED", 500, 325, 2, ASGE::COLOURS::WHITE);
 
+	renderer->renderText(
+	"S  SAVE     L  LOAD", 480, 400, 0.75, ASGE::COLOURS::GREEN);
+
 	processGameActions();
 	endFrame();
 }
@@ -833,6 +1259,7 @@ const void InvadersGame::updateGameOver()
 	//game over screen
 	beginFrame();
 	renderer->setFont(GameFont::fonts[0]->id);
+	buildRenderList();
 
 	renderUI();
 
@@ -840,8 +1267,7 @@ const void InvadersGame::updateGameOver()
 
 	checkPlayerAlive();
 
-	bullet_one->bullet->render(renderer);
-	explosion->render(renderer);
+	renderParticles();
 
 	renderAliens();
 
@@ -857,641 +1283,339 @@ const void InvadersGame::updateGameOver()
 
 
 
-void InvadersGame::loadEnemies()
+std::unique_ptr<ASGE::Sprite> InvadersGame::loadSprite(Asset texture)
 {
-	//spawn coords
-	int pos_x = 300;
-	int pos_y = 100;
-	int counter = 0;
-
-	//for each 55 aliens (5x11)
-	for (int i = 0; i < 5; i++)
-	{
-		for (int j = 0; j < 11; j++)
-		{
-			//add to vector and set position
-			aliens.push_back(std::make_unique<Enemy>());
-			aliens[counter]->loadEnemy(renderer);
-			aliens[counter]->enemy->position[0] = pos_x;
-			aliens[counter]->enemy->position[1] = pos_y;
-			aliens[counter]->setDirection(10);
-
-			//if top 2 rows then different sprite texture and size
-			if (counter < 22)
-			{
-				aliens[counter]->enemy->loadTexture(
-				"..\\..\\Resources\\Textures\\Alien2.png");
+	//position is set on render
+	std::unique_ptr<ASGE::Sprite> sprite = renderer->createSprite();
+	sprite->loadTexture(getAssetPath(texture));
+	fitScale(*sprite, texture);
 
-				aliens[counter]->enemy->scale = 0.12f;
-				aliens[counter]->enemy->position[0] += 3;
-			}
-
-			//if spawning on bottom row then automatically can shoot
-			if (counter > 43)
-			{
-				aliens[counter]->setCanShoot(true);
-			}
-
-			counter++;
-			pos_x += 50;
-		}
-		pos_x = 300;
-		pos_y += 40;
-	}
+	return sprite;
 }
 
 
 
-void InvadersGame::loadBarriers()
+void InvadersGame::loadAliens()
 {
-	int pos_x = 200;
-
-	for (int i = 0; i < 3; i++)
-	{
-		//add to vector and set position of each barrier
-		barriers.push_back(std::make_unique<Barrier>());
-		barriers[i]->loadBarrier(renderer);
-		barriers[i]->barrier->position[0] = pos_x;
-		barriers[i]->barrier->position[1] = 600;
-
-		pos_x += 300;
-	}
+	//large alien rows have a different sprite texture and size
+	aliens[0] = loadSprite(TEXTURE_ALIEN1);
+	aliens[1] = loadSprite(TEXTURE_ALIEN2);
 }
 
 
 
 void InvadersGame::resetGame()
 {
-	//reset game actors for new game
-	resetEnemies();
-
-	resetBarriers();
-
-	//reset movement speed
-	alien_move_speed = 1.2;
-
-	//spawn at specified y coord
-	for (int i = 0; i < aliens.size(); i++)
-	{
-		aliens[i]->setStartY(100);
-	}
+	//make sure everything has finished loading
+	load_queue.finish();
 
-	//reset player
-	player_one->setAlive(true);
-	player_one->setHealth(3);
-	player_one->setScore(0);
-	player_one->player->position[0] = 500;
+	//reset game actors for new game
+	world.reset();
+	particles.clear();
 
-	for (int i = 0; i < 5; i++)
+	//record the new game from its first tick, a joined or watched game is
+	//the host's and a rollback game's world is partly guesswork
+	if ((network_mode != NetworkMode::JOIN) &&
+		(network_mode != NetworkMode::SPECTATE) && !isPredicting())
 	{
-		bullets[i]->setAlive(false);
+		replay.begin(world);
 	}
-
-	bullet_one->setAlive(false);
 }
 
 
 
-void InvadersGame::resetEnemies()
+/**
+*   @brief   Sets up the filesystem the game loads from.
+*   @details Every asset in the registry is interned once here, in
+*            order, so an Asset is the id of its own name and loads and
+*            sounds are looked up by index. The resource pack is mapped now rather
+*            than with the audio so that mounting it can't race lookups
+*            from the background loads.
+*   @return  void
+*/
+void InvadersGame::mountResources()
 {
-	//respawn enemies
-	int pos_x = 300;
-	int counter = 0;
-
-	//this determines how far down they start spawning
-	int pos_y = aliens[0]->getStartY();
-
-	for (int i = 0; i < 5; i++)
+	//searched last mounted first
+	for (int i = (int)std::size(RESOURCE_DIRECTORIES) - 1; i >= 0; i--)
 	{
-		for (int j = 0; j < 11; j++)
-		{
-			aliens[counter]->setAlive(true);
-			aliens[counter]->enemy->position[0] = pos_x;
-			aliens[counter]->enemy->position[1] = pos_y;
-			aliens[counter]->setDirection(10);
-			aliens[counter]->setCanShoot(false);
+		files.mount(std::make_unique<DirectoryMount>(RESOURCE_DIRECTORIES[i]));
+	}
 
-			if (counter < 22)
-			{
-				aliens[counter]->enemy->position[0] += 3;
-			}
+	//imports shadow the full size textures, they are optional too
+	for (int i = (int)std::size(IMPORTED_DIRECTORIES) - 1; i >= 0; i--)
+	{
+		files.mount(std::make_unique<DirectoryMount>(IMPORTED_DIRECTORIES[i]));
+	}
 
-			if (counter > 43)
-			{
-				aliens[counter]->setCanShoot(true);
-			}
+	//nothing has been interned yet so ids come out in registry order
+	for (int i = 0; i < ASSET_COUNT; i++)
+	{
+		AssetId id = files.intern(ASSET_INFO[i].name);
 
-			counter++;
-			pos_x += 50;
+		//the pack is optional, the loose files work without it
+		if (!files.exists(id) && (i != DATA_RESOURCES))
+		{
+			std::cout << "missing asset " << ASSET_INFO[i].name << "\n";
 		}
-		pos_x = 300;
-		pos_y += 40;
+	}
+
+	//packed files shadow the loose ones they were built from
+	if (asset_pack.open(getAssetPath(DATA_RESOURCES)))
+	{
+		files.mount(std::make_unique<PackMount>(asset_pack));
 	}
 }
 
 
 
-const void InvadersGame::resetBarriers()
+const char* InvadersGame::getAssetPath(Asset asset)
 {
-	//reset barriers for new game
-	for (int i = 0; i < barriers.size(); i++)
-	{
-		barriers[i]->resetBarrier();
-	}
+	return files.getPath(asset);
 }
 
 
 
-const void InvadersGame::changeBarriers()
+void InvadersGame::applyReloads()
 {
-	//change barrier sprites
-	for (int i = 0; i < 3; i++)
+	std::vector<AssetReload> ready;
+
+	if (!hot_reload.collect(ready))
 	{
-		barriers[i]->changeBarrier();
+		return;
 	}
-}
 
+	for (AssetReload& reload : ready)
+	{
+		std::cout << "reloading " << reload.path << "\n";
 
+		AssetFormat format = ASSET_INFO[reload.asset].format;
 
-const void InvadersGame::renderAliens()
-{
-	//render alien sprites if alive
-	for (int i = 0; i < aliens.size(); i++)
-	{
-		if (aliens[i]->getAlive() == true)
+		if ((format == AssetFormat::PNG) || (format == AssetFormat::JPEG))
+		{
+			reloadTexture(reload.asset, reload.path.c_str());
+		}
+
+		else if (format == AssetFormat::WAV)
+		{
+			reloadSound(reload);
+		}
+
+		else if ((reload.asset == DATA_CONFIG_WAVES) ||
+			(reload.asset == DATA_WAVES))
 		{
-			aliens[i]->enemy->render(renderer);
+			reloadWaves(reload.waves);
 		}
 	}
 }
 
 
 
-const void InvadersGame::renderBarriers()
+void InvadersGame::reloadTexture(Asset texture, const char* path)
 {
-	//render barrier sprites if alive
-	for (int i = 0; i < barriers.size(); i++)
+	//sprites not created yet will load the new file when they are
+	auto reload = [texture, path](std::unique_ptr<ASGE::Sprite>& sprite)
 	{
-		if (barriers[i]->getAlive() == true)
+		if (sprite)
 		{
-			barriers[i]->barrier->render(renderer);
+			sprite->loadTexture(path);
+			fitScale(*sprite, texture);
 		}
-	}
-}
+	};
 
+	switch (texture)
+	{
+	case TEXTURE_ALIEN1:
+		reload(aliens[0]);
+		break;
 
+	case TEXTURE_ALIEN2:
+		reload(aliens[1]);
+		break;
 
-void InvadersGame::moveAliens()
-{
-	//move enemy alien sprites
+	case TEXTURE_BARRIER_PIXEL:
+		reload(barrier_pixel);
+		break;
 
-	//change direction boolean
-	bool change = false;
+	case TEXTURE_BULLET:
+		reload(bullet);
+		break;
 
-	//movement tick
-	alien_move_counter += time_difference;
+	case TEXTURE_PLAYER:
+		reload(player);
+		reload(life);
+		break;
 
-	//if movement tick reaches threshold
-	if (alien_move_counter >= 0.4)
-	{
-		for (int c = 0; c < aliens.size(); c++)
-		{
-			//if each alien is alive and is out of bounds then change direction
-			if (aliens[c]->getAlive() == true)
-			{
-				if ((aliens[c]->getXPosition() < 30) || 
-					(aliens[c]->getXPosition() > 970))
-				{
-					change = true;
-				}
-			}
-		}
+	case TEXTURE_SPACESHIP:
+		reload(mothership);
+		break;
 
-		if (change)
-		{
-			//if changing direction 
-			for (int i = 0; i < aliens.size(); i++)
-			{
+	case TEXTURE_EXPLOSION:
+		reload(debris);
+		break;
 
-				//if aliens are below certain threshold then game ends
-				if (aliens[i]->getYPosition() > 620)
-				{
-					if (aliens[i]->getAlive() == true)
-					{
-						player_one->setAlive(false);
-					}
-				}
+	case TEXTURE_INVADER:
+		reload(invader);
+		break;
 
-				//move alien sprite
-				aliens[i]->enemy->position[1] += 30;
+	case TEXTURE_COMPUTER_KEY_A:
+		reload(left);
+		break;
 
-				//if alien is alive and over either 
-				//threshold then bring back into bounds
-				if (aliens[i]->getAlive() == true)
-				{
-					if (aliens[i]->getXPosition() < 30)
-					{
-						for (int c = 0; c < aliens.size(); c++)
-						{
-							aliens[c]->enemy->position[0] += 10;
-						}
-					}
+	case TEXTURE_COMPUTER_KEY_D:
+		reload(right);
+		break;
 
-					else if (aliens[i]->getXPosition() > 970)
-					{
-						for (int c = 0; c < aliens.size(); c++)
-						{
-							aliens[c]->enemy->position[0] -= 10;
-						}
-					}
-				}
+	case TEXTURE_COMPUTER_KEY_ESC:
+		reload(escape);
+		break;
 
-				//reset enemy alien movement direction to other way
-				aliens[i]->setDirection(aliens[i]->getDirection() * -1);
-			}
-		}
-			
-		else
-		{
-			//if not changing direction then move as normal per tick
-			for (int j = 0; j < aliens.size(); j++)
-			{
-				aliens[j]->enemy->position[0] += aliens[j]->getDirection();
-			}
-		}
+	case TEXTURE_COMPUTER_KEY_P:
+		reload(letterP);
+		break;
+
+	case TEXTURE_COMPUTER_KEY_SPACE_BAR:
+		reload(space);
+		break;
+
+	case TEXTURE_COMPUTER_KEY_NUM_ROW_1:
+		reload(one);
+		break;
 
-		//reset tick counter
-		alien_move_counter = 0;
+	case TEXTURE_COMPUTER_KEY_NUM_ROW_2:
+		reload(two);
+		break;
+
+	case TEXTURE_COMPUTER_KEY_NUM_ROW_3:
+		reload(three);
+		break;
+
+	default:
+		break;
 	}
 }
 
 
 
-void InvadersGame::changeAlienSpeed()
+void InvadersGame::reloadSound(AssetReload& reload)
 {
-	//increase enemy alien speed and shooting freuqency depending on height
-	if ((aliens[0]->enemy->position[1] < 370) && 
-		(aliens[0]->enemy->position[1] >= 190))
-	{
-		alien_move_speed = 0.8;
-		alien_shoot_speed = 15000;
-	}
+	using namespace irrklang;
 
-	else if ((aliens[0]->enemy->position[1] < 430) && 
-		(aliens[0]->enemy->position[1] >= 370))
+	if (!audio_ready)
 	{
-		alien_move_speed = 0.4;
-		alien_shoot_speed = 10000;
+		return;
 	}
 
-	else if (aliens[0]->enemy->position[1] >= 430)
+	//a fresh name each time, irrKlang keeps its own copy of the bytes
+	std::string name = std::string(ASSET_INFO[reload.asset].name) + "#" +
+		std::to_string(++sound_generation);
+
+	ISoundSource* source = audio_engine->addSoundSourceFromMemory(
+	reload.data.data(), (ik_s32)reload.data.size(), name.c_str(), true);
+
+	if (!source)
 	{
-		alien_move_speed = 0.1;
-		alien_shoot_speed = 5000;
+		return;
 	}
-}
 
+	//the old source stops any copies of itself still playing
+	ISoundSource* old = sounds[reload.asset];
+	sounds[reload.asset] = source;
 
-
-void InvadersGame::checkCollision()
-{
-	if (bullet_one->getAlive() == true)
+	if (old)
 	{
-		for (int i = 0; i < aliens.size(); i++)
-		{
-			if (aliens[i]->getAlive() == true)
-			{
-				//if player bullet is live and each enemy alien is alive
-				//if player bullet sprite crosses over 
-				//screen space with alien sprite
-				if ((aliens[i]->getXPosition() + 35) >= 
-					bullet_one->getXPosition())
-				{
-					if (aliens[i]->getXPosition() <= 
-						(bullet_one->getXPosition() + 5))
-					{
-						if ((aliens[i]->getYPosition() + 20) >= 
-							bullet_one->getYPosition())
-						{
-							if (aliens[i]->getYPosition() <= 
-								(bullet_one->getYPosition() + 5))
-							{
-								//show explosion, kill alien and bullet
-								spawnExplosion(aliens[i]->getXPosition(), 
-								aliens[i]->getYPosition());
-
-								aliens[i]->setAlive(false);
-
-								audio_engine->play2D(
-								"..\\..\\Resources\\Audio\\
-								Explosion2.wav", false);
-
-								bullet_one->setAlive(false);
-
-								//increase player score depending on alien
-								int score_addition = 0;
-
-								if (i < 22)
-								{
-									score_addition = 30;
-								}
-
-								else
-								{
-									score_addition = 10;
-								}
-
-								//multiple score by multiplier
-								player_one->setScore(player_one->getScore() 
-								+ (player_one->getMultiplier() * 
-								score_addition));
-
-								player_one->setMultiplier
-								(player_one->getMultiplier() + 1);
-							}
-						}
-					}
-				}
-			}
-		}
+		audio_engine->removeSoundSource(old);
 	}
 }
 
 
 
-const void InvadersGame::checkAlienLives()
+void InvadersGame::reloadWaves(const WaveTable& waves)
 {
-	//checking if all aliens are dead
-	for (int i = 0; i < aliens.size(); i++)
-	{
-		if (aliens[i]->getAlive() == true)
-		{
-			return;
-		}
-	}
-		
-	//if wave cleared then give back a lost life
-	if (player_one->getHealth() < 3)
+	//every network mode shares one formation between games, a change on
+	//one side would desync lockstep and rollback peers, drop the states
+	//rollback goes back to, and leave clients and spectators unable to
+	//restore the states they're sent
+	if (network_mode != NetworkMode::NONE)
 	{
-		player_one->setHealth(player_one->getHealth() + 1);
+		std::cout << "waves not reloaded during a network game\n";
+		return;
 	}
 
-	//spawn enemies lower each round
-	if (aliens[0]->getStartY() < 450)
+	//the game in progress restarts with the new formation
+	world.setWaves(waves);
+
+	if ((game_state == GameState::PLAYING) ||
+		(game_state == GameState::PAUSE))
 	{
-		for (int i = 0; i < aliens.size(); i++)
-		{
-			aliens[i]->setStartY(aliens[i]->getStartY() + 50);
-		}
+		resetGame();
 	}
-
-	resetEnemies();
 }
 
 
 
-void InvadersGame::spawnExplosion(int x, int y)
+const void InvadersGame::renderAliens()
 {
-	//spawn explosion sprite at given location
-	explosion->position[0] = x;
-	explosion->position[1] = y;
+	//render living, on screen alien sprites, each row has its own look
+	renderLook(renderer, *aliens[0], render_list, LOOK_ALIEN);
+	renderLook(renderer, *aliens[1], render_list, LOOK_ALIEN_LARGE);
 }
 
 
 
-const void InvadersGame::loadBullets()
+const void InvadersGame::renderBarriers()
 {
-	//load enemy bullet sprites
-	for (int i = 0; i < 5; i++)
-	{
-		bullets.push_back(std::make_unique<Bullet>());
-		bullets[i]->loadBullet(renderer);
-	}
-}
+	int count = world.entities.getCount(GameWorld::BARRIERS);
+	const Position* position = world.entities.get<Position>(GameWorld::BARRIERS);
+	Barrier* barrier = world.entities.get<Barrier>(GameWorld::BARRIERS);
 
-
-
-const void InvadersGame::renderBullets()
-{
-	//render enemy bullet spites
-	for (int i = 0; i < bullets.size(); i++)
+	//render barrier pixels if any are left
+	for (int i = 0; i < count; i++)
 	{
-		bullets[i]->bullet->render(renderer);
-
-		//move bullets
-		if (game_state == GameState::PLAYING)
+		if (barrier[i].getAlive() == true)
 		{
-			bullets[i]->moveBullet(650 * time_difference);
+			barrier[i].render(renderer, *barrier_pixel, position[i].x,
+				position[i].y);
 		}
 	}
 }
 
 
 
-void InvadersGame::enemyShoot()
+const void InvadersGame::renderBullets()
 {
-	//determine when enemies shoot
-	for (int i = 0; i < aliens.size(); i++)
-	{
-		//if not bottom row & the alien below is dead but could shoot
-		//then this alien can now shoot
-		if (i < 43)
-		{
-			if ((aliens[i + 11]->getCanShoot() == true) && 
-				(aliens[i + 11]->getAlive() == false))
-			{
-				aliens[i]->setCanShoot(true);
-			}
-		}
-
-		if (aliens[i]->getCanShoot() == true)
-		{
-			for (int j = 0; j < bullets.size(); j++)
-			{
-				//for each bullet random chance to fire if not already
-				std::random_device rd;
-				std::mt19937 rng(rd());
-				std::uniform_int_distribution<int> uni(0, alien_shoot_speed);
-
-				auto randomNum = uni(rng);
+	//player's and aliens' bullets alike, dead ones are never listed
+	renderLook(renderer, *bullet, render_list, LOOK_BULLET);
+}
 
-				if (randomNum == 1)
-				{
-					if (bullets[j]->getAlive() == false)
-					{
-						if (aliens[i]->getAlive() == true)
-						{
-							//spawn bullet below selected alien 
-							int x = aliens[i]->getXPosition() + 15;
-							int y = aliens[i]->getYPosition() + 5;
 
-							bullets[j]->setBullet(x, y);
 
-							audio_engine->play2D(
-							"..\\..\\Resources\\Audio\\Laser2.wav", false);
-						}
-					}
-				}
-			}
-		}
-	}
+void InvadersGame::spawnExplosion(int x, int y, int size)
+{
+	//throw debris out from the given location
+	particles.spawnBurst((float)x, (float)y, size, 4.0f * size, 0.6f);
 }
 
 
 
-void InvadersGame::checkPlayerCollision()
+const void InvadersGame::renderParticles()
 {
-	//check if any live alien bullet sprites overlap with player sprite
-	for (int i = 0; i < bullets.size(); i++)
-	{
-		if (bullets[i]->getAlive() == true)
-		{
-			if ((player_one->getXPosition() + 50) >= 
-				bullets[i]->getXPosition())
-			{
-				if (player_one->getXPosition() <= 
-					(bullets[i]->getXPosition() + 5))
-				{
-					if ((player_one->getYPosition() + 20) >= 
-						bullets[i]->getYPosition())
-					{
-						if (player_one->getYPosition() <= 
-							(bullets[i]->getYPosition() + 5))
-						{
-							//if hit
-							//kill bullet, spawn explosion
-							bullets[i]->setAlive(false);
-
-							spawnExplosion(player_one->getXPosition(), 
-							player_one->getYPosition());
-
-							//take life off of player and create respawn delay
-							int hlth = player_one->getHealth();
-							player_one->setDeath(true);
-							player_one->setHealth(hlth - 1);
-							player_one->setMultiplier(1);
-
-							audio_engine->play2D(
-							"..\\..\\Resources\\Audio\\Explosion1.wav", 
-							false);
-
-							//reset player position
-							player_one->player->position[0] = 500;
-
-							//if no more lives then player is dead
-							if (player_one->getHealth() == 0)
-							{
-								player_one->setAlive(false);
-							}
-						}
-					}
-				}
-			}
-		}
-	}
+	//one sprite drawn at every on screen particle
+	renderLook(renderer, *debris, render_list, LOOK_DEBRIS);
 }
 
 
 
-void InvadersGame::checkBarrierCollision()
+void InvadersGame::buildRenderList()
 {
-	//check if any live barrier sprites overlap 
-	//with any live enemy bullet sprites
-	for (int j = 0; j < barriers.size(); j++)
-	{
-		if (barriers[j]->getAlive() == true)
-		{
-			for (int i = 0; i < bullets.size(); i++)
-			{
-				if (bullets[i]->getAlive() == true)
-				{
-					if ((barriers[j]->getXPosition() + 80) >= 
-						bullets[i]->getXPosition())
-					{
-						if (barriers[j]->getXPosition() <= 
-							(bullets[i]->getXPosition() + 5))
-						{
-							if ((barriers[j]->getYPosition() + 50) >= 
-								bullets[i]->getYPosition())
-							{
-								if (barriers[j]->getYPosition() <= 
-									(bullets[i]->getYPosition() + 5))
-								{
-									//kill bullet
-									bullets[i]->setAlive(false);
-
-									//spawn explosion
-									spawnExplosion(barriers[j]->getXPosition(),
-									barriers[j]->getYPosition());
-
-									//take health from barrier
-									int hlth = barriers[j]->getHealth();
-									barriers[j]->setHealth
-									(barriers[j]->getHealth() - 1);
-
-									audio_engine->play2D(
-									"..\\..\\Resources\\Audio\\
-									Explosion2.wav", false);
-
-									//if no barrier lives 
-									//left then kill barrier
-									if (barriers[j]->getHealth() == 0)
-									{
-										barriers[j]->setAlive(false);
-									}
-								}
-							}
-						}
-					}
-				}
-			}
-
-			//check if player bullet sprite overlaps with any live barriers
-			if (bullet_one->getAlive() == true)
-			{
-				if ((barriers[j]->getXPosition() + 80) >= 
-					bullet_one->getXPosition())
-				{
-					if (barriers[j]->getXPosition() <= 
-						(bullet_one->getXPosition() + 5))
-					{
-						if ((barriers[j]->getYPosition() + 50) >= 
-							bullet_one->getYPosition())
-						{
-							if (barriers[j]->getYPosition() <= 
-								(bullet_one->getYPosition() + 5))
-							{
-								//kill player bullet, spawn explosion
-								bullet_one->setAlive(false);
-
-								spawnExplosion(barriers[j]->
-								getXPosition(), 
-								barriers[j]->getYPosition());
-
-								//take health from barrier
-								int hlth = barriers[j]->getHealth();
-								barriers[j]->setHealth
-								(barriers[j]->getHealth() - 1);
-
-								audio_engine->play2D(
-								"..\\..\\Resources\\Audio\\Explosion2.wav",
-								false);
-
-								//reset player multiplier for missing enemies
-								player_one->setMultiplier(1);
-
-								//if barrier is out of lives then kill
-								if (barriers[j]->getHealth() == 0)
-								{
-									barriers[j]->setAlive(false);
-								}
-							}
-						}
-					}
-				}
-			}
-		}
-	}
+	//sizes are read every frame, a reloaded texture may change them
+	setExtent(render_list, LOOK_ALIEN, *aliens[0]);
+	setExtent(render_list, LOOK_ALIEN_LARGE, *aliens[1]);
+	setExtent(render_list, LOOK_MOTHERSHIP, *mothership);
+	setExtent(render_list, LOOK_DEBRIS, *debris);
+	setExtent(render_list, LOOK_BULLET, *bullet);
+	setExtent(render_list, LOOK_PLAYER, *player);
+
+	render_list.build(world, particles);
 }
 
 
@@ -1499,19 +1623,16 @@ void InvadersGame::checkBarrierCollision()
 const void InvadersGame::checkPlayerAlive()
 {
 	//check if player is still alive
-	//otherwise end game
-	if (player_one->getAlive() == false)
+	//otherwise end game, in rollback play only once no guess is involved
+	if (isPredicting() ? rollback.isGameOver() : world.isGameOver())
 	{
 		game_state = GameState::GAME_OVER;
 	}
 
-	//only render play if not in respawn delay
+	//only listed if not in respawn delay
 	else
 	{
-		if (player_one->getDeath() == false)
-		{
-			player_one->player->render(renderer);
-		}
+		renderLook(renderer, *player, render_list, LOOK_PLAYER);
 	}
 }
 
@@ -1552,148 +1673,140 @@ const void InvadersGame::renderMenuUI()
 
 
 
-void InvadersGame::deathDelay()
+const void InvadersGame::renderMothership()
 {
-	//if player is hit then delay respawn
-	if (player_one->getDeath() == true)
-	{
-		death_counter += time_difference;
-
-		if (death_counter >= 1)
-		{
-			player_one->setDeath(false);
-
-			death_counter = 0;
-		}
-	}
+	//render mothership sprite if alive and on screen
+	renderLook(renderer, *mothership, render_list, LOOK_MOTHERSHIP);
 }
 
 
 
-const void InvadersGame::renderMothership()
+const bool InvadersGame::initAudio()
 {
-	//render mothership sprite
-	if (mothership_one->getAlive() == true)
+	//initialise irrKland audio engine
+	using namespace irrklang;
+	audio_engine.reset(createIrrKlangDevice());
+
+	if (!audio_engine)
 	{
-		mothership_one->mothership->render(renderer);
+		return false; // error starting up the engine
 	}
-}
-
 
-
-void InvadersGame::deployMothership()
-{
-	//if mothership not already going
-	//spawn when time counter reaches threshold
-	if (mothership_one->getAlive() == false)
+	//play straight out of the mapped archive when it has been built
+	if (asset_pack.isOpen())
 	{
-		mothership_spawn_timer += time_difference;
+		asset_pack.registerSounds(audio_engine.get());
+	}
 
-		if (mothership_spawn_timer >= 30)
+	//otherwise load whatever the filesystem found under the same names
+	for (int i = 0; i < ASSET_COUNT; i++)
+	{
+		if (ASSET_INFO[i].format != AssetFormat::WAV)
 		{
-			mothership_one->setAlive(true);
-			mothership_one->mothership->position[0] = -10;
-			mothership_spawn_timer = 0;
+			continue;
 		}
-	}
 
-	//if mothership alive then move across until out of bounds then kill
-	else if (mothership_one->getAlive() == true)
-	{
-		if (mothership_one->getXPosition() > 990)
+		const char* name = ASSET_INFO[i].name;
+		ISoundSource* source = audio_engine->getSoundSource(name, false);
+		size_t size = 0;
+		const void* data = files.getData(i, size);
+
+		//memory mounts outlive the engine, irrKlang can borrow the bytes
+		if (!source && data)
 		{
-			mothership_one->setAlive(false);
-			return;
+			source = audio_engine->addSoundSourceFromMemory(
+			const_cast<void*>(data), (ik_s32)size, name, false);
 		}
 
-		mothership_one->mothership->position[0] += (300 * time_difference);
+		else if (!source && files.exists(i))
+		{
+			source = audio_engine->addSoundSourceFromFile(
+			files.getPath(i), ESM_AUTO_DETECT, true);
+		}
 
-		//play alarm sound
-		playAlarm();
+		//played by pointer, irrKlang never looks the name up again
+		sounds[i] = source;
 	}
+
+	audio_ready = true;
+
+	return true;
 }
 
 
 
-void InvadersGame::checkMothershipCollision()
+void InvadersGame::playSound(Asset sound)
 {
-	//check if live mothership sprite overlaps with live player bullet sprite
-	if (bullet_one->getAlive() == true)
+	//audio may still be starting up
+	if (audio_ready && sounds[sound])
 	{
-		for (int i = 0; i < aliens.size(); i++)
-		{
-			if (mothership_one->getAlive() == true)
-			{
-				if ((mothership_one->getXPosition() + 45) >= 
-					bullet_one->getXPosition())
-				{
-					if (mothership_one->getXPosition() <= 
-						(bullet_one->getXPosition() + 5))
-					{
-						if ((mothership_one->getYPosition() + 20) >= 
-							bullet_one->getYPosition())
-						{
-							if (mothership_one->getYPosition() <=								
-								(bullet_one->getYPosition() + 5))
-							{
-								//spawn explosion
-								spawnExplosion(mothership_one->getXPosition(), 
-								mothership_one->getYPosition());
-
-								//kill mothersip and bullet
-								mothership_one->setAlive(false);
-
-								audio_engine->play2D(
-								"..\\..\\Resources\\Audio\\
-								Explosion2.wav", false);
-
-								bullet_one->setAlive(false);
-
-								//add score to player
-								int score_addition = 200;
-
-								player_one->setScore(player_one->getScore()
-								+ (player_one->getMultiplier() * 
-								score_addition));
-
-								player_one->setMultiplier
-								(player_one->getMultiplier() + 1);
-							}
-						}
-					}
-				}
-			}
-		}
+		audio_engine->play2D(sounds[sound], false);
 	}
 }
 
 
 
-const bool InvadersGame::initAudio()
+void InvadersGame::subscribeEvents()
 {
-	//initialise irrKland audio engine
-	using namespace irrklang;
-	audio_engine.reset(createIrrKlangDevice());
+	//anything blowing up throws debris and plays its sound, bigger
+	//targets get bigger explosions
+	world.events.subscribeEffect(GameEventType::ALIEN_KILLED,
+		[](void* game, const GameEvent* batch, int count)
+	{
+		static_cast<InvadersGame*>(game)->explode(batch, count,
+			DEBRIS_ALIEN, SOUND_EXPLOSION2);
+	}, this);
 
-	if (!audio_engine)
+	world.events.subscribeEffect(GameEventType::BARRIER_HIT,
+		[](void* game, const GameEvent* batch, int count)
 	{
-		return false; // error starting up the engine
-	}
-	return true;
+		static_cast<InvadersGame*>(game)->explode(batch, count,
+			DEBRIS_BARRIER, SOUND_EXPLOSION2);
+	}, this);
+
+	world.events.subscribeEffect(GameEventType::MOTHERSHIP_KILLED,
+		[](void* game, const GameEvent* batch, int count)
+	{
+		static_cast<InvadersGame*>(game)->explode(batch, count,
+			DEBRIS_MOTHERSHIP, SOUND_EXPLOSION2);
+	}, this);
+
+	world.events.subscribeEffect(GameEventType::PLAYER_HIT,
+		[](void* game, const GameEvent* batch, int count)
+	{
+		static_cast<InvadersGame*>(game)->explode(batch, count,
+			DEBRIS_PLAYER, SOUND_EXPLOSION1);
+	}, this);
+
+	world.events.subscribeEffect(GameEventType::PLAYER_SHOT,
+		[](void* game, const GameEvent*, int)
+	{
+		static_cast<InvadersGame*>(game)->playSound(SOUND_LASER1);
+	}, this);
+
+	world.events.subscribeEffect(GameEventType::ALIEN_SHOT,
+		[](void* game, const GameEvent*, int)
+	{
+		static_cast<InvadersGame*>(game)->playSound(SOUND_LASER2);
+	}, this);
+
+	world.events.subscribeEffect(GameEventType::ALARM,
+		[](void* game, const GameEvent*, int)
+	{
+		static_cast<InvadersGame*>(game)->playSound(SOUND_ALARM);
+	}, this);
 }
 
 
 
-void InvadersGame::playAlarm()
+void InvadersGame::explode(const GameEvent* batch, int count, int size,
+	Asset sound)
 {
-	//play alarm on timer so it doesn't continuously play
-	if (mothership_one->getAlive() == true)
+	//every hit gets its own debris, the sound only plays once per batch
+	for (int i = 0; i < count; i++)
 	{
-		alarm_counter += time_difference;
-		if (alarm_counter >= 0.75)
-		{
-			audio_engine->play2D("..\\..\\Resources\\Audio\\Alarm.wav", false);
-			alarm_counter = 0;
-		}
+		spawnExplosion(batch[i].x, batch[i].y, size);
 	}
-}
\ No newline at end of file
+
+	playSound(sound);
+}
@@ -2,14 +2,24 @@
 #include <Engine/OGLGame.h>
 #include <irrKlang.h>
 
+#include <atomic>
 #include <string>
 
 #include "Actions.h"
-#include "Player.h"
-#include "Enemy.h"
-#include "Bullet.h"
-#include "Barrier.h"
-#include "Mothership.h"
+#include "AssetPack.h"
+#include "AssetRegistry.h"
+#include "Broadcast.h"
+#include "FileSystem.h"
+#include "GameWorld.h"
+#include "HotReload.h"
+#include "JobSystem.h"
+#include "LoadQueue.h"
+#include "Lockstep.h"
+#include "ParticleSystem.h"
+#include "RenderList.h"
+#include "Replay.h"
+#include "Replication.h"
+#include "Rollback.h"
 
 struct GameFont;
 
@@ -17,16 +27,11 @@ struct GameFont;
 *  Invaders Game. An OpenGL Game based on ASGE.
 */
 
-class Player;
-class Enemy;
-class Bullet;
-class Barrier;
-class Mothership;
-
 // forward declaration or irrKlang
 namespace irrklang
 {
 	class ISoundEngine;
+	class ISoundSource;
 }
 
 class InvadersGame:
@@ -46,6 +51,19 @@ public:
 		GAME_OVER = 5
 	};
 
+	enum class NetworkMode
+	{
+		NONE =          0, //single player
+		HOST =          1, //steps the world, clients share the cannon
+		JOIN =          2, //draws the host's world, sends input
+		LOCKSTEP_HOST = 3, //both step the world on shared input
+		LOCKSTEP_JOIN = 4, //starts from the lockstep host's world
+		ROLLBACK_HOST = 5, //lockstep that steps ahead on guessed input
+		ROLLBACK_JOIN = 6, //starts from the rollback host's world
+		BROADCAST =     7, //plays alone, spectators watch
+		SPECTATE =      8  //draws a broadcast game, sends nothing
+	};
+
 	// Inherited via Game
 	virtual bool run() override;
 	bool shouldExit() const;
@@ -55,49 +73,49 @@ public:
 	virtual bool init();
 	virtual void drawFrame();
 
+	//loopback multiplayer, before init
+	void setNetwork(NetworkMode mode, uint16_t port);
+
 	//audio
 	const bool initAudio(); //initialise audio engine
-	void playAlarm(); //play alarm sound
+	void playSound(Asset sound); //play sound if audio is ready
+	void subscribeEvents(); //react to world events
+
+	//sprite with texture at the scale it is drawn at, drawn wherever it
+	//is positioned
+	std::unique_ptr<ASGE::Sprite> loadSprite(Asset texture);
 
 	//player
 	const void checkPlayerAlive(); //check player alive status
-	void deathDelay(); //delay when player loses a life
 	
 	//aliens
-	void loadEnemies(); //load in aliens
-	void moveAliens(); //move alien tick
+	void loadAliens(); //load small and large alien sprites
 	const void renderAliens(); //render alien sprites
-	void enemyShoot(); //enemy shooting
-	void changeAlienSpeed(); //change enemy movement tick speed
-	const void checkAlienLives(); //check if all aliens are dead
-	void resetEnemies(); //reset enemies to start positions
 	
 	//barriers
-	void loadBarriers(); //load barrier sprites
 	const void renderBarriers(); //render barrier sprites
-	const void resetBarriers(); //set barriers back to full health
-	const void changeBarriers(); //change barrier sprite
 
 	//mothership
 	const void renderMothership(); //render mothership sprite
-	void deployMothership(); //enable and move mothership
 
 	//bullets
-	const void loadBullets(); //load alien bullet sprites
-	const void renderBullets(); //render bullet sprites
+	const void renderBullets(); //render player and alien bullets
 
 	//input
 	void stateInput(int key, int action); // menu state input
+	const WorldInput readPlayerInput(); //held action as world input
 
-	//collisions
-	void checkCollision(); // check if aliens have been shot
-	void checkBarrierCollision(); //check if barrier has been shot
-	void checkPlayerCollision(); //check if player has been shot
-	void spawnExplosion(int x, int y); //spawn explosion sprite
-	void checkMothershipCollision(); //check if mothership has been shot
+	//explosions
+	void spawnExplosion(int x, int y, int size); //throw size debris particles
+	const void renderParticles(); //render explosion debris
+
+	//drawing
+	void buildRenderList(); //list what is on screen before drawing it
 
 	//game updates
 	void updateGame(); //playing tick
+	void updateLockstep(const WorldInput& world_input); //ticks both peers have
+	void updateRollback(const WorldInput& world_input); //guessed ticks too
 	const void updateMenu(); //main menu
 	const void updateOptions(); //control screen
 	const void updatePause(); //pause screen
@@ -106,15 +124,29 @@ public:
 	//logic
 	void resetGame(); //reset game back to start
 
+	//assets
+	void mountResources(); //intern asset names and mount where they live
+	const char* getAssetPath(Asset asset); //native path of asset
+	void applyReloads(); //swap in assets edited since the last frame
+	void reloadTexture(Asset texture, const char* path); //every sprite using it
+	void reloadSound(AssetReload& reload); //replace its sound source
+	void reloadWaves(const WaveTable& waves); //new formation and difficulty
+
 	//GUI
 	void loadUI(); //load graphical user interface
+	void loadMenuUI(); //load menu button sprites
 	void renderUI(); //render graphical user interface
 	const void loadControls(); //show control scheme
 	const void renderMenuUI(); //render graphical user interface for menu	
 
 private:
+	const bool isPredicting(); //rollback play, the world is partly guessed
 	void processGameActions(); //respond to user input
 	void input(int key, int action); //user input
+
+	//debris at every hit in batch and one sound for all of them
+	void explode(const GameEvent* batch, int count, int size,
+		Asset sound);
 	
 	/**< Input Callback ID. The callback ID assigned by the game engine. */
 	int  callback_id = -1;      
@@ -124,29 +156,18 @@ private:
 	//menu sprite
 	std::unique_ptr<ASGE::Sprite>         invader = nullptr;  
 
-	//player sprite
-	std::unique_ptr<Player>               player_one = nullptr; 
-
-	//player bullet sprite
-	std::unique_ptr<Bullet>               bullet_one = nullptr;
-
-	//mothership sprite
-	std::unique_ptr<Mothership>           mothership_one = nullptr;
+	//player life sprite, drawn once per life left
+	std::unique_ptr<ASGE::Sprite>         life = nullptr;
 
-	//enemy alien sprites
-	std::vector<std::unique_ptr<Enemy>>   aliens;
+	//world sprites, each drawn at every entity that looks like it
+	std::unique_ptr<ASGE::Sprite> player = nullptr;
+	std::unique_ptr<ASGE::Sprite> bullet = nullptr;
+	std::unique_ptr<ASGE::Sprite> mothership = nullptr;
+	std::unique_ptr<ASGE::Sprite> aliens[2]; //small and large rows
+	std::unique_ptr<ASGE::Sprite> barrier_pixel = nullptr; //stretched
 
-	//alien bullet sprites
-	std::vector<std::unique_ptr<Bullet>>  bullets;
-
-	//barrier sprites
-	std::vector<std::unique_ptr<Barrier>> barriers;
-
-	//player life sprites
-	std::vector<std::unique_ptr<Player>>  lives;
-
-	//explosion sprite
-	std::unique_ptr<ASGE::Sprite>         explosion = nullptr;
+	//explosion debris sprite, drawn once per particle
+	std::unique_ptr<ASGE::Sprite>         debris = nullptr;
 	
 	//keyboard control sprites
 	std::unique_ptr<ASGE::Sprite> left = nullptr;
@@ -167,27 +188,52 @@ private:
 	//game playing tick
 	float time_difference =        0;
 
-	//delay counter for death 
-	float death_counter =          0;
+	int move_id = 0; // 0 = none, 1 = left, 2 = right
 
-	//time counter for spawning mothership
-	float mothership_spawn_timer = 0;
+	//packed sounds, must outlive the audio engine which borrows its memory
+	//and the filesystem which mounts it
+	AssetPack asset_pack;
 
-	//tick counter to move alien enemies
-	float alien_move_counter =     0;
+	//where assets are loaded from, every Asset is interned as its own id
+	FileSystem files;
 
-	////enemy movement tick speed
-	float alien_move_speed =       1.2;
+	//fans per tick work out across cores
+	JobSystem jobs;
 
-	//delay on playing alarm sound 
-	float alarm_counter =          0.75;
+	//game rules and actors, drawn with the sprites above
+	GameWorld world;
 
-	//enemy shooting frequency
-	int alien_shoot_speed =        20000;
+	//explosion debris
+	ParticleSystem particles;
 
-	int move_id = 0; // 0 = none, 1 = left, 2 = right
+	//living, on screen actors and debris of this frame
+	RenderList render_list;
+
+	//inputs of the game in progress
+	Replay replay;
+
+	//loopback multiplayer, only one of them is used
+	NetworkMode network_mode = NetworkMode::NONE;
+	uint16_t network_port = 0;
+	ReplicationHost net_host;
+	ReplicationClient net_client;
+	Lockstep lockstep;
+	Rollback rollback;
+	Broadcast broadcast;
+	float lockstep_time = 0; //frame time not yet stepped in either
+
+	//assets still to be loaded after the menu is up
+	LoadQueue load_queue;
+
+	//assets edited while the game runs
+	HotReload hot_reload;
 
 	// unique pointer to destroy engine automagically
 	std::unique_ptr<irrklang::ISoundEngine> audio_engine = nullptr;
+
+	//sound source of every sound asset, set once audio is ready
+	irrklang::ISoundSource* sounds[ASSET_COUNT] = {};
+	std::atomic<bool> audio_ready{ false };
+	int sound_generation = 0; //reloads so far, names their new sources
 };
 
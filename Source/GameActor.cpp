@@ -1,27 +0,0 @@
-#include "GameActor.h"
-
-const int GameActor::getHealth()
-{
-	return health;
-}
-
-
-
-void GameActor::setHealth(int hlth)
-{
-	health = hlth;
-}
-
-
-
-const bool GameActor::getAlive()
-{
-	return is_alive;
-}
-
-
-
-void GameActor::setAlive(bool alve)
-{
-	is_alive = alve;
-}
\ No newline at end of file
@@ -0,0 +1,146 @@
+#include "GameSnapshot.h"
+
+#include <fstream>
+
+const uint64_t hashSnapshot(const GameSnapshot& snapshot)
+{
+	//FNV-1a over the raw bytes, the struct has no padding to worry about
+	const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&snapshot);
+	uint64_t hash = 14695981039346656037ull;
+
+	for (size_t i = 0; i < sizeof(GameSnapshot); i++)
+	{
+		hash ^= bytes[i];
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
+
+
+
+const bool isSnapshotValid(const GameSnapshot& snapshot)
+{
+	return (snapshot.magic == SNAPSHOT_MAGIC) &&
+		(snapshot.version == SNAPSHOT_VERSION);
+}
+
+
+
+const bool saveSnapshot(const char* path, const GameSnapshot& snapshot)
+{
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+	if (!file)
+	{
+		return false;
+	}
+
+	file.write(reinterpret_cast<const char*>(&snapshot), sizeof(snapshot));
+
+	return (bool)file;
+}
+
+
+
+const bool loadSnapshot(const char* path, GameSnapshot& snapshot)
+{
+	std::ifstream file(path, std::ios::binary);
+
+	if (!file)
+	{
+		return false;
+	}
+
+	//read into a temporary so a bad file leaves the caller's copy alone
+	GameSnapshot loaded;
+
+	if (!file.read(reinterpret_cast<char*>(&loaded), sizeof(loaded)) ||
+		!isSnapshotValid(loaded))
+	{
+		return false;
+	}
+
+	snapshot = loaded;
+
+	return true;
+}
+
+
+
+SnapshotRing::SnapshotRing(int capacity)
+	: snapshots(capacity > 0 ? capacity : 1)
+{
+
+}
+
+
+
+void SnapshotRing::push(const GameSnapshot& snapshot)
+{
+	snapshots[head] = snapshot;
+
+	head = (head + 1) % (int)snapshots.size();
+
+	if (count < (int)snapshots.size())
+	{
+		count++;
+	}
+}
+
+
+
+void SnapshotRing::clear()
+{
+	head = 0;
+	count = 0;
+}
+
+
+
+const GameSnapshot* SnapshotRing::find(uint32_t frame)
+{
+	int capacity = (int)snapshots.size();
+
+	//newest first, rollback usually wants something recent
+	for (int i = 1; i <= count; i++)
+	{
+		const GameSnapshot& snapshot =
+			snapshots[(head - i + capacity) % capacity];
+
+		if (snapshot.frame == frame)
+		{
+			return &snapshot;
+		}
+	}
+
+	return nullptr;
+}
+
+
+
+const GameSnapshot* SnapshotRing::latest()
+{
+	if (count == 0)
+	{
+		return nullptr;
+	}
+
+	int capacity = (int)snapshots.size();
+
+	return &snapshots[(head - 1 + capacity) % capacity];
+}
+
+
+
+const int SnapshotRing::getSize()
+{
+	return count;
+}
+
+
+
+const int SnapshotRing::getCapacity()
+{
+	return (int)snapshots.size();
+}
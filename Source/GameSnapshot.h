@@ -0,0 +1,108 @@
+#pragma once
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "Barrier.h"
+#include "WaveConfig.h"
+
+/** @file GameSnapshot.h
+    @brief   Flat copy of everything that determines how a game plays out.
+    @details A GameSnapshot is plain data with fixed size fields and no
+             padding, so it can be memcpy'd, written straight to disk and
+             hashed byte for byte. GameWorld fills one with save() and
+             puts it back with restore(). Bump SNAPSHOT_VERSION whenever
+             the layout changes, old snapshots are then refused.
+*/
+
+constexpr uint32_t SNAPSHOT_MAGIC =   0x504E5349; /**< "ISNP" little endian */
+constexpr uint32_t SNAPSHOT_VERSION = 3;          /**< layout version */
+
+/** @struct ActorState
+*   @brief position and status shared by every actor
+*/
+struct ActorState
+{
+	int16_t x;        /**< screen x coord */
+	int16_t y;        /**< screen y coord */
+	int8_t health;    /**< remaining health */
+	uint8_t alive;    /**< actor is alive */
+	uint8_t flag;     /**< player death, bullet missed, alien is a shooter */
+	int8_t direction; /**< alien step per move tick */
+};
+
+/** @struct GameSnapshot
+*   @brief complete state of one GameWorld
+*/
+struct GameSnapshot
+{
+	uint32_t magic;             /**< SNAPSHOT_MAGIC */
+	uint32_t version;           /**< SNAPSHOT_VERSION */
+	uint32_t frame;             /**< world updates since reset */
+	uint32_t rng_state;         /**< xorshift state */
+
+	float death_counter;        /**< respawn delay */
+	float mothership_spawn_timer; /**< time until next mothership */
+	float alien_move_counter;   /**< time since aliens last moved */
+	float alien_move_speed;     /**< alien move tick */
+	float alarm_counter;        /**< time since alarm last played */
+	int32_t alien_shoot_speed;  /**< alien shooting odds */
+
+	int32_t score;              /**< player score */
+	int32_t multiplier;         /**< player score multiplier */
+	int32_t alien_start_y;      /**< wave spawn height */
+	int32_t alien_count;        /**< formation size, must match on restore */
+
+	ActorState player;          /**< player */
+	ActorState player_bullet;   /**< player bullet */
+	ActorState mothership;      /**< mothership */
+	ActorState aliens[MAX_ALIENS]; /**< formation, row by row */
+	ActorState bullets[5];      /**< alien bullets */
+	ActorState barriers[3];     /**< barriers */
+	uint64_t barrier_rows[3][BARRIER_HEIGHT]; /**< solid pixels per row */
+};
+
+static_assert(std::is_trivially_copyable<GameSnapshot>::value,
+	"snapshots are copied as raw bytes");
+static_assert(sizeof(ActorState) == 8, "ActorState must not be padded");
+static_assert(sizeof(GameSnapshot) ==
+	56 + 8 * (MAX_ALIENS + 11) + 8 * 3 * BARRIER_HEIGHT,
+	"GameSnapshot must not be padded");
+
+//hash of the snapshot bytes, equal hashes mean identical games
+const uint64_t hashSnapshot(const GameSnapshot& snapshot);
+
+//header matches this build
+const bool isSnapshotValid(const GameSnapshot& snapshot);
+
+//write a snapshot to disk
+const bool saveSnapshot(const char* path, const GameSnapshot& snapshot);
+
+//read a snapshot from disk, false if missing or from another version
+const bool loadSnapshot(const char* path, GameSnapshot& snapshot);
+
+/**
+*   Fixed size history of recent snapshots. Storage is allocated once,
+*   pushing overwrites the oldest entry.
+*/
+class SnapshotRing
+{
+public:
+	explicit SnapshotRing(int capacity);
+	~SnapshotRing() = default;
+
+	void push(const GameSnapshot& snapshot); //store, dropping the oldest
+	void clear(); //forget everything
+
+	//snapshot taken at frame, null if it has already been overwritten
+	const GameSnapshot* find(uint32_t frame);
+	const GameSnapshot* latest(); //most recent, null if empty
+
+	const int getSize(); //snapshots held
+	const int getCapacity(); //snapshots that fit
+
+private:
+	std::vector<GameSnapshot> snapshots; //storage
+	int head =  0; //next slot to write
+	int count = 0; //slots in use
+};
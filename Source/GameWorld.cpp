@@ -0,0 +1,1101 @@
+#include "GameWorld.h"
+#include "Bits.h"
+#include "Constants.h"
+#include "JobSystem.h"
+
+#include <cstring>
+
+namespace
+{
+	void saveActor(const Position& position, const Life& life,
+		ActorState& state)
+	{
+		state.x = (int16_t)position.x;
+		state.y = (int16_t)position.y;
+		state.health = (int8_t)life.health;
+		state.alive = life.alive ? 1 : 0;
+	}
+
+	void restoreActor(Position& position, Life& life, const ActorState& state)
+	{
+		position = { state.x, state.y };
+		life = { state.health, state.alive != 0 };
+	}
+
+	//bullets wait off screen until fired
+	void createShots(EntityStore& entities, ArchetypeId kind, int count,
+		int speed)
+	{
+		int first = entities.create(kind, count);
+		Position* position = entities.get<Position>(kind);
+		Shot* shot = entities.get<Shot>(kind);
+		Life* life = entities.get<Life>(kind);
+
+		for (int i = first; i < first + count; i++)
+		{
+			position[i] = { -10, -10 };
+			shot[i].speed = speed;
+			life[i].health = 1;
+		}
+	}
+}
+
+GameWorld::GameWorld(uint32_t seed, JobSystem* job_system)
+	: jobs(job_system)
+{
+	//xorshift can't recover from a zero state
+	rng_state = seed ? seed : 1;
+
+	//hit masks generated from the art at the size it is drawn
+	alien_masks[0] = &getHitMask(TEXTURE_ALIEN1);
+	alien_masks[1] = &getHitMask(TEXTURE_ALIEN2);
+	mothership_mask = &getHitMask(TEXTURE_SPACESHIP);
+	player_mask = &getHitMask(TEXTURE_PLAYER);
+
+	//one archetype per kind of actor, in Kind order
+	const ComponentMask hostile = componentMask(HOSTILE);
+
+	entities.addArchetype<Position, Life, Pilot>();
+	entities.addArchetype<Position, Life, Shot>();
+	entities.addArchetype<Position, Life>(hostile);
+	entities.addArchetype<Position, Life, March>(hostile);
+	entities.addArchetype<Position, Life, Shot>(hostile);
+	entities.addArchetype<Position, Barrier>();
+
+	//player
+	entities.create(PLAYER);
+	*entities.get<Position>(PLAYER) = { 500, 675 };
+	*entities.get<Life>(PLAYER) = { 3, true };
+	*entities.get<Pilot>(PLAYER) = { 0, 1, false };
+
+	//player bullet and enemy bullets
+	createShots(entities, PLAYER_SHOT, 1, -800);
+	createShots(entities, ALIEN_SHOTS, 5, 650);
+
+	//mothership waits off to the left until deployed
+	entities.create(MOTHERSHIP);
+	*entities.get<Position>(MOTHERSHIP) = { 50, 50 };
+	*entities.get<Life>(MOTHERSHIP) = { 1, false };
+
+	//barriers
+	entities.create(BARRIERS, 3);
+	Position* barrier_position = entities.get<Position>(BARRIERS);
+	Barrier* barrier = entities.get<Barrier>(BARRIERS);
+	int pos_x = 200;
+
+	for (int i = 0; i < 3; i++)
+	{
+		barrier_position[i] = { pos_x, 600 };
+		barrier[i].resetBarrier();
+
+		pos_x += 300;
+	}
+
+	setWaves(defaultWaves());
+
+	//the world's own rules run before anyone else subscribes
+	events.subscribe(GameEventType::SHOT_MISSED,
+		[](void* world, const GameEvent* batch, int count)
+	{
+		static_cast<GameWorld*>(world)->onShotMissed(batch, count);
+	}, this);
+
+	events.subscribe(GameEventType::ALIEN_KILLED,
+		[](void* world, const GameEvent* batch, int count)
+	{
+		static_cast<GameWorld*>(world)->onScored(batch, count);
+	}, this);
+
+	events.subscribe(GameEventType::MOTHERSHIP_KILLED,
+		[](void* world, const GameEvent* batch, int count)
+	{
+		static_cast<GameWorld*>(world)->onScored(batch, count);
+	}, this);
+
+	events.subscribe(GameEventType::WAVE_CLEARED,
+		[](void* world, const GameEvent* batch, int count)
+	{
+		static_cast<GameWorld*>(world)->onWaveCleared(batch, count);
+	}, this);
+
+	events.subscribe(GameEventType::PLAYER_HIT,
+		[](void* world, const GameEvent* batch, int count)
+	{
+		static_cast<GameWorld*>(world)->onPlayerHit(batch, count);
+	}, this);
+}
+
+
+
+void GameWorld::setWaves(const WaveTable& table)
+{
+	waves = table;
+
+	//one alien per formation slot
+	int count = waves.rows * waves.columns;
+
+	entities.clear(ALIENS);
+	entities.create(ALIENS, count);
+
+	Life* life = entities.get<Life>(ALIENS);
+	March* march = entities.get<March>(ALIENS);
+
+	for (int i = 0; i < count; i++)
+	{
+		life[i].health = 1;
+		march[i].start_y = waves.start_y;
+	}
+
+	resetEnemies();
+
+	alien_move_speed = waves.difficulty[0].move_interval;
+	alien_shoot_speed = waves.difficulty[0].shoot_odds;
+}
+
+
+
+const WaveTable& GameWorld::getWaves()
+{
+	return waves;
+}
+
+
+
+void GameWorld::reset()
+{
+	//spawn at specified y coord
+	March* march = entities.get<March>(ALIENS);
+
+	for (int i = 0; i < entities.getCount(ALIENS); i++)
+	{
+		march[i].start_y = waves.start_y;
+	}
+
+	//reset game actors for new game
+	resetEnemies();
+
+	Barrier* barrier = entities.get<Barrier>(BARRIERS);
+
+	for (int i = 0; i < entities.getCount(BARRIERS); i++)
+	{
+		barrier[i].resetBarrier();
+	}
+
+	//reset movement and shooting speed
+	alien_move_speed = waves.difficulty[0].move_interval;
+	alien_shoot_speed = waves.difficulty[0].shoot_odds;
+
+	//reset timers
+	death_counter = 0;
+	mothership_spawn_timer = 0;
+	alien_move_counter = 0;
+	alarm_counter = 0.75;
+
+	entities.get<Life>(MOTHERSHIP)->alive = false;
+
+	//reset player
+	*entities.get<Life>(PLAYER) = { 3, true };
+	*entities.get<Pilot>(PLAYER) = { 0, 1, false };
+	entities.get<Position>(PLAYER)->x = 500;
+
+	Life* shot_life = entities.get<Life>(ALIEN_SHOTS);
+
+	for (int i = 0; i < entities.getCount(ALIEN_SHOTS); i++)
+	{
+		shot_life[i].alive = false;
+	}
+
+	entities.get<Life>(PLAYER_SHOT)->alive = false;
+	entities.get<Shot>(PLAYER_SHOT)->missed = false;
+
+	events.clear();
+	frame = 0;
+}
+
+
+
+void GameWorld::update(float dt)
+{
+	time_difference = dt;
+	frame++;
+
+	//check if player is currently respawning
+	deathDelay();
+
+	if (jobs)
+	{
+		//aliens and bullets move on the job system while the mothership
+		//is updated on this thread
+		JobCounter aliens_moved;
+		JobCounter movement;
+
+		jobs->run([this]()
+		{
+			moveAliens();
+		}, aliens_moved);
+
+		//change speed of aliens once they have moved
+		jobs->runAfter(aliens_moved, [this]()
+		{
+			changeAlienSpeed();
+		}, movement);
+
+		jobs->run([this]()
+		{
+			moveBullets();
+		}, movement);
+
+		//spawn and move mothership
+		deployMothership();
+
+		jobs->wait(movement);
+	}
+
+	else
+	{
+		moveAliens();
+		changeAlienSpeed();
+		moveBullets();
+		deployMothership();
+	}
+
+	//if player bullet missed then reset multipler
+	Shot* shot = entities.get<Shot>(PLAYER_SHOT);
+
+	if (shot->missed == true)
+	{
+		publish(GameEventType::SHOT_MISSED, *entities.get<Position>(PLAYER_SHOT));
+		shot->missed = false;
+	}
+
+	//alien shooting
+	enemyShoot();
+
+	//aliens being shot
+	checkCollision();
+
+	//check if all aliens are dead
+	checkAlienLives();
+
+	//check if player has been shot
+	checkPlayerCollision();
+
+	//check if barriers have been shot
+	checkBarrierCollision();
+
+	//check if mothership has been shot
+	checkMothershipCollision();
+
+	//scoring, sound and effects react to everything that happened
+	events.dispatch();
+}
+
+
+
+void GameWorld::applyInput(float dt, const WorldInput& input)
+{
+	Position* player = entities.get<Position>(PLAYER);
+
+	//move player right
+	if (input.move > 0)
+	{
+		if (player->x < 990)
+		{
+			player->x += 400 * dt;
+		}
+	}
+
+	//move player left
+	else if (input.move < 0)
+	{
+		if (player->x > 10)
+		{
+			player->x += -300 * dt;
+		}
+	}
+
+	//player shoot, not while respawning
+	if (input.shoot && (entities.get<Pilot>(PLAYER)->death == false))
+	{
+		Position* bullet = entities.get<Position>(PLAYER_SHOT);
+		Life* bullet_life = entities.get<Life>(PLAYER_SHOT);
+
+		if (bullet_life->alive != true)
+		{
+			//fire from the middle of the ship
+			*bullet = { player->x + 24, player->y };
+			bullet_life->alive = true;
+
+			publish(GameEventType::PLAYER_SHOT, *bullet);
+		}
+	}
+
+	events.dispatch();
+}
+
+
+
+void GameWorld::step(float dt, const WorldInput& input)
+{
+	update(dt);
+	applyInput(dt, input);
+}
+
+
+
+void GameWorld::save(GameSnapshot& snapshot)
+{
+	//clear first so the bytes, and therefore the hash, are deterministic
+	std::memset(&snapshot, 0, sizeof(snapshot));
+
+	snapshot.magic = SNAPSHOT_MAGIC;
+	snapshot.version = SNAPSHOT_VERSION;
+	snapshot.frame = frame;
+	snapshot.rng_state = rng_state;
+
+	snapshot.death_counter = death_counter;
+	snapshot.mothership_spawn_timer = mothership_spawn_timer;
+	snapshot.alien_move_counter = alien_move_counter;
+	snapshot.alien_move_speed = alien_move_speed;
+	snapshot.alarm_counter = alarm_counter;
+	snapshot.alien_shoot_speed = alien_shoot_speed;
+
+	const Pilot& pilot = *entities.get<Pilot>(PLAYER);
+	const March* march = entities.get<March>(ALIENS);
+
+	snapshot.score = pilot.score;
+	snapshot.multiplier = pilot.multiplier;
+	snapshot.alien_start_y = march[0].start_y;
+	snapshot.alien_count = (int32_t)entities.getCount(ALIENS);
+
+	saveActor(*entities.get<Position>(PLAYER), *entities.get<Life>(PLAYER),
+		snapshot.player);
+	snapshot.player.flag = pilot.death ? 1 : 0;
+
+	saveActor(*entities.get<Position>(PLAYER_SHOT),
+		*entities.get<Life>(PLAYER_SHOT), snapshot.player_bullet);
+	snapshot.player_bullet.flag =
+		entities.get<Shot>(PLAYER_SHOT)->missed ? 1 : 0;
+
+	saveActor(*entities.get<Position>(MOTHERSHIP),
+		*entities.get<Life>(MOTHERSHIP), snapshot.mothership);
+
+	const Position* position = entities.get<Position>(ALIENS);
+	const Life* life = entities.get<Life>(ALIENS);
+
+	for (int i = 0; i < snapshot.alien_count; i++)
+	{
+		saveActor(position[i], life[i], snapshot.aliens[i]);
+		snapshot.aliens[i].flag = front_line.isShooter(i) ? 1 : 0;
+		snapshot.aliens[i].direction = (int8_t)march[i].direction;
+	}
+
+	position = entities.get<Position>(ALIEN_SHOTS);
+	life = entities.get<Life>(ALIEN_SHOTS);
+	const Shot* shot = entities.get<Shot>(ALIEN_SHOTS);
+
+	for (int i = 0; i < entities.getCount(ALIEN_SHOTS); i++)
+	{
+		saveActor(position[i], life[i], snapshot.bullets[i]);
+		snapshot.bullets[i].flag = shot[i].missed ? 1 : 0;
+	}
+
+	//barriers have no Life, health and alive follow their pixels
+	position = entities.get<Position>(BARRIERS);
+	Barrier* barrier = entities.get<Barrier>(BARRIERS);
+
+	for (int i = 0; i < entities.getCount(BARRIERS); i++)
+	{
+		Life pixels = { barrier[i].getHealth(), barrier[i].getAlive() };
+
+		saveActor(position[i], pixels, snapshot.barriers[i]);
+		std::memcpy(snapshot.barrier_rows[i], barrier[i].getRows(),
+			sizeof(snapshot.barrier_rows[i]));
+	}
+}
+
+
+
+const bool GameWorld::restore(const GameSnapshot& snapshot)
+{
+	//formation has to match the wave table in use
+	if (!isSnapshotValid(snapshot) ||
+		(snapshot.alien_count != (int32_t)entities.getCount(ALIENS)))
+	{
+		return false;
+	}
+
+	frame = snapshot.frame;
+	rng_state = snapshot.rng_state;
+
+	death_counter = snapshot.death_counter;
+	mothership_spawn_timer = snapshot.mothership_spawn_timer;
+	alien_move_counter = snapshot.alien_move_counter;
+	alien_move_speed = snapshot.alien_move_speed;
+	alarm_counter = snapshot.alarm_counter;
+	alien_shoot_speed = snapshot.alien_shoot_speed;
+
+	*entities.get<Pilot>(PLAYER) = { snapshot.score, snapshot.multiplier,
+		snapshot.player.flag != 0 };
+	restoreActor(*entities.get<Position>(PLAYER), *entities.get<Life>(PLAYER),
+		snapshot.player);
+
+	restoreActor(*entities.get<Position>(PLAYER_SHOT),
+		*entities.get<Life>(PLAYER_SHOT), snapshot.player_bullet);
+	entities.get<Shot>(PLAYER_SHOT)->missed = snapshot.player_bullet.flag != 0;
+
+	restoreActor(*entities.get<Position>(MOTHERSHIP),
+		*entities.get<Life>(MOTHERSHIP), snapshot.mothership);
+
+	Position* position = entities.get<Position>(ALIENS);
+	Life* life = entities.get<Life>(ALIENS);
+	March* march = entities.get<March>(ALIENS);
+
+	for (int i = 0; i < snapshot.alien_count; i++)
+	{
+		restoreActor(position[i], life[i], snapshot.aliens[i]);
+		march[i] = { snapshot.aliens[i].direction, snapshot.alien_start_y };
+	}
+
+	//who is alive, and so who can shoot, follows from the aliens' Life
+	live_aliens.rebuild(life, waves.rows, waves.columns);
+	front_line.rebuild(live_aliens, waves.rows, waves.columns);
+
+	position = entities.get<Position>(ALIEN_SHOTS);
+	life = entities.get<Life>(ALIEN_SHOTS);
+	Shot* shot = entities.get<Shot>(ALIEN_SHOTS);
+
+	for (int i = 0; i < entities.getCount(ALIEN_SHOTS); i++)
+	{
+		restoreActor(position[i], life[i], snapshot.bullets[i]);
+		shot[i].missed = snapshot.bullets[i].flag != 0;
+	}
+
+	//pixels decide health and alive
+	position = entities.get<Position>(BARRIERS);
+	Barrier* barrier = entities.get<Barrier>(BARRIERS);
+
+	for (int i = 0; i < entities.getCount(BARRIERS); i++)
+	{
+		position[i] = { snapshot.barriers[i].x, snapshot.barriers[i].y };
+		barrier[i].setRows(snapshot.barrier_rows[i]);
+	}
+
+	//anything pending belonged to the state being replaced
+	events.clear();
+
+	return true;
+}
+
+
+
+const bool GameWorld::isGameOver()
+{
+	return entities.get<Life>(PLAYER)->alive == false;
+}
+
+
+
+const bool GameWorld::isRespawning()
+{
+	return entities.get<Pilot>(PLAYER)->death;
+}
+
+
+
+const uint32_t GameWorld::getFrame()
+{
+	return frame;
+}
+
+
+
+template<typename Func>
+void GameWorld::forRange(int begin, int end, Func func)
+{
+	if (jobs)
+	{
+		jobs->parallelFor(begin, end, JOB_GRAIN, func);
+	}
+
+	else
+	{
+		func(begin, end);
+	}
+}
+
+
+
+void GameWorld::moveAliens()
+{
+	//move enemy aliens
+	int count = entities.getCount(ALIENS);
+	Position* position = entities.get<Position>(ALIENS);
+	March* march = entities.get<March>(ALIENS);
+
+	//change direction boolean
+	bool change = false;
+
+	//movement tick
+	alien_move_counter += time_difference;
+
+	//if movement tick reaches threshold
+	if (alien_move_counter >= alien_move_speed)
+	{
+		//if any living alien is out of bounds then change direction
+		for (int c = live_aliens.next(0); c >= 0; c = live_aliens.next(c + 1))
+		{
+			if ((position[c].x < waves.left_edge) ||
+				(position[c].x > waves.right_edge))
+			{
+				change = true;
+				break;
+			}
+		}
+
+		if (change)
+		{
+			//living aliens can end the game or push the formation back,
+			//later aliens see where earlier ones pushed it
+			for (int i = live_aliens.next(0); i >= 0; i = live_aliens.next(i + 1))
+			{
+				//if aliens are below certain threshold then game ends
+				if (position[i].y > waves.invade_y)
+				{
+					entities.get<Life>(PLAYER)->alive = false;
+				}
+
+				//if over either threshold then bring back into bounds
+				if (position[i].x < waves.left_edge)
+				{
+					for (int c = 0; c < count; c++)
+					{
+						position[c].x += waves.step_x;
+					}
+				}
+
+				else if (position[i].x > waves.right_edge)
+				{
+					for (int c = 0; c < count; c++)
+					{
+						position[c].x -= waves.step_x;
+					}
+				}
+			}
+
+			//the whole formation, dead slots too, moves down and turns
+			for (int i = 0; i < count; i++)
+			{
+				position[i].y += waves.drop_y;
+				march[i].direction *= -1;
+			}
+		}
+
+		else
+		{
+			//if not changing direction then move as normal per tick
+			forRange(0, count, [position, march](int first, int last)
+			{
+				for (int j = first; j < last; j++)
+				{
+					position[j].x += march[j].direction;
+				}
+			});
+		}
+
+		//reset tick counter
+		alien_move_counter = 0;
+	}
+}
+
+
+
+void GameWorld::changeAlienSpeed()
+{
+	//increase enemy alien speed and shooting freuqency depending on height
+	int height = entities.get<Position>(ALIENS)->y;
+
+	//lowest step reached wins, above the first step the pace is kept
+	for (int i = waves.difficulty_count - 1; i > 0; i--)
+	{
+		if (height >= waves.difficulty[i].min_y)
+		{
+			alien_move_speed = waves.difficulty[i].move_interval;
+			alien_shoot_speed = waves.difficulty[i].shoot_odds;
+			return;
+		}
+	}
+}
+
+
+
+void GameWorld::checkCollision()
+{
+	Position* bullet = entities.get<Position>(PLAYER_SHOT);
+	Life* bullet_life = entities.get<Life>(PLAYER_SHOT);
+
+	if (bullet_life->alive == true)
+	{
+		Position* position = entities.get<Position>(ALIENS);
+		Life* life = entities.get<Life>(ALIENS);
+		int i = -1;
+
+		//living aliens row by row, lowest index wins
+		for (int row = 0; (row < waves.rows) && (i < 0); row++)
+		{
+			uint64_t alive = live_aliens.getRow(row);
+
+			if (alive == 0)
+			{
+				continue;
+			}
+
+			//a row drops as one, skip it unless the bullet is level with it
+			const HitMask& mask = *alien_masks[waves.row[row].sprite == 1 ? 1 : 0];
+			int first = row * waves.columns;
+			int top = position[first + lowestBit(alive)].y + mask.top;
+
+			if ((bullet->y > top + mask.height - 1) || (bullet->y + 5 < top))
+			{
+				continue;
+			}
+
+			while (alive != 0)
+			{
+				int alien = first + lowestBit(alive);
+
+				//if player bullet covers a solid pixel of the alien
+				if (hitTest(mask, position[alien].x, position[alien].y,
+					bullet->x, bullet->y, bullet->x + 5, bullet->y + 5))
+				{
+					i = alien;
+					break;
+				}
+
+				alive &= alive - 1;
+			}
+		}
+
+		if (i >= 0)
+		{
+			//kill alien and bullet, score depends on alien row
+			life[i].alive = false;
+			bullet_life->alive = false;
+
+			//the alien above may take over shooting for this column
+			live_aliens.kill(i);
+			front_line.kill(i, live_aliens);
+
+			publish(GameEventType::ALIEN_KILLED, position[i], i,
+				waves.row[i / waves.columns].score);
+		}
+	}
+}
+
+
+
+void GameWorld::checkAlienLives()
+{
+	//checking if all aliens are dead
+	if (!live_aliens.isEmpty())
+	{
+		return;
+	}
+
+	int count = entities.getCount(ALIENS);
+	March* march = entities.get<March>(ALIENS);
+
+	//wave cleared, rules give back a lost life
+	publish(GameEventType::WAVE_CLEARED, *entities.get<Position>(PLAYER));
+
+	//spawn enemies lower each round
+	if (march[0].start_y < waves.start_y_max)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			march[i].start_y += waves.start_y_step;
+		}
+	}
+
+	resetEnemies();
+}
+
+
+
+void GameWorld::resetEnemies()
+{
+	Position* position = entities.get<Position>(ALIENS);
+	Life* life = entities.get<Life>(ALIENS);
+	March* march = entities.get<March>(ALIENS);
+
+	//respawn enemies
+	int counter = 0;
+
+	//this determines how far down they start spawning
+	int pos_y = march[0].start_y;
+
+	for (int i = 0; i < waves.rows; i++)
+	{
+		int pos_x = waves.origin_x + waves.row[i].offset_x;
+
+		for (int j = 0; j < waves.columns; j++)
+		{
+			life[counter].alive = true;
+			position[counter] = { pos_x, pos_y };
+			march[counter].direction = waves.step_x;
+
+			counter++;
+			pos_x += waves.spacing_x;
+		}
+		pos_y += waves.spacing_y;
+	}
+
+	//only the bottom row can shoot to begin with
+	live_aliens.reset(waves.rows, waves.columns);
+	front_line.reset(waves.rows, waves.columns);
+}
+
+
+
+void GameWorld::moveBullets()
+{
+	//player and enemy bullets alike, each at its own speed
+	float dt = time_difference;
+
+	entities.each<Position, Life, Shot>([dt](ArchetypeId, int count,
+		Position* position, Life* life, Shot* shot)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			//if bullet is off screen then kill it
+			if ((position[i].y < -20) || (position[i].y > 700))
+			{
+				life[i].alive = false;
+				shot[i].missed = true;
+			}
+
+			if (life[i].alive)
+			{
+				//if bullet is live then move up or down
+				position[i].y += (int)(shot[i].speed * dt);
+			}
+
+			else
+			{
+				//hide bullet if dead
+				position[i] = { -10, -10 };
+			}
+		}
+	});
+}
+
+
+
+void GameWorld::enemyShoot()
+{
+	const Position* position = entities.get<Position>(ALIENS);
+	const int* shooters = front_line.getShooters();
+
+	int shots = entities.getCount(ALIEN_SHOTS);
+	Position* bullet = entities.get<Position>(ALIEN_SHOTS);
+	Life* bullet_life = entities.get<Life>(ALIEN_SHOTS);
+
+	//only the lowest living alien in each column can shoot
+	for (int s = 0; s < front_line.getCount(); s++)
+	{
+		int i = shooters[s];
+
+		for (int j = 0; j < shots; j++)
+		{
+			//for each bullet random chance to fire if not already
+			if (randomInt(alien_shoot_speed) == 1)
+			{
+				if (bullet_life[j].alive == false)
+				{
+					//spawn bullet below selected alien
+					bullet[j] = { position[i].x + 15, position[i].y + 5 };
+					bullet_life[j].alive = true;
+
+					publish(GameEventType::ALIEN_SHOT, bullet[j], i);
+				}
+			}
+		}
+	}
+}
+
+
+
+void GameWorld::checkPlayerCollision()
+{
+	const Position& player = *entities.get<Position>(PLAYER);
+
+	int shots = entities.getCount(ALIEN_SHOTS);
+	Position* bullet = entities.get<Position>(ALIEN_SHOTS);
+	Life* bullet_life = entities.get<Life>(ALIEN_SHOTS);
+
+	//check if any live alien bullets cover a solid pixel of the player
+	for (int i = 0; i < shots; i++)
+	{
+		if ((bullet_life[i].alive == true) &&
+			hitTest(*player_mask, player.x, player.y, bullet[i].x,
+				bullet[i].y, bullet[i].x + 5, bullet[i].y + 5))
+		{
+			//if hit kill bullet, losing the life waits for the events to
+			//be dispatched so only one hit counts per tick
+			bullet_life[i].alive = false;
+
+			publish(GameEventType::PLAYER_HIT, player, i);
+			return;
+		}
+	}
+}
+
+
+
+void GameWorld::checkBarrierCollision()
+{
+	//bullets move further than the blast radius in a tick, so each one
+	//is tested as the box it swept through since the last tick
+	int enemy_sweep = (int)(650 * time_difference);
+	int player_sweep = (int)(800 * time_difference);
+
+	int shots = entities.getCount(ALIEN_SHOTS);
+	Position* bullet = entities.get<Position>(ALIEN_SHOTS);
+	Life* bullet_life = entities.get<Life>(ALIEN_SHOTS);
+
+	Position* player_bullet = entities.get<Position>(PLAYER_SHOT);
+	Life* player_bullet_life = entities.get<Life>(PLAYER_SHOT);
+
+	Position* position = entities.get<Position>(BARRIERS);
+	Barrier* barrier = entities.get<Barrier>(BARRIERS);
+
+	for (int j = 0; j < entities.getCount(BARRIERS); j++)
+	{
+		if (barrier[j].getAlive() == false)
+		{
+			continue;
+		}
+
+		//tested in barrier space
+		int left = position[j].x;
+		int top = position[j].y;
+
+		//enemy bullets hit the top face on the way down
+		for (int i = 0; i < shots; i++)
+		{
+			if (bullet_life[i].alive == true)
+			{
+				int x = bullet[i].x - left;
+				int y = bullet[i].y - top;
+
+				int row = barrier[j].hitTest(x, y - enemy_sweep, x + 5, y + 5,
+					false);
+
+				if (row >= 0)
+				{
+					//kill bullet and blow a hole where it landed
+					bullet_life[i].alive = false;
+					barrier[j].erode(x + 2, row);
+
+					publish(GameEventType::BARRIER_HIT, bullet[i], j, 0);
+				}
+			}
+		}
+
+		//player bullet hits the underside on the way up
+		if (player_bullet_life->alive == true)
+		{
+			int x = player_bullet->x - left;
+			int y = player_bullet->y - top;
+
+			int row = barrier[j].hitTest(x, y, x + 5, y + 5 + player_sweep,
+				true);
+
+			if (row >= 0)
+			{
+				//kill player bullet and blow a hole where it landed
+				player_bullet_life->alive = false;
+				barrier[j].erode(x + 2, row);
+
+				publish(GameEventType::BARRIER_HIT, *player_bullet, j, 1);
+
+				//shooting a barrier counts as a miss
+				publish(GameEventType::SHOT_MISSED, *player_bullet);
+			}
+		}
+	}
+}
+
+
+
+void GameWorld::deathDelay()
+{
+	Pilot* pilot = entities.get<Pilot>(PLAYER);
+
+	//if player is hit then delay respawn
+	if (pilot->death == true)
+	{
+		death_counter += time_difference;
+
+		if (death_counter >= 1)
+		{
+			pilot->death = false;
+
+			death_counter = 0;
+		}
+	}
+}
+
+
+
+void GameWorld::deployMothership()
+{
+	Position* position = entities.get<Position>(MOTHERSHIP);
+	Life* life = entities.get<Life>(MOTHERSHIP);
+
+	//if mothership not already going
+	//spawn when time counter reaches threshold
+	if (life->alive == false)
+	{
+		mothership_spawn_timer += time_difference;
+
+		if (mothership_spawn_timer >= waves.mothership_interval)
+		{
+			life->alive = true;
+			position->x = -10;
+			mothership_spawn_timer = 0;
+		}
+	}
+
+	//if mothership alive then move across until out of bounds then kill
+	else if (life->alive == true)
+	{
+		if (position->x > 990)
+		{
+			life->alive = false;
+			return;
+		}
+
+		position->x += (int)(waves.mothership_speed * time_difference);
+
+		//play alarm sound
+		playAlarm();
+	}
+}
+
+
+
+void GameWorld::playAlarm()
+{
+	//play alarm on timer so it doesn't continuously play
+	if (entities.get<Life>(MOTHERSHIP)->alive == true)
+	{
+		alarm_counter += time_difference;
+		if (alarm_counter >= 0.75)
+		{
+			publish(GameEventType::ALARM, *entities.get<Position>(MOTHERSHIP));
+			alarm_counter = 0;
+		}
+	}
+}
+
+
+
+void GameWorld::checkMothershipCollision()
+{
+	Position* mothership = entities.get<Position>(MOTHERSHIP);
+	Life* mothership_life = entities.get<Life>(MOTHERSHIP);
+	Position* bullet = entities.get<Position>(PLAYER_SHOT);
+	Life* bullet_life = entities.get<Life>(PLAYER_SHOT);
+
+	//check if live player bullet covers a solid pixel of live mothership
+	if ((bullet_life->alive == true) && (mothership_life->alive == true) &&
+		hitTest(*mothership_mask, mothership->x, mothership->y, bullet->x,
+			bullet->y, bullet->x + 5, bullet->y + 5))
+	{
+		//kill mothersip and bullet
+		mothership_life->alive = false;
+		bullet_life->alive = false;
+
+		publish(GameEventType::MOTHERSHIP_KILLED, *mothership, 0,
+			waves.mothership_score);
+	}
+}
+
+
+
+int GameWorld::randomInt(int max)
+{
+	//xorshift32, cheap enough to call per alien per bullet every tick
+	rng_state ^= rng_state << 13;
+	rng_state ^= rng_state >> 17;
+	rng_state ^= rng_state << 5;
+
+	return (int)(rng_state % ((uint32_t)max + 1));
+}
+
+
+
+void GameWorld::publish(GameEventType type, const Position& at, int index,
+	int value)
+{
+	events.publish(type, { at.x, at.y, index, value });
+}
+
+
+
+void GameWorld::onShotMissed(const GameEvent*, int)
+{
+	//reset player multiplier for missing enemies
+	entities.get<Pilot>(PLAYER)->multiplier = 1;
+}
+
+
+
+void GameWorld::onScored(const GameEvent* batch, int count)
+{
+	//each kill is worth its score times the multiplier, which then grows
+	Pilot* pilot = entities.get<Pilot>(PLAYER);
+
+	for (int i = 0; i < count; i++)
+	{
+		pilot->score += pilot->multiplier * batch[i].value;
+		pilot->multiplier++;
+	}
+}
+
+
+
+void GameWorld::onWaveCleared(const GameEvent*, int)
+{
+	//if wave cleared then give back a lost life
+	Life* life = entities.get<Life>(PLAYER);
+
+	if (life->health < 3)
+	{
+		life->health++;
+	}
+}
+
+
+
+void GameWorld::onPlayerHit(const GameEvent*, int count)
+{
+	Life* life = entities.get<Life>(PLAYER);
+	Pilot* pilot = entities.get<Pilot>(PLAYER);
+
+	//take life off of player and create respawn delay
+	pilot->death = true;
+	pilot->multiplier = 1;
+	life->health -= count;
+
+	//reset player position
+	entities.get<Position>(PLAYER)->x = 500;
+
+	//if no more lives then player is dead
+	if (life->health <= 0)
+	{
+		life->health = 0;
+		life->alive = false;
+	}
+}
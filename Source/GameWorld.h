@@ -0,0 +1,156 @@
+#pragma once
+#include <cstdint>
+
+#include "AliveSet.h"
+#include "EntityStore.h"
+#include "EventBus.h"
+#include "FrontLine.h"
+#include "GameSnapshot.h"
+#include "HitMask.h"
+#include "WaveConfig.h"
+
+/** @file GameWorld.h
+    @brief   The rules of the game, independent of rendering and audio.
+    @details GameWorld owns every actor and timer and advances them by a
+             given time step. Actors are entities in its EntityStore, one
+             archetype per kind, and each rule is a system that scans the
+             columns it needs. It never touches the renderer or the sound
+             engine, anything that happens is published on its event bus
+             for the caller to react to. InvadersGame owns one and draws it, the
+             batch simulation steps many of them without a window.
+*/
+
+class JobSystem;
+
+/** @struct WorldInput
+*   @brief player input for one tick
+*/
+struct WorldInput
+{
+	int move =   0;     /**< -1 left, 0 none, 1 right */
+	bool shoot = false; /**< fire if no player bullet is live */
+};
+
+class GameWorld
+{
+public:
+	//archetypes, added in this order so each is its own ArchetypeId
+	enum Kind : ArchetypeId
+	{
+		PLAYER =      0, /**< Position, Life, Pilot, one row */
+		PLAYER_SHOT = 1, /**< Position, Life, Shot, one row */
+		MOTHERSHIP =  2, /**< Position, Life, hostile, one row */
+		ALIENS =      3, /**< Position, Life, March, hostile, row by row */
+		ALIEN_SHOTS = 4, /**< Position, Life, Shot, hostile */
+		BARRIERS =    5, /**< Position, Barrier */
+		KIND_COUNT
+	};
+
+	//job system is optional, without one everything runs on the caller
+	explicit GameWorld(uint32_t seed = 1, JobSystem* job_system = nullptr);
+	~GameWorld() = default;
+
+	//subscribers hold a pointer to the world so it can't be copied
+	GameWorld(const GameWorld&) = delete;
+	GameWorld& operator=(const GameWorld&) = delete;
+
+	void reset(); //reset everything back to the start of a new game
+	void setWaves(const WaveTable& table); //rebuild formation from table
+	const WaveTable& getWaves(); //formation and difficulty in use
+	void update(float dt); //advance aliens, bullets and collisions
+	void applyInput(float dt, const WorldInput& input); //move and shoot
+	void step(float dt, const WorldInput& input); //update then apply input
+
+	void save(GameSnapshot& snapshot); //copy full state into snapshot
+	const bool restore(const GameSnapshot& snapshot); //replace state
+
+	const bool isGameOver(); //player has run out of lives
+	const bool isRespawning(); //player was shot and isn't back yet
+	const uint32_t getFrame(); //updates since reset
+
+	//every actor, see Kind, rows only change in setWaves
+	EntityStore entities;
+
+	//aliens with Life::alive set, changed together
+	AliveSet live_aliens;
+
+	//hits, kills and shots, dispatched at the end of update and applyInput
+	EventBus events;
+
+private:
+	//aliens
+	void moveAliens(); //move alien tick
+	void enemyShoot(); //enemy shooting
+	void changeAlienSpeed(); //change enemy movement tick speed
+	void checkAlienLives(); //check if all aliens are dead
+	void resetEnemies(); //reset enemies to start positions
+
+	//mothership
+	void deployMothership(); //enable and move mothership
+	void playAlarm(); //request alarm sound
+
+	//bullets
+	void moveBullets(); //move player and enemy bullets
+
+	//player
+	void deathDelay(); //delay when player loses a life
+
+	//collisions
+	void checkCollision(); // check if aliens have been shot
+	void checkBarrierCollision(); //check if barrier has been shot
+	void checkPlayerCollision(); //check if player has been shot
+	void checkMothershipCollision(); //check if mothership has been shot
+
+	//events
+	void publish(GameEventType type, const Position& at, int index = 0,
+		int value = 0); //queue event at an actor's position
+	void onShotMissed(const GameEvent* batch, int count); //reset multiplier
+	void onScored(const GameEvent* batch, int count); //add kill scores
+	void onWaveCleared(const GameEvent* batch, int count); //bonus life
+	void onPlayerHit(const GameEvent* batch, int count); //lose a life
+
+	int randomInt(int max); //uniform random number in [0, max]
+
+	template<typename Func>
+	void forRange(int begin, int end, Func func); //parallel for if possible
+
+	JobSystem* jobs = nullptr; //optional job system
+
+	//tick time
+	float time_difference =        0;
+
+	//delay counter for death
+	float death_counter =          0;
+
+	//time counter for spawning mothership
+	float mothership_spawn_timer = 0;
+
+	//tick counter to move alien enemies
+	float alien_move_counter =     0;
+
+	//seconds between enemy movement ticks
+	float alien_move_speed =       0.4;
+
+	//delay on playing alarm sound
+	float alarm_counter =          0.75;
+
+	//enemy shooting frequency
+	int alien_shoot_speed =        20000;
+
+	//formation, difficulty curve and scores
+	WaveTable waves;
+
+	//lowest living alien of each column, the only ones that shoot
+	FrontLine front_line;
+
+	//solid pixels bullets hit, aliens by their row's sprite
+	const HitMask* alien_masks[2] = {};
+	const HitMask* mothership_mask = nullptr;
+	const HitMask* player_mask =     nullptr;
+
+	//random number state, xorshift so it can be seeded and copied
+	uint32_t rng_state =           1;
+
+	//updates since reset
+	uint32_t frame =               0;
+};
@@ -0,0 +1,77 @@
+#include "HitMask.h"
+#include "HitMasks.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HIT_MASK_SSE 1
+#include <emmintrin.h>
+#endif
+
+const HitMask& getHitMask(Asset texture)
+{
+	static const HitMask NONE = { ASSET_COUNT, 0, 0, 0, 0, nullptr };
+
+	for (const HitMask& mask : HIT_MASKS)
+	{
+		if (mask.texture == texture)
+		{
+			return mask;
+		}
+	}
+
+	return NONE;
+}
+
+
+
+bool hitTest(const HitMask& mask, int x, int y, int left, int top,
+	int right, int bottom)
+{
+	//box into mask space, clipped to the tight box
+	int first_column = std::max(left - x - mask.left, 0);
+	int last_column = std::min(right - x - mask.left, mask.width - 1);
+	int first_row = std::max(top - y - mask.top, 0);
+	int last_row = std::min(bottom - y - mask.top, mask.height - 1);
+
+	if ((first_column > last_column) || (first_row > last_row))
+	{
+		return false;
+	}
+
+	int span = last_column - first_column + 1;
+	uint64_t columns = (span == 64) ? ~0ull :
+		(((1ull << span) - 1) << first_column);
+
+	const uint64_t* row = mask.rows + first_row;
+	int count = last_row - first_row + 1;
+	int i = 0;
+
+#ifdef HIT_MASK_SSE
+	//two rows at a time, set epi32 as 64 bit sets aren't on every x86
+	__m128i wanted = _mm_set_epi32((int)(columns >> 32), (int)columns,
+		(int)(columns >> 32), (int)columns);
+	__m128i any = _mm_setzero_si128();
+
+	for (; i + 2 <= count; i += 2)
+	{
+		__m128i pair = _mm_loadu_si128((const __m128i*)(row + i));
+		any = _mm_or_si128(any, _mm_and_si128(pair, wanted));
+	}
+
+	if (_mm_movemask_epi8(_mm_cmpeq_epi8(any, _mm_setzero_si128())) != 0xFFFF)
+	{
+		return true;
+	}
+#endif
+
+	for (; i < count; i++)
+	{
+		if (row[i] & columns)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
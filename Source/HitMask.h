@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+
+#include "AssetRegistry.h"
+
+/** @file HitMask.h
+    @brief   Pixel accurate hits against a texture's solid pixels.
+    @details Each solid texture has the tight box around its opaque pixels
+             and a bit per pixel inside it, generated from its alpha by
+             Tools/TextureImporter at the size the texture is drawn. A test
+             clips the box it is given to the tight box first, most misses
+             stop there, and only then ANDs the rows they share with the
+             box's columns.
+*/
+
+constexpr int HIT_MASK_MAX = 64; /**< widest and tallest mask, pixels */
+
+/** @struct HitMask
+*   @brief solid pixels of a texture drawn at its scale
+*/
+struct HitMask
+{
+	Asset texture;
+	int16_t left;         /**< tight box, pixels from the sprite's top left */
+	int16_t top;
+	int16_t width;
+	int16_t height;
+	const uint64_t* rows; /**< one per row of the box, bit n is n from its left */
+};
+
+//mask of a solid texture, one that never hits if it has none
+const HitMask& getHitMask(Asset texture);
+
+//does the inclusive box from left, top to right, bottom cover a solid
+//pixel of mask drawn with its top left at x and y
+bool hitTest(const HitMask& mask, int x, int y, int left, int top,
+	int right, int bottom);
@@ -0,0 +1,133 @@
+#pragma once
+#include "HitMask.h"
+
+/** @file HitMasks.h
+    @brief   Solid pixels of the solid textures, generated by
+             Tools/TextureImporter.
+    @details Do not edit, the build regenerates this from the textures
+             marked solid in TextureScales.h, at the size each is drawn.
+             A pixel is solid from half opacity up. Only HitMask.cpp
+             includes it.
+*/
+
+constexpr uint64_t HIT_ROWS_ALIEN1[21] =
+{
+	0x000000000e003800ull,
+	0x000000000e003800ull,
+	0x000000000e003800ull,
+	0x000000001f007c00ull,
+	0x00000000ffffff80ull,
+	0x00000000ffffff80ull,
+	0x00000000ffffff80ull,
+	0x00000007f1ffc7f0ull,
+	0x00000007f1ffc7f0ull,
+	0x00000007f1ffc7f0ull,
+	0x0000000ff1ffc7f8ull,
+	0x0000007fffffffffull,
+	0x0000007fffffffffull,
+	0x0000007fffffffffull,
+	0x00000078ffffff8full,
+	0x00000078ffffff8full,
+	0x00000078ffffff8full,
+	0x00000078f000078full,
+	0x00000078f000078full,
+	0x00000078f000078full,
+	0x00000078f000078full
+};
+
+constexpr uint64_t HIT_ROWS_ALIEN2[24] =
+{
+	0x00000000000ff000ull,
+	0x00000000000ff000ull,
+	0x00000000000ff000ull,
+	0x00000000000ff000ull,
+	0x0000000000ffff00ull,
+	0x0000000000ffff00ull,
+	0x0000000000ffff00ull,
+	0x0000000000ffff00ull,
+	0x000000000ffffff0ull,
+	0x000000000ffffff0ull,
+	0x000000000ffffff0ull,
+	0x000000000ffffff0ull,
+	0x00000000ff0ff0ffull,
+	0x00000000ff0ff0ffull,
+	0x00000000ff0ff0ffull,
+	0x00000000ff0ff0ffull,
+	0x00000000ffffffffull,
+	0x00000000ffffffffull,
+	0x00000000ffffffffull,
+	0x00000000ffffffffull,
+	0x0000000000f00f00ull,
+	0x0000000000f00f00ull,
+	0x0000000000f00f00ull,
+	0x0000000000f00f00ull
+};
+
+constexpr uint64_t HIT_ROWS_PLAYER[32] =
+{
+	0x0000000007000000ull,
+	0x0000000007000000ull,
+	0x0000000007000000ull,
+	0x0000000007000000ull,
+	0x000000007ff00000ull,
+	0x000000007ff00000ull,
+	0x000000007ff00000ull,
+	0x000000007ff00000ull,
+	0x000000007ff00000ull,
+	0x000000007ff00000ull,
+	0x000000007ff00000ull,
+	0x000000007ff00000ull,
+	0x00007ffffffffff0ull,
+	0x00007ffffffffff0ull,
+	0x00007ffffffffff0ull,
+	0x00007ffffffffff0ull,
+	0x0007ffffffffffffull,
+	0x0007ffffffffffffull,
+	0x0007ffffffffffffull,
+	0x0007ffffffffffffull,
+	0x0007ffffffffffffull,
+	0x0007ffffffffffffull,
+	0x0007ffffffffffffull,
+	0x0007ffffffffffffull,
+	0x0007ffffffffffffull,
+	0x0007ffffffffffffull,
+	0x0007ffffffffffffull,
+	0x0007ffffffffffffull,
+	0x0007ffffffffffffull,
+	0x0007ffffffffffffull,
+	0x0007ffffffffffffull,
+	0x0007ffffffffffffull
+};
+
+constexpr uint64_t HIT_ROWS_SPACESHIP[21] =
+{
+	0x00000003ffff8000ull,
+	0x00000003ffff8000ull,
+	0x00000003ffff8000ull,
+	0x000000fffffffe00ull,
+	0x000000fffffffe00ull,
+	0x000000fffffffe00ull,
+	0x000007ffffffffc0ull,
+	0x000007ffffffffc0ull,
+	0x000007ffffffffc0ull,
+	0x00003f1f87c3f1f8ull,
+	0x00003f1f87c3f1f8ull,
+	0x00003f1f87c3f1f8ull,
+	0x0001ffffffffffffull,
+	0x0001ffffffffffffull,
+	0x0001ffffffffffffull,
+	0x000007fc07c07fc0ull,
+	0x000007fc07c07fc0ull,
+	0x000007fc07c07fc0ull,
+	0x000000e000000e00ull,
+	0x000000e000000e00ull,
+	0x000000e000000e00ull
+};
+
+constexpr HitMask HIT_MASKS[] =
+{
+	{ TEXTURE_ALIEN1, 0, 0, 39, 21, HIT_ROWS_ALIEN1 },
+	{ TEXTURE_ALIEN2, 0, 0, 32, 24, HIT_ROWS_ALIEN2 },
+	{ TEXTURE_PLAYER, 0, 0, 51, 32, HIT_ROWS_PLAYER },
+	{ TEXTURE_SPACESHIP, 0, 0, 49, 21, HIT_ROWS_SPACESHIP }
+};
@@ -0,0 +1,207 @@
+#include "HotReload.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	bool readFile(const std::string& path, std::vector<uint8_t>& bytes)
+	{
+		std::ifstream file(path, std::ios::binary);
+
+		if (!file)
+		{
+			return false;
+		}
+
+		bytes.assign(std::istreambuf_iterator<char>(file),
+			std::istreambuf_iterator<char>());
+
+		return true;
+	}
+
+
+
+	//a png ends with an empty IEND chunk and its crc
+	bool isPngComplete(const std::vector<uint8_t>& bytes)
+	{
+		return (bytes.size() >= 20) &&
+			(memcmp(bytes.data() + bytes.size() - 8, "IEND", 4) == 0);
+	}
+
+
+
+	//a jpeg ends with an end of image marker
+	bool isJpegComplete(const std::vector<uint8_t>& bytes)
+	{
+		return (bytes.size() >= 4) && (bytes[bytes.size() - 2] == 0xFF) &&
+			(bytes[bytes.size() - 1] == 0xD9);
+	}
+
+
+
+	//riff size covers the rest of the file
+	bool isWavComplete(const std::vector<uint8_t>& bytes)
+	{
+		if ((bytes.size() < 12) || (memcmp(bytes.data(), "RIFF", 4) != 0))
+		{
+			return false;
+		}
+
+		uint32_t riff_size = bytes[4] | (bytes[5] << 8) | (bytes[6] << 16) |
+			((uint32_t)bytes[7] << 24);
+
+		return (size_t)riff_size + 8 <= bytes.size();
+	}
+}
+
+
+
+HotReload::~HotReload()
+{
+	//the watcher's thread uses everything below
+	watcher.stop();
+}
+
+
+
+bool HotReload::start(const std::vector<std::string>& directories)
+{
+	return watcher.start(directories,
+		[this](const std::string& root, const std::string& name)
+	{
+		onChange(root, name);
+	});
+}
+
+
+
+void HotReload::stop()
+{
+	watcher.stop();
+
+	std::lock_guard<std::mutex> lock(mutex);
+	prepared.clear();
+	pending = false;
+}
+
+
+
+const bool HotReload::collect(std::vector<AssetReload>& ready)
+{
+	//checked every frame, nearly always empty
+	if (!pending)
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	ready.swap(prepared);
+	prepared.clear();
+	pending = false;
+
+	return !ready.empty();
+}
+
+
+
+void HotReload::onChange(const std::string& root, const std::string& name)
+{
+	//only assets the game uses, a handful of string compares per save
+	int asset = -1;
+
+	for (int i = 0; i < ASSET_COUNT; i++)
+	{
+		if (name == ASSET_INFO[i].name)
+		{
+			asset = i;
+			break;
+		}
+	}
+
+	if (asset < 0)
+	{
+		return;
+	}
+
+	AssetReload reload;
+	reload.asset = (Asset)asset;
+	reload.path = (fs::path(root) / name).make_preferred().string();
+
+	std::vector<uint8_t> bytes;
+
+	if (!readFile(reload.path, bytes))
+	{
+		return;
+	}
+
+	bool ready = false;
+
+	switch (ASSET_INFO[asset].format)
+	{
+	case AssetFormat::PNG:
+		ready = isPngComplete(bytes);
+		break;
+
+	case AssetFormat::JPEG:
+		ready = isJpegComplete(bytes);
+		break;
+
+	case AssetFormat::WAV:
+		ready = isWavComplete(bytes);
+		reload.data.swap(bytes);
+		break;
+
+	default:
+		break;
+	}
+
+	//the text config is compiled here instead of waiting for a rebuild
+	if (asset == DATA_CONFIG_WAVES)
+	{
+		std::string error;
+		std::string text(bytes.begin(), bytes.end());
+
+		ready = parseWaves(text, reload.waves, error);
+
+		if (!ready)
+		{
+			std::cout << name << ": " << error << "\n";
+		}
+	}
+
+	else if (asset == DATA_WAVES)
+	{
+		ready = (bytes.size() >= sizeof(WaveTable));
+
+		if (ready)
+		{
+			memcpy(&reload.waves, bytes.data(), sizeof(WaveTable));
+			ready = isWaveTableValid(reload.waves);
+		}
+	}
+
+	if (!ready)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	//a newer copy of the same file replaces one not yet collected
+	for (AssetReload& waiting : prepared)
+	{
+		if (waiting.asset == reload.asset)
+		{
+			waiting = std::move(reload);
+			return;
+		}
+	}
+
+	prepared.push_back(std::move(reload));
+	pending = true;
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "AssetRegistry.h"
+#include "FileWatcher.h"
+#include "WaveConfig.h"
+
+/** @file HotReload.h
+    @brief   Picks up assets edited while the game is running.
+    @details Files written under the watched Resources directories are
+             matched to their Asset and prepared on the watcher's thread.
+             Textures are checked to be complete, sounds are read into
+             memory and wave config is parsed and validated. The prepared
+             reloads wait until the game collects them between frames,
+             where each is swapped in with one load or one pointer change.
+             A file caught half written fails its checks and is simply
+             picked up again on the write that finishes it.
+*/
+
+/** @struct AssetReload
+*   @brief one changed asset, ready to be swapped in
+*/
+struct AssetReload
+{
+	Asset asset;               /**< what changed */
+	std::string path;          /**< native path of the new file */
+	std::vector<uint8_t> data; /**< sounds only, the whole file */
+	WaveTable waves = {};      /**< wave config only, parsed and valid */
+};
+
+class HotReload
+{
+public:
+	HotReload() = default;
+	~HotReload();
+
+	//watch directories, false if none of them exist
+	bool start(const std::vector<std::string>& directories);
+	void stop(); //stop watching, pending reloads are dropped
+
+	//move prepared reloads into ready, false if there are none
+	const bool collect(std::vector<AssetReload>& ready);
+
+private:
+	void onChange(const std::string& root, const std::string& name);
+
+	FileWatcher watcher;
+
+	std::mutex mutex; //guards prepared
+	std::vector<AssetReload> prepared;
+	std::atomic<bool> pending{ false }; //anything in prepared
+};
@@ -0,0 +1,253 @@
+#include "JobSystem.h"
+
+#include <chrono>
+
+namespace
+{
+	//deque owned by the current thread within its job system
+	thread_local const JobSystem* current_system = nullptr;
+	thread_local int current_queue = 0;
+}
+
+
+
+const bool JobCounter::isDone()
+{
+	return pending.load(std::memory_order_acquire) == 0;
+}
+
+
+
+JobSystem::JobSystem(int worker_count)
+{
+	if (worker_count < 0)
+	{
+		int hardware = (int)std::thread::hardware_concurrency();
+		worker_count = std::max(hardware - 1, 0);
+	}
+
+	//queue 0 belongs to the thread that owns the system
+	for (int i = 0; i < worker_count + 1; i++)
+	{
+		queues.push_back(std::make_unique<Queue>());
+	}
+
+	current_system = this;
+	current_queue = 0;
+
+	for (int i = 0; i < worker_count; i++)
+	{
+		workers.emplace_back(&JobSystem::workerLoop, this, i + 1);
+	}
+}
+
+
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> guard(sleep_lock);
+		running = false;
+	}
+
+	wake.notify_all();
+
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+
+	if (current_system == this)
+	{
+		current_system = nullptr;
+	}
+}
+
+
+
+void JobSystem::run(std::function<void()> task, JobCounter& counter)
+{
+	counter.pending.fetch_add(1, std::memory_order_relaxed);
+
+	push({ std::move(task), &counter });
+}
+
+
+
+void JobSystem::runAfter(JobCounter& dependency, std::function<void()> task,
+	JobCounter& counter)
+{
+	counter.pending.fetch_add(1, std::memory_order_relaxed);
+
+	{
+		std::lock_guard<std::mutex> guard(dependency.lock);
+
+		//park the job until the dependency finishes
+		if (!dependency.isDone())
+		{
+			dependency.waiting.push_back({ std::move(task), &counter });
+			return;
+		}
+	}
+
+	push({ std::move(task), &counter });
+}
+
+
+
+void JobSystem::wait(JobCounter& counter)
+{
+	Job job;
+
+	while (!counter.isDone())
+	{
+		if (pop(job))
+		{
+			execute(job);
+		}
+
+		else
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	//the job that finished it may still hold the lock, don't hand the
+	//counter back until it has let go
+	std::lock_guard<std::mutex> guard(counter.lock);
+}
+
+
+
+const int JobSystem::getWorkerCount()
+{
+	return (int)workers.size();
+}
+
+
+
+int JobSystem::queueIndex()
+{
+	//threads outside the system share the owner's deque
+	return current_system == this ? current_queue : 0;
+}
+
+
+
+void JobSystem::push(Job job)
+{
+	Queue& queue = *queues[queueIndex()];
+
+	{
+		std::lock_guard<std::mutex> guard(queue.lock);
+		queue.jobs.push_back(std::move(job));
+	}
+
+	queued.fetch_add(1, std::memory_order_release);
+
+	if (!workers.empty())
+	{
+		wake.notify_one();
+	}
+}
+
+
+
+bool JobSystem::pop(Job& job)
+{
+	if (queued.load(std::memory_order_acquire) == 0)
+	{
+		return false;
+	}
+
+	int own = queueIndex();
+
+	//newest job from our own deque keeps its data warm in cache
+	{
+		Queue& queue = *queues[own];
+		std::lock_guard<std::mutex> guard(queue.lock);
+
+		if (!queue.jobs.empty())
+		{
+			job = std::move(queue.jobs.back());
+			queue.jobs.pop_back();
+			queued.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+
+	//otherwise steal the oldest job from someone else
+	int count = (int)queues.size();
+
+	for (int i = 1; i < count; i++)
+	{
+		Queue& queue = *queues[(own + i) % count];
+		std::lock_guard<std::mutex> guard(queue.lock);
+
+		if (!queue.jobs.empty())
+		{
+			job = std::move(queue.jobs.front());
+			queue.jobs.pop_front();
+			queued.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+
+void JobSystem::execute(Job& job)
+{
+	job.task();
+
+	JobCounter* counter = job.counter;
+	std::vector<JobCounter::Continuation> ready;
+
+	//the last decrement and taking the continuations happen under the
+	//lock wait() takes before returning, so the counter, often on the
+	//waiter's stack, outlives this
+	{
+		std::lock_guard<std::mutex> guard(counter->lock);
+
+		if (counter->pending.fetch_sub(1, std::memory_order_acq_rel) != 1)
+		{
+			return;
+		}
+
+		//last job in the group, release anything waiting on it
+		ready.swap(counter->waiting);
+	}
+
+	for (auto& continuation : ready)
+	{
+		push({ std::move(continuation.task), continuation.counter });
+	}
+}
+
+
+
+void JobSystem::workerLoop(int index)
+{
+	current_system = this;
+	current_queue = index;
+
+	Job job;
+
+	while (running)
+	{
+		if (pop(job))
+		{
+			execute(job);
+			continue;
+		}
+
+		//nothing to do, sleep until more work is pushed
+		std::unique_lock<std::mutex> guard(sleep_lock);
+		wake.wait_for(guard, std::chrono::milliseconds(1), [this]()
+		{
+			return !running || queued.load(std::memory_order_acquire) > 0;
+		});
+	}
+}
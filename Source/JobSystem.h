@@ -0,0 +1,137 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** @file JobSystem.h
+    @brief   Work-stealing job scheduler used to fan out per tick work.
+    @details Every worker (and the thread that created the system) owns a
+             deque. Jobs are pushed onto the submitting thread's deque and
+             popped from its back, idle workers steal from the front of
+             the others. Completion is tracked with JobCounters which can
+             also gate dependent jobs, and waiting on a counter executes
+             other jobs instead of blocking.
+*/
+
+class JobSystem;
+
+/**
+*   Tracks a group of jobs. Reaches zero once every job run against it
+*   has finished, at which point any jobs queued with runAfter start.
+*/
+class JobCounter
+{
+public:
+	JobCounter() = default;
+	~JobCounter() = default;
+
+	JobCounter(const JobCounter&) = delete;
+	JobCounter& operator=(const JobCounter&) = delete;
+
+	const bool isDone(); //have all jobs finished
+
+private:
+	friend class JobSystem;
+
+	struct Continuation
+	{
+		std::function<void()> task;
+		JobCounter* counter;
+	};
+
+	std::atomic<int> pending { 0 };     //unfinished jobs
+	std::mutex lock;                    //guards continuations and the last decrement
+	std::vector<Continuation> waiting;  //jobs started when pending hits zero
+};
+
+class JobSystem
+{
+public:
+	//negative worker count uses one per spare hardware thread
+	explicit JobSystem(int worker_count = -1);
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	//queue a job, counter is decremented when it finishes
+	void run(std::function<void()> task, JobCounter& counter);
+
+	//queue a job that only starts once dependency has finished
+	void runAfter(JobCounter& dependency, std::function<void()> task,
+		JobCounter& counter);
+
+	//run other jobs until counter reaches zero
+	void wait(JobCounter& counter);
+
+	//split [begin, end) into chunks of grain and run func(first, last)
+	//on each, ranges no bigger than grain run inline on the caller
+	template<typename Func>
+	void parallelFor(int begin, int end, int grain, Func func);
+
+	const int getWorkerCount(); //number of background workers
+
+private:
+	struct Job
+	{
+		std::function<void()> task;
+		JobCounter* counter;
+	};
+
+	struct Queue
+	{
+		std::mutex lock;
+		std::deque<Job> jobs;
+	};
+
+	void push(Job job); //push onto this thread's deque
+	bool pop(Job& job); //own deque first, then steal
+	void execute(Job& job); //run job and release dependants
+	void workerLoop(int index); //background worker body
+	int queueIndex(); //deque owned by the calling thread
+
+	std::vector<std::unique_ptr<Queue>> queues; //one per thread, 0 = owner
+	std::vector<std::thread> workers;           //background workers
+	std::atomic<bool> running { true };         //cleared on shutdown
+	std::atomic<int> queued { 0 };              //jobs sitting in deques
+	std::mutex sleep_lock;                      //guards wake
+	std::condition_variable wake;               //idle workers sleep here
+};
+
+
+
+template<typename Func>
+void JobSystem::parallelFor(int begin, int end, int grain, Func func)
+{
+	grain = std::max(grain, 1);
+
+	//small ranges aren't worth handing to another thread
+	if ((end - begin <= grain) || workers.empty())
+	{
+		func(begin, end);
+		return;
+	}
+
+	JobCounter counter;
+
+	for (int first = begin + grain; first < end; first += grain)
+	{
+		int last = std::min(first + grain, end);
+
+		run([&func, first, last]()
+		{
+			func(first, last);
+		}, counter);
+	}
+
+	//caller takes the first chunk itself
+	func(begin, begin + grain);
+
+	wait(counter);
+}
@@ -0,0 +1,196 @@
+#include "LoadQueue.h"
+
+#include <iostream>
+
+LoadQueue::LoadQueue()
+	: created(Clock::now())
+{
+
+}
+
+
+
+LoadQueue::~LoadQueue()
+{
+	//background steps may still reference the game
+	joinBackground();
+}
+
+
+
+void LoadQueue::add(const char* name, std::function<void()> task)
+{
+	steps.push_back({ name, std::move(task) });
+}
+
+
+
+void LoadQueue::addBackground(const char* name, std::function<bool()> task)
+{
+	Clock::time_point started = Clock::now();
+
+	Background job;
+	job.name = name;
+	job.result = std::async(std::launch::async, [task, started]()
+	{
+		bool succeeded = task();
+		std::chrono::duration<float> elapsed = Clock::now() - started;
+
+		return Result{ succeeded, elapsed.count() };
+	});
+
+	background.push_back(std::move(job));
+}
+
+
+
+bool LoadQueue::process(float budget_seconds)
+{
+	auto start = Clock::now();
+
+	//always make progress, even on a slow frame
+	while (!steps.empty())
+	{
+		Step step = std::move(steps.front());
+		steps.pop_front();
+
+		runStep(step);
+
+		std::chrono::duration<float> spent = Clock::now() - start;
+		if (spent.count() >= budget_seconds)
+		{
+			break;
+		}
+	}
+
+	if (!steps.empty())
+	{
+		return false;
+	}
+
+	//background work is polled so the main thread never blocks on it
+	for (auto& job : background)
+	{
+		if (job.result.valid() && job.result.wait_for(
+			std::chrono::seconds(0)) != std::future_status::ready)
+		{
+			return false;
+		}
+	}
+
+	joinBackground();
+	report();
+
+	return true;
+}
+
+
+
+void LoadQueue::finish()
+{
+	while (!steps.empty())
+	{
+		Step step = std::move(steps.front());
+		steps.pop_front();
+
+		runStep(step);
+	}
+
+	joinBackground();
+	report();
+}
+
+
+
+void LoadQueue::cancel()
+{
+	steps.clear();
+	joinBackground();
+}
+
+
+
+const bool LoadQueue::isDone()
+{
+	return steps.empty() && background.empty();
+}
+
+
+
+void LoadQueue::markInteractive()
+{
+	if (interactive_time < 0)
+	{
+		std::chrono::duration<float> elapsed = Clock::now() - created;
+		interactive_time = elapsed.count();
+	}
+}
+
+
+
+void LoadQueue::runStep(Step& step)
+{
+	auto start = Clock::now();
+
+	step.task();
+
+	std::chrono::duration<float> elapsed = Clock::now() - start;
+
+	main_thread_time += elapsed.count();
+	steps_run++;
+
+	if (elapsed.count() > longest_step_time)
+	{
+		longest_step_time = elapsed.count();
+		longest_step = step.name;
+	}
+}
+
+
+
+void LoadQueue::joinBackground()
+{
+	for (auto& job : background)
+	{
+		if (!job.result.valid())
+		{
+			continue;
+		}
+
+		Result result = job.result.get();
+
+		if (!reported)
+		{
+			std::cout << "startup: " << job.name <<
+				(result.succeeded ? " ready after " : " failed after ") <<
+				result.seconds * 1000 << " ms\n";
+		}
+	}
+
+	background.clear();
+}
+
+
+
+void LoadQueue::report()
+{
+	if (reported)
+	{
+		return;
+	}
+
+	reported = true;
+
+	std::chrono::duration<float> total = Clock::now() - created;
+
+	if (interactive_time >= 0)
+	{
+		std::cout << "startup: menu interactive after " <<
+			interactive_time * 1000 << " ms\n";
+	}
+
+	std::cout << "startup: all assets ready after " << total.count() * 1000 <<
+		" ms (" << steps_run << " main thread steps, " <<
+		main_thread_time * 1000 << " ms total, longest " << longest_step <<
+		" " << longest_step_time * 1000 << " ms)\n";
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <future>
+#include <string>
+#include <vector>
+
+/** @file LoadQueue.h
+    @brief   Incremental asset loading spread over several frames.
+    @details Anything that has to touch the renderer (ASGE decodes and
+             uploads textures inside Sprite::loadTexture) is queued here and
+             run on the main thread a few milliseconds per frame, so the menu
+             stays responsive while the rest of the game loads. Work that
+             doesn't need the renderer is handed to background threads with
+             addBackground() and joined in finish().
+*/
+
+class LoadQueue
+{
+public:
+	LoadQueue();
+	~LoadQueue();
+
+	using Clock = std::chrono::steady_clock;
+
+	//queue a main thread load step
+	void add(const char* name, std::function<void()> task);
+
+	//start a load step on a background thread
+	void addBackground(const char* name, std::function<bool()> task);
+
+	//run queued steps until the time budget is spent, true once all done
+	bool process(float budget_seconds);
+
+	//run everything that is left and wait for background work
+	void finish();
+
+	//drop pending steps and wait for background work
+	void cancel();
+
+	const bool isDone(); //all steps complete
+	void markInteractive(); //record first interactive frame time
+	void report(); //print start up timings
+
+private:
+	struct Step
+	{
+		std::string name;
+		std::function<void()> task;
+	};
+
+	struct Result
+	{
+		bool succeeded;   //what the task returned
+		float seconds;    //time from queueing to completion
+	};
+
+	struct Background
+	{
+		std::string name;
+		std::future<Result> result;
+	};
+
+	void runStep(Step& step); //run and time one step
+	void joinBackground(); //wait for background work
+
+	std::deque<Step> steps;              //pending main thread steps
+	std::vector<Background> background;  //running background steps
+
+	Clock::time_point created;           //queue creation time
+	float interactive_time = -1;         //seconds until first frame
+	float main_thread_time = 0;          //seconds spent in steps
+	float longest_step_time = 0;         //slowest single step
+	std::string longest_step;            //name of slowest step
+	int steps_run = 0;                   //steps completed
+	bool reported = false;               //report printed
+};
@@ -0,0 +1,307 @@
+#include "Lockstep.h"
+#include "Replay.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+	constexpr int HASH_MESSAGE = 12; //tick then hash
+}
+
+
+
+const bool Lockstep::host(uint16_t port)
+{
+	close();
+	hosting = true;
+
+	return listener.listen(port, 1);
+}
+
+
+
+const bool Lockstep::join(uint16_t port)
+{
+	close();
+	hosting = false;
+
+	Socket socket;
+
+	if (!socket.connect(port))
+	{
+		return false;
+	}
+
+	connection = Connection(std::move(socket));
+
+	return true;
+}
+
+
+
+void Lockstep::close()
+{
+	listener.close();
+	connection.close();
+	started = false;
+}
+
+
+
+void Lockstep::poll(GameWorld& world)
+{
+	//one peer only, the game starts from the host's world as it is now
+	if (hosting && !connection.isOpen() && listener.isOpen())
+	{
+		Socket socket = listener.accept();
+
+		if (socket.isOpen())
+		{
+			connection = Connection(std::move(socket));
+			listener.close();
+
+			GameSnapshot snapshot;
+			world.save(snapshot);
+			connection.send(MessageType::PEER_START,
+				(const uint8_t*)&snapshot, sizeof(snapshot));
+
+			start();
+		}
+	}
+
+	connection.poll();
+
+	MessageType type;
+	const uint8_t* data;
+	int size;
+
+	while (connection.receive(type, data, size))
+	{
+		if ((type == MessageType::PEER_START) && !hosting &&
+			(size == sizeof(GameSnapshot)))
+		{
+			GameSnapshot snapshot;
+			std::memcpy(&snapshot, data, sizeof(snapshot));
+
+			//the peer's formation has to be the same as ours
+			if (!world.restore(snapshot))
+			{
+				connection.close();
+				break;
+			}
+
+			start();
+		}
+
+		else if ((type == MessageType::PEER_INPUT) && started)
+		{
+			for (int i = 0; i < size; i++)
+			{
+				//further ahead than the delay allows, the stream is bad
+				if (remote_count - tick >= LOCKSTEP_WINDOW)
+				{
+					connection.close();
+					break;
+				}
+
+				remote_inputs[remote_count % LOCKSTEP_WINDOW] = data[i];
+				remote_count++;
+			}
+		}
+
+		else if ((type == MessageType::PEER_HASH) && started &&
+			(size == HASH_MESSAGE))
+		{
+			Check check;
+			std::memcpy(&check.tick, data, sizeof(check.tick));
+			std::memcpy(&check.hash, data + 4, sizeof(check.hash));
+
+			int slot = (check.tick / LOCKSTEP_CHECK_INTERVAL) % LOCKSTEP_CHECKS;
+			remote_checks[slot] = check;
+
+			if (local_checks[slot].tick == check.tick)
+			{
+				compare(check.tick);
+			}
+		}
+	}
+
+	connection.flush();
+}
+
+
+
+void Lockstep::setInput(const WorldInput& local)
+{
+	move = local.move;
+	shoot = shoot || local.shoot;
+}
+
+
+
+const bool Lockstep::nextInput(WorldInput& merged)
+{
+	if (!started)
+	{
+		return false;
+	}
+
+	//schedule this peer's input delay ticks ahead, once per tick
+	if (local_count <= tick + LOCKSTEP_DELAY)
+	{
+		WorldInput input;
+		input.move = move;
+		input.shoot = shoot;
+		shoot = false;
+
+		uint8_t bits = encodeInput(input);
+		local_inputs[local_count % LOCKSTEP_WINDOW] = bits;
+		local_count++;
+
+		connection.send(MessageType::PEER_INPUT, &bits, 1);
+		connection.flush();
+	}
+
+	if (tick >= remote_count)
+	{
+		return false;
+	}
+
+	merged = mergeInputs(decodeInput(local_inputs[tick % LOCKSTEP_WINDOW]),
+		decodeInput(remote_inputs[tick % LOCKSTEP_WINDOW]));
+
+	return true;
+}
+
+
+
+void Lockstep::endTick(GameWorld& world)
+{
+	tick++;
+
+	if ((tick % LOCKSTEP_CHECK_INTERVAL) != 0)
+	{
+		return;
+	}
+
+	int slot = (tick / LOCKSTEP_CHECK_INTERVAL) % LOCKSTEP_CHECKS;
+
+	world.save(checked[slot]);
+	local_checks[slot].tick = tick;
+	local_checks[slot].hash = hashSnapshot(checked[slot]);
+
+	uint8_t message[HASH_MESSAGE];
+	std::memcpy(message, &tick, sizeof(tick));
+	std::memcpy(message + 4, &local_checks[slot].hash, sizeof(uint64_t));
+
+	connection.send(MessageType::PEER_HASH, message, sizeof(message));
+	connection.flush();
+
+	if (remote_checks[slot].tick == tick)
+	{
+		compare(tick);
+	}
+}
+
+
+
+const bool Lockstep::isStarted()
+{
+	return started;
+}
+
+
+
+const bool Lockstep::isConnected()
+{
+	return connection.isOpen();
+}
+
+
+
+const bool Lockstep::isDesynced()
+{
+	return desynced;
+}
+
+
+
+const uint32_t Lockstep::getTick()
+{
+	return tick;
+}
+
+
+
+const uint16_t Lockstep::getPort()
+{
+	return listener.getPort();
+}
+
+
+
+const std::string& Lockstep::getDumpPath()
+{
+	return dump_path;
+}
+
+
+
+const uint64_t Lockstep::getBytesSent()
+{
+	return connection.getBytesSent();
+}
+
+
+
+void Lockstep::start()
+{
+	//the first delay ticks have no input from either side
+	std::memset(local_inputs, 0, sizeof(local_inputs));
+	std::memset(remote_inputs, 0, sizeof(remote_inputs));
+	local_count = LOCKSTEP_DELAY;
+	remote_count = LOCKSTEP_DELAY;
+	tick = 0;
+
+	std::fill(std::begin(local_checks), std::end(local_checks), Check());
+	std::fill(std::begin(remote_checks), std::end(remote_checks), Check());
+
+	started = true;
+	desynced = false;
+	dump_path.clear();
+	shoot = false;
+}
+
+
+
+void Lockstep::compare(uint32_t check_tick)
+{
+	int slot = (check_tick / LOCKSTEP_CHECK_INTERVAL) % LOCKSTEP_CHECKS;
+
+	if (!desynced && (local_checks[slot].hash != remote_checks[slot].hash))
+	{
+		desynced = true;
+		dump(check_tick);
+	}
+}
+
+
+
+void Lockstep::dump(uint32_t check_tick)
+{
+	int slot = (check_tick / LOCKSTEP_CHECK_INTERVAL) % LOCKSTEP_CHECKS;
+
+	//each side writes its own, diff the two to find what split
+	char name[64];
+	std::snprintf(name, sizeof(name), "desync_%s_%u.sav",
+		hosting ? "host" : "join", check_tick);
+
+	dump_path = name;
+
+	if (!saveSnapshot(name, checked[slot]))
+	{
+		dump_path.clear();
+	}
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+#include "Connection.h"
+#include "GameSnapshot.h"
+#include "GameWorld.h"
+
+/** @file Lockstep.h
+    @brief   Two peers stepping their own copy of one game on input alone.
+    @details The world is deterministic when stepped by a fixed time step,
+             so two worlds that start from the same snapshot and get the
+             same input every tick stay the same. The host sends its
+             snapshot once, after that the peers only swap a byte of input
+             per tick. Input is scheduled LOCKSTEP_DELAY ticks ahead so it
+             has time to arrive before it is needed, and a tick is only
+             stepped once both inputs for it are in. Every
+             LOCKSTEP_CHECK_INTERVAL ticks each peer sends the hash of its
+             state, and a mismatch writes that state to a desync dump to
+             compare against the other peer's.
+*/
+
+constexpr int LOCKSTEP_DELAY =          3;  /**< ticks input is scheduled ahead */
+constexpr int LOCKSTEP_CHECK_INTERVAL = 30; /**< ticks between state hashes */
+constexpr int LOCKSTEP_WINDOW =         64; /**< ticks of input held */
+constexpr int LOCKSTEP_CHECKS =         4;  /**< hashes held waiting for the peer's */
+
+static_assert(LOCKSTEP_WINDOW > 2 * LOCKSTEP_DELAY,
+	"a peer can be scheduled up to twice the delay ahead");
+
+class Lockstep
+{
+public:
+	Lockstep() = default;
+	~Lockstep() = default;
+
+	const bool host(uint16_t port); //wait for a peer on loopback
+	const bool join(uint16_t port); //peer hosting on loopback
+	void close();
+
+	//take the peer, its input and hashes, the host sends its world as
+	//the starting point when the peer arrives and the peer restores it
+	void poll(GameWorld& world);
+
+	//this frame's input, a shot is kept until it is scheduled
+	void setInput(const WorldInput& local);
+
+	//input of the next tick from both peers, false if the peer's hasn't
+	//arrived yet, in which case the tick has to wait
+	const bool nextInput(WorldInput& merged);
+
+	//after stepping the tick nextInput gave input for
+	void endTick(GameWorld& world);
+
+	const bool isStarted(); //both peers have the starting snapshot
+	const bool isConnected();
+	const bool isDesynced(); //a state hash didn't match the peer's
+	const uint32_t getTick(); //ticks stepped since the start
+	const uint16_t getPort(); //hosting port, the one picked by host(0)
+	const std::string& getDumpPath(); //desync dump, empty if none
+	const uint64_t getBytesSent();
+
+private:
+	struct Check
+	{
+		uint32_t tick = 0; //0 if the slot is empty
+		uint64_t hash = 0;
+	};
+
+	void start(); //reset tick and input history
+	void compare(uint32_t tick); //both hashes for tick are in
+	void dump(uint32_t tick); //write the state at tick
+
+	Socket listener;
+	Connection connection;
+	bool hosting = false;
+	bool started = false;
+	bool desynced = false;
+	std::string dump_path;
+
+	int move =   0;     //held move
+	bool shoot = false; //shot not yet scheduled
+
+	uint8_t local_inputs[LOCKSTEP_WINDOW] = {};  //encoded, by tick
+	uint8_t remote_inputs[LOCKSTEP_WINDOW] = {}; //encoded, by tick
+	uint32_t local_count =  0; //ticks with local input scheduled
+	uint32_t remote_count = 0; //ticks with the peer's input in
+	uint32_t tick =         0; //next tick to step
+
+	Check local_checks[LOCKSTEP_CHECKS];
+	Check remote_checks[LOCKSTEP_CHECKS];
+	GameSnapshot checked[LOCKSTEP_CHECKS]; //state each local hash is of
+};
@@ -0,0 +1,182 @@
+#include "ParticleSystem.h"
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PARTICLES_SSE 1
+#include <emmintrin.h>
+#endif
+
+static_assert((MAX_PARTICLES % 4 == 0) && (PARTICLE_GRAIN % 4 == 0),
+	"particle arrays are processed four floats at a time");
+
+ParticleSystem::ParticleSystem()
+{
+	//the vector loop reads up to three slots past the last particle
+	std::memset(x, 0, sizeof(x));
+	std::memset(y, 0, sizeof(y));
+	std::memset(velocity_x, 0, sizeof(velocity_x));
+	std::memset(velocity_y, 0, sizeof(velocity_y));
+	std::memset(life, 0, sizeof(life));
+}
+
+
+
+const int ParticleSystem::spawnBurst(float pos_x, float pos_y, int requested,
+	float speed, float lifetime)
+{
+	int free_slots = MAX_PARTICLES - count;
+	int spawned = requested;
+
+	//past half full, bursts shrink with what's left of the budget
+	if (count > MAX_PARTICLES / 2)
+	{
+		spawned = requested * free_slots / (MAX_PARTICLES / 2);
+	}
+
+	spawned = std::min(spawned, free_slots);
+	dropped += requested - spawned;
+
+	for (int i = 0; i < spawned; i++)
+	{
+		//xorshift, spread doesn't need to be any better than this
+		rng_state ^= rng_state << 13;
+		rng_state ^= rng_state >> 17;
+		rng_state ^= rng_state << 5;
+
+		float angle = (rng_state & 0xFFFF) * (6.2831853f / 65536.0f);
+		float scale = 0.25f + ((rng_state >> 16) & 0xFF) * (0.75f / 256.0f);
+		float age = 0.5f + ((rng_state >> 24) & 0xFF) * (0.5f / 256.0f);
+
+		int slot = count + i;
+		x[slot] = pos_x;
+		y[slot] = pos_y;
+		velocity_x[slot] = std::cos(angle) * speed * scale;
+		velocity_y[slot] = std::sin(angle) * speed * scale;
+		life[slot] = lifetime * age;
+	}
+
+	count += spawned;
+
+	return spawned;
+}
+
+
+
+void ParticleSystem::update(float dt, JobSystem* jobs)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	//round up, slots past count are spare and safe to overwrite
+	int end = (count + 3) & ~3;
+
+	//particles are independent, only retiring has to be in order
+	if (jobs)
+	{
+		jobs->parallelFor(0, end, PARTICLE_GRAIN, [this, dt](int first,
+			int last)
+		{
+			integrate(dt, first, last);
+		});
+	}
+
+	else
+	{
+		integrate(dt, 0, end);
+	}
+
+	retire();
+}
+
+
+
+void ParticleSystem::clear()
+{
+	count = 0;
+}
+
+
+
+const int ParticleSystem::getCount()
+{
+	return count;
+}
+
+
+
+const int ParticleSystem::getDropped()
+{
+	return dropped;
+}
+
+
+
+const float* ParticleSystem::getX()
+{
+	return x;
+}
+
+
+
+const float* ParticleSystem::getY()
+{
+	return y;
+}
+
+
+
+void ParticleSystem::integrate(float dt, int first, int last)
+{
+#ifdef PARTICLES_SSE
+	const __m128 step = _mm_set1_ps(dt);
+	const __m128 fall = _mm_set1_ps(PARTICLE_GRAVITY * dt);
+
+	for (int i = first; i < last; i += 4)
+	{
+		__m128 vy = _mm_add_ps(_mm_load_ps(velocity_y + i), fall);
+		__m128 vx = _mm_load_ps(velocity_x + i);
+
+		_mm_store_ps(velocity_y + i, vy);
+		_mm_store_ps(x + i, _mm_add_ps(_mm_load_ps(x + i), _mm_mul_ps(vx, step)));
+		_mm_store_ps(y + i, _mm_add_ps(_mm_load_ps(y + i), _mm_mul_ps(vy, step)));
+		_mm_store_ps(life + i, _mm_sub_ps(_mm_load_ps(life + i), step));
+	}
+#else
+	const float fall = PARTICLE_GRAVITY * dt;
+
+	for (int i = first; i < last; i++)
+	{
+		velocity_y[i] += fall;
+		x[i] += velocity_x[i] * dt;
+		y[i] += velocity_y[i] * dt;
+		life[i] -= dt;
+	}
+#endif
+}
+
+
+
+void ParticleSystem::retire()
+{
+	//walk backwards so the particle swapped in has already been checked
+	for (int i = count - 1; i >= 0; i--)
+	{
+		bool expired = (life[i] <= 0) || (y[i] > WINDOW_HEIGHT);
+
+		if (expired)
+		{
+			count--;
+			x[i] = x[count];
+			y[i] = y[count];
+			velocity_x[i] = velocity_x[count];
+			velocity_y[i] = velocity_y[count];
+			life[i] = life[count];
+		}
+	}
+}
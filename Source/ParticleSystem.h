@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+
+#include "Constants.h"
+
+class JobSystem;
+
+/** @file ParticleSystem.h
+    @brief   Pooled debris particles for explosions.
+    @details Particles are stored as separate position, velocity and
+             lifetime arrays sized once for MAX_PARTICLES, so a tick is a
+             few straight passes over floats that run four at a time where
+             SSE is available, split across jobs when there are enough
+             of them. Dead particles are swapped with the last
+             live one, keeping [0, getCount()) packed for rendering. Once
+             the pool is half full new bursts shrink with the space left
+             rather than failing outright, and a full pool drops them.
+*/
+
+class ParticleSystem
+{
+public:
+	ParticleSystem();
+	~ParticleSystem() = default;
+
+	ParticleSystem(const ParticleSystem&) = delete;
+	ParticleSystem& operator=(const ParticleSystem&) = delete;
+
+	//throw up to count particles out from x, y, returns how many fitted
+	const int spawnBurst(float x, float y, int count, float speed,
+		float lifetime);
+
+	//move particles and retire expired ones, moving spread over jobs
+	//if given
+	void update(float dt, JobSystem* jobs = nullptr);
+	void clear(); //remove every particle
+
+	const int getCount(); //live particles, packed from index 0
+	const int getDropped(); //particles refused by the budget, ever
+
+	const float* getX(); //live x positions
+	const float* getY(); //live y positions
+
+private:
+	//advance velocity, position and lifetime of [first, last), both
+	//multiples of 4
+	void integrate(float dt, int first, int last);
+	void retire(); //swap expired particles to the end
+
+	//structure of arrays, padded so the vector loop needs no tail
+	alignas(16) float x[MAX_PARTICLES];
+	alignas(16) float y[MAX_PARTICLES];
+	alignas(16) float velocity_x[MAX_PARTICLES];
+	alignas(16) float velocity_y[MAX_PARTICLES];
+	alignas(16) float life[MAX_PARTICLES];
+
+	int count =   0; //live particles
+	int dropped = 0; //refused spawns
+	uint32_t rng_state = 0x9E3779B9; //xorshift state for spread
+};
@@ -0,0 +1,164 @@
+#include "Poller.h"
+
+#include <algorithm>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+
+using pollfd = WSAPOLLFD;
+#else
+#include <poll.h>
+#endif
+
+#if defined(__linux__)
+
+Poller::Poller()
+	: epoll(epoll_create1(EPOLL_CLOEXEC))
+{
+}
+
+
+
+Poller::~Poller()
+{
+	if (epoll >= 0)
+	{
+		::close(epoll);
+	}
+}
+
+
+
+const bool Poller::add(SocketHandle handle, int id)
+{
+	epoll_event event = {};
+	event.events = EPOLLIN | EPOLLRDHUP;
+	event.data.u64 = (uint64_t)id;
+
+	return epoll_ctl(epoll, EPOLL_CTL_ADD, handle, &event) == 0;
+}
+
+
+
+void Poller::setWritable(SocketHandle handle, int id, bool writable)
+{
+	epoll_event event = {};
+	event.events = EPOLLIN | EPOLLRDHUP | (writable ? (uint32_t)EPOLLOUT : 0u);
+	event.data.u64 = (uint64_t)id;
+
+	epoll_ctl(epoll, EPOLL_CTL_MOD, handle, &event);
+}
+
+
+
+void Poller::remove(SocketHandle handle)
+{
+	epoll_event event = {};
+	epoll_ctl(epoll, EPOLL_CTL_DEL, handle, &event);
+}
+
+
+
+const int Poller::wait(PollEvent* events, int capacity, int timeout)
+{
+	epoll_event ready[POLL_BATCH];
+	int count = epoll_wait(epoll, ready, std::min(capacity, POLL_BATCH),
+		timeout);
+
+	for (int i = 0; i < count; i++)
+	{
+		events[i].id = (int)ready[i].data.u64;
+		events[i].readable = (ready[i].events & (EPOLLIN | EPOLLRDHUP)) != 0;
+		events[i].writable = (ready[i].events & EPOLLOUT) != 0;
+		events[i].closed = (ready[i].events & (EPOLLERR | EPOLLHUP)) != 0;
+	}
+
+	return std::max(count, 0);
+}
+
+#else
+
+Poller::Poller()
+{
+}
+
+
+
+Poller::~Poller()
+{
+}
+
+
+
+const bool Poller::add(SocketHandle handle, int id)
+{
+	watches.push_back({ handle, id, false });
+	return true;
+}
+
+
+
+void Poller::setWritable(SocketHandle handle, int id, bool writable)
+{
+	for (Watch& watch : watches)
+	{
+		if (watch.handle == handle)
+		{
+			watch.writable = writable;
+		}
+	}
+}
+
+
+
+void Poller::remove(SocketHandle handle)
+{
+	watches.erase(std::remove_if(watches.begin(), watches.end(),
+		[handle](const Watch& watch) { return watch.handle == handle; }),
+		watches.end());
+}
+
+
+
+const int Poller::wait(PollEvent* events, int capacity, int timeout)
+{
+	//no readiness list to keep, every socket is asked each time
+	std::vector<pollfd> fds(watches.size());
+
+	for (size_t i = 0; i < watches.size(); i++)
+	{
+		fds[i].fd = watches[i].handle;
+		fds[i].events = POLLIN | (watches[i].writable ? POLLOUT : 0);
+		fds[i].revents = 0;
+	}
+
+#if defined(_WIN32)
+	int ready = WSAPoll(fds.data(), (ULONG)fds.size(), timeout);
+#else
+	int ready = ::poll(fds.data(), fds.size(), timeout);
+#endif
+
+	int count = 0;
+
+	for (size_t i = 0; (ready > 0) && (i < fds.size()) && (count < capacity); i++)
+	{
+		if (fds[i].revents == 0)
+		{
+			continue;
+		}
+
+		events[count].id = watches[i].id;
+		events[count].readable = (fds[i].revents & POLLIN) != 0;
+		events[count].writable = (fds[i].revents & POLLOUT) != 0;
+		events[count].closed = (fds[i].revents & (POLLERR | POLLHUP)) != 0;
+		count++;
+	}
+
+	return count;
+}
+
+#endif
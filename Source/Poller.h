@@ -0,0 +1,59 @@
+#pragma once
+#include <vector>
+
+#include "Socket.h"
+
+/** @file Poller.h
+    @brief   Waits on many sockets at once.
+    @details Sockets are added with an id and wait() reports the ids of
+             those that can be read, written or have closed. Reading is
+             always watched, writing only when asked for, which is only
+             worth it while a socket's send queue is full. On Linux this
+             is epoll, so a wait costs what is ready rather than what is
+             watched, elsewhere poll and WSAPoll stand in.
+*/
+
+constexpr int POLL_BATCH = 256; /**< events taken from the kernel per call */
+
+/** @struct PollEvent
+*   @brief what happened to one watched socket
+*/
+struct PollEvent
+{
+	int id;        /**< given to add */
+	bool readable; /**< data waiting, or the peer closed */
+	bool writable; /**< room to send, only if watched */
+	bool closed;   /**< hung up or failed */
+};
+
+class Poller
+{
+public:
+	Poller();
+	~Poller();
+
+	Poller(const Poller&) = delete;
+	Poller& operator=(const Poller&) = delete;
+
+	const bool add(SocketHandle handle, int id); //watch for reading
+	void setWritable(SocketHandle handle, int id, bool writable);
+	void remove(SocketHandle handle); //before the socket is closed
+
+	//wait up to timeout ms, 0 to not wait, fills at most capacity events
+	//and returns how many
+	const int wait(PollEvent* events, int capacity, int timeout);
+
+private:
+#if defined(__linux__)
+	int epoll = -1; //epoll instance
+#else
+	struct Watch
+	{
+		SocketHandle handle;
+		int id;
+		bool writable;
+	};
+
+	std::vector<Watch> watches; //every socket added
+#endif
+};
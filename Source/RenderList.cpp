@@ -0,0 +1,135 @@
+#include "RenderList.h"
+#include "Bits.h"
+#include "GameWorld.h"
+#include "ParticleSystem.h"
+
+void RenderList::setExtent(RenderLook target, int w, int h)
+{
+	width[target] = w;
+	height[target] = h;
+}
+
+
+
+void RenderList::build(GameWorld& world, ParticleSystem& particles)
+{
+	EntityStore& entities = world.entities;
+	const WaveTable& waves = world.getWaves();
+
+	count = 0;
+	culled = 0;
+
+	//aliens a row at a time, straight from the alive masks
+	const Position* alien = entities.get<Position>(GameWorld::ALIENS);
+
+	for (int large = 0; large < 2; large++)
+	{
+		begin(large ? LOOK_ALIEN_LARGE : LOOK_ALIEN);
+
+		for (int row = 0; row < waves.rows; row++)
+		{
+			if ((waves.row[row].sprite == 1) != (large == 1))
+			{
+				continue;
+			}
+
+			uint64_t alive = world.live_aliens.getRow(row);
+
+			while (alive != 0)
+			{
+				const Position& at = alien[row * waves.columns + lowestBit(alive)];
+				add(at.x, at.y);
+				alive &= alive - 1;
+			}
+		}
+	}
+
+	begin(LOOK_MOTHERSHIP);
+
+	if (entities.get<Life>(GameWorld::MOTHERSHIP)->alive)
+	{
+		const Position& at = *entities.get<Position>(GameWorld::MOTHERSHIP);
+		add(at.x, at.y);
+	}
+
+	begin(LOOK_DEBRIS);
+
+	const float* x = particles.getX();
+	const float* y = particles.getY();
+
+	for (int i = 0; i < particles.getCount(); i++)
+	{
+		add((int)x[i], (int)y[i]);
+	}
+
+	//every bullet, player's and aliens' alike, dead ones wait off screen
+	begin(LOOK_BULLET);
+
+	entities.each<Position, Life, Shot>([this](ArchetypeId, int bullets,
+		Position* position, Life* life, Shot*)
+	{
+		for (int i = 0; i < bullets; i++)
+		{
+			if (life[i].alive)
+			{
+				add(position[i].x, position[i].y);
+			}
+		}
+	});
+
+	begin(LOOK_PLAYER);
+
+	if (!world.isGameOver() && !world.isRespawning())
+	{
+		const Position& at = *entities.get<Position>(GameWorld::PLAYER);
+		add(at.x, at.y);
+	}
+
+	first[LOOK_COUNT] = count;
+}
+
+
+
+const Position* RenderList::getItems(RenderLook target)
+{
+	return items + first[target];
+}
+
+
+
+const int RenderList::getCount(RenderLook target)
+{
+	return first[target + 1] - first[target];
+}
+
+
+
+const int RenderList::getCulled()
+{
+	return culled;
+}
+
+
+
+void RenderList::begin(RenderLook target)
+{
+	look = target;
+	first[target] = count;
+}
+
+
+
+void RenderList::add(int x, int y)
+{
+	//screen rect against the sprite's box, a box just touching the left
+	//or top edge is kept
+	if ((x + width[look] < 0) || (x >= WINDOW_WIDTH) ||
+		(y + height[look] < 0) || (y >= WINDOW_HEIGHT))
+	{
+		culled++;
+		return;
+	}
+
+	items[count] = { x, y };
+	count++;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+
+#include "Components.h"
+#include "Constants.h"
+#include "WaveConfig.h"
+
+/** @file RenderList.h
+    @brief   What is actually on screen this frame.
+    @details Built once per frame from the world and its debris, before
+             anything is drawn. Only living actors go in, and each is
+             culled against the screen using the size its sprite is drawn
+             at, so dead bullets parked off screen and debris that has
+             fallen away never reach the renderer. Items are grouped by
+             look, each group is drawn with one sprite moved from item to
+             item.
+*/
+
+class GameWorld;
+class ParticleSystem;
+
+/** @enum RenderLook
+*   @brief which sprite an item is drawn with, grouped in this order
+*/
+enum RenderLook
+{
+	LOOK_ALIEN =       0, /**< small alien rows */
+	LOOK_ALIEN_LARGE = 1, /**< large alien rows */
+	LOOK_MOTHERSHIP =  2, /**< mothership */
+	LOOK_DEBRIS =      3, /**< explosion particles */
+	LOOK_BULLET =      4, /**< player and alien bullets */
+	LOOK_PLAYER =      5, /**< player, not while respawning */
+	LOOK_COUNT
+};
+
+constexpr int RENDER_CAPACITY = MAX_ALIENS + MAX_PARTICLES + 16; /**< items */
+
+class RenderList
+{
+public:
+	RenderList() = default;
+	~RenderList() = default;
+
+	RenderList(const RenderList&) = delete;
+	RenderList& operator=(const RenderList&) = delete;
+
+	//on screen size of look's sprite, anything at all of it showing is
+	//drawn, a look with no size is only culled by its top left
+	void setExtent(RenderLook look, int width, int height);
+
+	//list the living, visible actors and debris of this frame
+	void build(GameWorld& world, ParticleSystem& particles);
+
+	const Position* getItems(RenderLook look); //top left of each item
+	const int getCount(RenderLook look); //items of look
+	const int getCulled(); //living items left out this frame
+
+private:
+	void begin(RenderLook look); //following items are of look
+	void add(int x, int y); //append if any of it is on screen
+
+	Position items[RENDER_CAPACITY]; //grouped by look
+	int first[LOOK_COUNT + 1] = {}; //start of each look's group
+	int width[LOOK_COUNT] = {}; //extent of each look
+	int height[LOOK_COUNT] = {};
+	int look =   0; //look being added
+	int count =  0; //items listed
+	int culled = 0; //items off screen
+};
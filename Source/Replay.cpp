@@ -0,0 +1,228 @@
+#include "Replay.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+const uint8_t encodeInput(const WorldInput& input)
+{
+	uint8_t bits = 0;
+
+	if (input.move < 0)
+	{
+		bits |= 1;
+	}
+
+	else if (input.move > 0)
+	{
+		bits |= 2;
+	}
+
+	if (input.shoot)
+	{
+		bits |= 4;
+	}
+
+	return bits;
+}
+
+
+
+const WorldInput decodeInput(uint8_t bits)
+{
+	WorldInput input;
+
+	if (bits & 1)
+	{
+		input.move = -1;
+	}
+
+	else if (bits & 2)
+	{
+		input.move = 1;
+	}
+
+	input.shoot = (bits & 4) != 0;
+
+	return input;
+}
+
+
+
+const WorldInput mergeInputs(const WorldInput& a, const WorldInput& b)
+{
+	WorldInput merged;
+	merged.move = std::max(-1, std::min(a.move + b.move, 1));
+	merged.shoot = a.shoot || b.shoot;
+
+	return merged;
+}
+
+
+
+void Replay::begin(GameWorld& world)
+{
+	world.save(start);
+
+	steps.clear();
+	inputs.clear();
+	final_hash = 0;
+	recording = true;
+}
+
+
+
+void Replay::record(float dt, const WorldInput& input)
+{
+	if (!recording)
+	{
+		return;
+	}
+
+	steps.push_back(dt);
+	inputs.push_back(encodeInput(input));
+}
+
+
+
+void Replay::finish(GameWorld& world)
+{
+	GameSnapshot result;
+	world.save(result);
+
+	final_hash = hashSnapshot(result);
+	recording = false;
+}
+
+
+
+const bool Replay::isRecording()
+{
+	return recording;
+}
+
+
+
+const bool Replay::save(const char* path)
+{
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+	if (!file)
+	{
+		return false;
+	}
+
+	ReplayHeader header;
+	std::memset(&header, 0, sizeof(header));
+
+	header.magic = REPLAY_MAGIC;
+	header.version = REPLAY_VERSION;
+	header.ticks = (uint32_t)steps.size();
+	header.final_hash = final_hash;
+	header.start = start;
+
+	//header, then every dt, then every input byte
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(steps.data()),
+		steps.size() * sizeof(float));
+	file.write(reinterpret_cast<const char*>(inputs.data()), inputs.size());
+
+	return (bool)file;
+}
+
+
+
+const bool Replay::load(const char* path)
+{
+	std::ifstream file(path, std::ios::binary);
+
+	if (!file)
+	{
+		return false;
+	}
+
+	ReplayHeader header;
+
+	if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+		(header.magic != REPLAY_MAGIC) || (header.version != REPLAY_VERSION) ||
+		!isSnapshotValid(header.start))
+	{
+		return false;
+	}
+
+	std::vector<float> loaded_steps(header.ticks);
+	std::vector<uint8_t> loaded_inputs(header.ticks);
+
+	file.read(reinterpret_cast<char*>(loaded_steps.data()),
+		loaded_steps.size() * sizeof(float));
+	file.read(reinterpret_cast<char*>(loaded_inputs.data()),
+		loaded_inputs.size());
+
+	if (!file)
+	{
+		return false;
+	}
+
+	start = header.start;
+	steps.swap(loaded_steps);
+	inputs.swap(loaded_inputs);
+	final_hash = header.final_hash;
+	recording = false;
+
+	return true;
+}
+
+
+
+const bool Replay::rewind(GameWorld& world)
+{
+	return world.restore(start);
+}
+
+
+
+const bool Replay::play(GameWorld& world)
+{
+	if (!rewind(world))
+	{
+		return false;
+	}
+
+	for (size_t i = 0; i < steps.size(); i++)
+	{
+		world.step(steps[i], decodeInput(inputs[i]));
+	}
+
+	GameSnapshot result;
+	world.save(result);
+
+	return hashSnapshot(result) == final_hash;
+}
+
+
+
+const int Replay::getTicks()
+{
+	return (int)steps.size();
+}
+
+
+
+const float Replay::getTimeStep(int tick)
+{
+	return steps[tick];
+}
+
+
+
+const WorldInput Replay::getInput(int tick)
+{
+	return decodeInput(inputs[tick]);
+}
+
+
+
+const uint64_t Replay::getFinalHash()
+{
+	return final_hash;
+}
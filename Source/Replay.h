@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "GameSnapshot.h"
+#include "GameWorld.h"
+
+/** @file Replay.h
+    @brief   Recorded input sessions that can be played back headless.
+    @details A replay is the state the world was in when recording began
+             followed by the time step and input of every tick after it.
+             The world is deterministic, so stepping a world restored from
+             the starting state through the same inputs plays the same
+             game, and the hash of the final state recorded alongside
+             proves that it did. Replays are what the PGO build trains on
+             and what the tick benchmarks measure.
+*/
+
+constexpr uint32_t REPLAY_MAGIC =   0x4C505249; /**< "IRPL" little endian */
+constexpr uint32_t REPLAY_VERSION = 1;          /**< file layout version */
+
+/** @struct ReplayHeader
+*   @brief start of a replay file, tick data follows
+*/
+struct ReplayHeader
+{
+	uint32_t magic;      /**< REPLAY_MAGIC */
+	uint32_t version;    /**< REPLAY_VERSION */
+	uint32_t ticks;      /**< ticks recorded */
+	uint32_t reserved;   /**< zero */
+	uint64_t final_hash; /**< hashSnapshot of the world after the last tick */
+	GameSnapshot start;  /**< world when recording began */
+};
+
+//pack input into one byte, bit 0 left, bit 1 right, bit 2 shoot
+const uint8_t encodeInput(const WorldInput& input);
+const WorldInput decodeInput(uint8_t bits);
+
+//two players on one cannon, moves add up and either shot fires
+const WorldInput mergeInputs(const WorldInput& a, const WorldInput& b);
+
+class Replay
+{
+public:
+	Replay() = default;
+	~Replay() = default;
+
+	void begin(GameWorld& world); //start recording from world's state
+	void record(float dt, const WorldInput& input); //one ticked step
+	void finish(GameWorld& world); //stop, world's state is the result
+	const bool isRecording(); //between begin and finish
+
+	const bool save(const char* path); //write a finished replay
+	const bool load(const char* path); //false if missing or another version
+
+	//put world back to where recording began, false if its formation
+	//differs from the one recorded
+	const bool rewind(GameWorld& world);
+
+	//rewind and step through every tick, true if world ends in the
+	//recorded state
+	const bool play(GameWorld& world);
+
+	const int getTicks(); //ticks recorded
+	const float getTimeStep(int tick); //dt of tick
+	const WorldInput getInput(int tick); //input of tick
+	const uint64_t getFinalHash(); //hash of the recorded result
+
+private:
+	GameSnapshot start;          //state recording began from
+	std::vector<float> steps;    //dt per tick
+	std::vector<uint8_t> inputs; //encoded input per tick
+	uint64_t final_hash = 0;     //state after the last tick
+	bool recording = false;      //begin called without finish
+};
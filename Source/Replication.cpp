@@ -0,0 +1,385 @@
+#include "Replication.h"
+#include "Replay.h"
+#include "StateDelta.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+	constexpr int AGE_BITS = 5; //baseline age, 0 for a keyframe
+
+	static_assert(REPLICATION_HISTORY <= (1 << AGE_BITS),
+		"baseline ages must fit AGE_BITS");
+
+	//base every keyframe is written against
+	const GameSnapshot& emptyState()
+	{
+		static const GameSnapshot EMPTY = {};
+		return EMPTY;
+	}
+}
+
+
+
+void writeState(uint32_t sequence, uint32_t age, const GameSnapshot& base,
+	const GameSnapshot& state, std::vector<uint8_t>& payload)
+{
+	BitWriter writer(payload);
+	writer.write(sequence, 32);
+	writer.write(age, AGE_BITS);
+	encodeDelta(base, state, writer);
+	writer.finish();
+}
+
+
+
+ReplicationHost::ReplicationHost()
+	: history(REPLICATION_HISTORY)
+{
+}
+
+
+
+const bool ReplicationHost::start(uint16_t port)
+{
+	stop();
+
+	return listener.listen(port);
+}
+
+
+
+void ReplicationHost::stop()
+{
+	for (Client& client : clients)
+	{
+		bytes_sent += client.connection.getBytesSent();
+	}
+
+	clients.clear();
+	listener.close();
+}
+
+
+
+const WorldInput ReplicationHost::mergeInput(const WorldInput& local)
+{
+	WorldInput merged = local;
+
+	for (Client& client : clients)
+	{
+		WorldInput input;
+		input.move = client.move;
+		input.shoot = client.shoot;
+		client.shoot = false;
+
+		merged = mergeInputs(merged, input);
+	}
+
+	return merged;
+}
+
+
+
+void ReplicationHost::update(GameWorld& world)
+{
+	acceptClients();
+	readClients();
+
+	sequence++;
+
+	GameSnapshot& state = history[sequence % REPLICATION_HISTORY];
+	world.save(state);
+	keepReplicated(state);
+
+	for (Client& client : clients)
+	{
+		//a backed up client gets a later state against its own baseline
+		if (client.connection.getBacklog() > REPLICATION_SKIP)
+		{
+			client.connection.flush();
+			continue;
+		}
+
+		const std::vector<uint8_t>& payload = encodeFor(client.acked);
+
+		client.connection.send(MessageType::STATE, payload.data(),
+			(int)payload.size());
+		client.connection.flush();
+	}
+
+	//forget whoever has gone
+	for (Client& client : clients)
+	{
+		if (!client.connection.isOpen())
+		{
+			bytes_sent += client.connection.getBytesSent();
+		}
+	}
+
+	clients.erase(std::remove_if(clients.begin(), clients.end(),
+		[](Client& client) { return !client.connection.isOpen(); }),
+		clients.end());
+}
+
+
+
+const int ReplicationHost::getClients()
+{
+	return (int)clients.size();
+}
+
+
+
+const uint16_t ReplicationHost::getPort()
+{
+	return listener.getPort();
+}
+
+
+
+const uint32_t ReplicationHost::getSequence()
+{
+	return sequence;
+}
+
+
+
+const uint64_t ReplicationHost::getBytesSent()
+{
+	uint64_t total = bytes_sent;
+
+	for (Client& client : clients)
+	{
+		total += client.connection.getBytesSent();
+	}
+
+	return total;
+}
+
+
+
+void ReplicationHost::acceptClients()
+{
+	while (listener.isOpen())
+	{
+		Socket socket = listener.accept();
+
+		if (!socket.isOpen())
+		{
+			break;
+		}
+
+		clients.emplace_back();
+		clients.back().connection = Connection(std::move(socket));
+	}
+}
+
+
+
+void ReplicationHost::readClients()
+{
+	for (Client& client : clients)
+	{
+		client.connection.poll();
+
+		MessageType type;
+		const uint8_t* data;
+		int size;
+
+		while (client.connection.receive(type, data, size))
+		{
+			if ((type != MessageType::INPUT) || (size != 5))
+			{
+				continue;
+			}
+
+			uint32_t acked;
+			std::memcpy(&acked, data, sizeof(acked));
+
+			//only states that were sent can be acknowledged
+			if ((acked > client.acked) && (acked <= sequence))
+			{
+				client.acked = acked;
+			}
+
+			WorldInput input = decodeInput(data[4]);
+			client.move = input.move;
+			client.shoot = client.shoot || input.shoot;
+		}
+	}
+}
+
+
+
+const std::vector<uint8_t>& ReplicationHost::encodeFor(uint32_t acked)
+{
+	//too old to still be in the history, or nothing yet
+	uint32_t age = sequence - acked;
+
+	if ((acked == 0) || (age >= REPLICATION_HISTORY))
+	{
+		age = 0;
+	}
+
+	std::vector<uint8_t>& payload = encoded[age];
+
+	if (encoded_sequence[age] != sequence)
+	{
+		const GameSnapshot& base = (age == 0) ? emptyState() :
+			history[acked % REPLICATION_HISTORY];
+
+		payload.clear();
+		writeState(sequence, age, base,
+			history[sequence % REPLICATION_HISTORY], payload);
+
+		encoded_sequence[age] = sequence;
+	}
+
+	return payload;
+}
+
+
+
+ReplicationClient::ReplicationClient()
+	: history(REPLICATION_HISTORY)
+{
+}
+
+
+
+const bool ReplicationClient::connect(uint16_t port)
+{
+	disconnect();
+
+	Socket socket;
+
+	if (!socket.connect(port))
+	{
+		return false;
+	}
+
+	connection = Connection(std::move(socket));
+
+	return true;
+}
+
+
+
+void ReplicationClient::disconnect()
+{
+	connection.close();
+	latest = 0;
+	std::fill(std::begin(sequences), std::end(sequences), 0);
+}
+
+
+
+const bool ReplicationClient::update(const WorldInput& input)
+{
+	receive();
+
+	//input with every update, the newest state as the acknowledgement
+	uint8_t reply[5];
+	std::memcpy(reply, &latest, sizeof(latest));
+	reply[4] = encodeInput(input);
+
+	connection.send(MessageType::INPUT, reply, sizeof(reply));
+
+	return connection.flush();
+}
+
+
+
+const bool ReplicationClient::receive()
+{
+	connection.poll();
+
+	MessageType type;
+	const uint8_t* data;
+	int size;
+
+	while (connection.receive(type, data, size))
+	{
+		if (type == MessageType::STATE)
+		{
+			decodeState(data, size);
+		}
+	}
+
+	return connection.isOpen();
+}
+
+
+
+const bool ReplicationClient::hasState()
+{
+	return latest != 0;
+}
+
+
+
+const GameSnapshot& ReplicationClient::getState()
+{
+	return history[latest % REPLICATION_HISTORY];
+}
+
+
+
+const uint32_t ReplicationClient::getSequence()
+{
+	return latest;
+}
+
+
+
+const uint64_t ReplicationClient::getBytesReceived()
+{
+	return connection.getBytesReceived();
+}
+
+
+
+void ReplicationClient::decodeState(const uint8_t* data, int size)
+{
+	BitReader reader(data, size);
+
+	uint32_t sequence = reader.read(32);
+	uint32_t age = reader.read(AGE_BITS);
+
+	if ((sequence <= latest) || reader.isOverrun())
+	{
+		return;
+	}
+
+	//baseline has to be one still held, the host only uses acked ones
+	const GameSnapshot* base = &emptyState();
+
+	if (age != 0)
+	{
+		uint32_t slot = (sequence - age) % REPLICATION_HISTORY;
+
+		if (sequences[slot] != sequence - age)
+		{
+			return;
+		}
+
+		base = &history[slot];
+	}
+
+	//decoded aside so a bad delta can't clobber a held state
+	GameSnapshot state;
+
+	if (!decodeDelta(*base, reader, state))
+	{
+		connection.close();
+		return;
+	}
+
+	uint32_t slot = sequence % REPLICATION_HISTORY;
+
+	history[slot] = state;
+	sequences[slot] = sequence;
+	latest = sequence;
+}
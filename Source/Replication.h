@@ -0,0 +1,104 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Connection.h"
+#include "GameSnapshot.h"
+#include "GameWorld.h"
+
+/** @file Replication.h
+    @brief   Host authoritative game state sent to connected clients.
+    @details The host steps the only real world and after each step sends
+             every client the replicated state as a delta against the
+             newest state that client has acknowledged, or a keyframe if
+             it hasn't acknowledged one the host still remembers. Clients
+             never step, they decode, draw what they were sent and reply
+             with their input and the sequence they have. Deltas depend
+             only on the baseline, so clients on the same baseline, which
+             is nearly all of them, share one encoding per tick. A client
+             whose connection backs up is skipped rather than waited for
+             and catches up from its last acknowledgement.
+*/
+
+constexpr int REPLICATION_HISTORY = 32; /**< states a baseline can be from */
+constexpr int REPLICATION_SKIP =    16 * 1024; /**< backlog that skips a tick */
+
+//append a STATE payload, state as a delta against base, age ticks back,
+//or a keyframe if age is 0 and base is all zeros
+void writeState(uint32_t sequence, uint32_t age, const GameSnapshot& base,
+	const GameSnapshot& state, std::vector<uint8_t>& payload);
+
+class ReplicationHost
+{
+public:
+	ReplicationHost();
+	~ReplicationHost() = default;
+
+	const bool start(uint16_t port); //listen on loopback, 0 picks a port
+	void stop(); //disconnect everyone
+
+	//co-op on one cannon: moves add up, any player shooting shoots
+	const WorldInput mergeInput(const WorldInput& local);
+
+	//take new clients and their input, then send world's state
+	void update(GameWorld& world);
+
+	const int getClients(); //clients connected
+	const uint16_t getPort();
+	const uint32_t getSequence(); //states sent so far
+	const uint64_t getBytesSent(); //by every client, including framing
+
+private:
+	struct Client
+	{
+		Connection connection;
+		uint32_t acked = 0;  //newest sequence the client has, 0 if none
+		int move =       0;  //held move, from the latest input
+		bool shoot = false;  //fired since the last mergeInput
+	};
+
+	void acceptClients(); //take every waiting connection
+	void readClients(); //acknowledgements and input
+
+	//STATE payload for clients that have acked, cached for this sequence
+	const std::vector<uint8_t>& encodeFor(uint32_t acked);
+
+	Socket listener;
+	std::vector<Client> clients;
+	std::vector<GameSnapshot> history; //replicated states, by sequence
+	std::vector<uint8_t> encoded[REPLICATION_HISTORY]; //by baseline age
+	uint32_t encoded_sequence[REPLICATION_HISTORY] = {}; //when encoded
+	uint32_t sequence =   0; //newest state sent, 0 before the first
+	uint64_t bytes_sent = 0; //by clients since disconnected
+};
+
+class ReplicationClient
+{
+public:
+	ReplicationClient();
+	~ReplicationClient() = default;
+
+	const bool connect(uint16_t port); //host on loopback
+	void disconnect();
+
+	//decode whatever has arrived then send input and acknowledgement,
+	//false once the host has gone
+	const bool update(const WorldInput& input);
+
+	//decode whatever has arrived and send nothing, for watching a
+	//Broadcast, false once it has gone
+	const bool receive();
+
+	const bool hasState(); //a state has arrived
+	const GameSnapshot& getState(); //newest state, see keepReplicated
+	const uint32_t getSequence(); //of the newest state
+	const uint64_t getBytesReceived();
+
+private:
+	void decodeState(const uint8_t* data, int size);
+
+	Connection connection;
+	std::vector<GameSnapshot> history; //received states, by sequence
+	uint32_t sequences[REPLICATION_HISTORY] = {}; //held in each slot
+	uint32_t latest = 0; //newest sequence decoded
+};
@@ -0,0 +1,411 @@
+#include "Rollback.h"
+#include "Constants.h"
+#include "Replay.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+	constexpr int HASH_MESSAGE = 12; //tick then hash
+}
+
+
+
+const bool Rollback::host(uint16_t port)
+{
+	close();
+	hosting = true;
+
+	return listener.listen(port, 1);
+}
+
+
+
+const bool Rollback::join(uint16_t port)
+{
+	close();
+	hosting = false;
+
+	Socket socket;
+
+	if (!socket.connect(port))
+	{
+		return false;
+	}
+
+	connection = Connection(std::move(socket));
+
+	return true;
+}
+
+
+
+void Rollback::close()
+{
+	listener.close();
+	connection.close();
+	started = false;
+}
+
+
+
+void Rollback::poll(GameWorld& world)
+{
+	//one peer only, the game starts from the host's world as it is now
+	if (hosting && !connection.isOpen() && listener.isOpen())
+	{
+		Socket socket = listener.accept();
+
+		if (socket.isOpen())
+		{
+			connection = Connection(std::move(socket));
+			listener.close();
+
+			start(world);
+			connection.send(MessageType::PEER_START,
+				(const uint8_t*)&states[0], sizeof(GameSnapshot));
+		}
+	}
+
+	connection.poll();
+
+	MessageType type;
+	const uint8_t* data;
+	int size;
+
+	while (connection.receive(type, data, size))
+	{
+		if ((type == MessageType::PEER_START) && !hosting &&
+			(size == sizeof(GameSnapshot)))
+		{
+			GameSnapshot snapshot;
+			std::memcpy(&snapshot, data, sizeof(snapshot));
+
+			//the peer's formation has to be the same as ours
+			if (!world.restore(snapshot))
+			{
+				connection.close();
+				break;
+			}
+
+			start(world);
+		}
+
+		else if ((type == MessageType::PEER_INPUT) && started)
+		{
+			for (int i = 0; i < size; i++)
+			{
+				//further ahead than the window allows, the stream is bad
+				if ((int)(remote_count - tick) >= ROLLBACK_INPUTS)
+				{
+					connection.close();
+					break;
+				}
+
+				//a tick already stepped on a different guess is wrong
+				//from there on
+				int slot = remote_count % ROLLBACK_INPUTS;
+
+				if ((remote_count < tick) && (stepped_with[slot] != data[i]))
+				{
+					wrong = std::min(wrong, remote_count);
+				}
+
+				remote_inputs[slot] = data[i];
+				remote_count++;
+			}
+		}
+
+		else if ((type == MessageType::PEER_HASH) && started &&
+			(size == HASH_MESSAGE))
+		{
+			Check check;
+			std::memcpy(&check.tick, data, sizeof(check.tick));
+			std::memcpy(&check.hash, data + 4, sizeof(check.hash));
+
+			int slot = (check.tick / ROLLBACK_CHECK_INTERVAL) % ROLLBACK_CHECKS;
+			remote_checks[slot] = check;
+
+			if (local_checks[slot].tick == check.tick)
+			{
+				compare(check.tick);
+			}
+		}
+	}
+
+	connection.flush();
+}
+
+
+
+void Rollback::setInput(const WorldInput& local)
+{
+	move = local.move;
+	shoot = shoot || local.shoot;
+}
+
+
+
+const int Rollback::update(GameWorld& world, int ticks)
+{
+	if (!started)
+	{
+		return 0;
+	}
+
+	if (wrong < tick)
+	{
+		resimulate(world);
+	}
+
+	checkStates();
+
+	int stepped = 0;
+
+	//guesses only go so far ahead of what the peer has sent
+	while ((stepped < ticks) &&
+		((int)(tick - remote_count) < ROLLBACK_WINDOW))
+	{
+		WorldInput input;
+		input.move = move;
+		input.shoot = shoot;
+		shoot = false;
+
+		int slot = tick % ROLLBACK_INPUTS;
+		local_inputs[slot] = encodeInput(input);
+		stepped_with[slot] = (tick < remote_count) ? remote_inputs[slot] :
+			guess();
+
+		connection.send(MessageType::PEER_INPUT, &local_inputs[slot], 1);
+
+		world.step(SIM_TIME_STEP, mergeInputs(input,
+			decodeInput(stepped_with[slot])));
+
+		tick++;
+		wrong = tick;
+		world.save(states[tick % ROLLBACK_STATES]);
+		stepped++;
+
+		checkStates();
+	}
+
+	connection.flush();
+
+	return stepped;
+}
+
+
+
+const bool Rollback::isGameOver()
+{
+	if (!started)
+	{
+		return false;
+	}
+
+	//newest state with every input in, later ones are partly guessed
+	uint32_t confirmed = std::min(remote_count, tick);
+
+	return states[confirmed % ROLLBACK_STATES].player.alive == 0;
+}
+
+
+
+const bool Rollback::isStarted()
+{
+	return started;
+}
+
+
+
+const bool Rollback::isConnected()
+{
+	return connection.isOpen();
+}
+
+
+
+const bool Rollback::isDesynced()
+{
+	return desynced;
+}
+
+
+
+const uint32_t Rollback::getTick()
+{
+	return tick;
+}
+
+
+
+const uint16_t Rollback::getPort()
+{
+	return listener.getPort();
+}
+
+
+
+const std::string& Rollback::getDumpPath()
+{
+	return dump_path;
+}
+
+
+
+const uint64_t Rollback::getBytesSent()
+{
+	return connection.getBytesSent();
+}
+
+
+
+const uint64_t Rollback::getRollbacks()
+{
+	return rollbacks;
+}
+
+
+
+const uint64_t Rollback::getResimulated()
+{
+	return resimulated;
+}
+
+
+
+const int Rollback::getDeepest()
+{
+	return deepest;
+}
+
+
+
+void Rollback::start(GameWorld& world)
+{
+	std::memset(local_inputs, 0, sizeof(local_inputs));
+	std::memset(remote_inputs, 0, sizeof(remote_inputs));
+	std::memset(stepped_with, 0, sizeof(stepped_with));
+	remote_count = 0;
+	tick = 0;
+	wrong = 0;
+	next_check = ROLLBACK_CHECK_INTERVAL;
+
+	world.save(states[0]);
+
+	std::fill(std::begin(local_checks), std::end(local_checks), Check());
+	std::fill(std::begin(remote_checks), std::end(remote_checks), Check());
+
+	started = true;
+	desynced = false;
+	dump_path.clear();
+	shoot = false;
+}
+
+
+
+const uint8_t Rollback::guess()
+{
+	if (remote_count == 0)
+	{
+		return 0;
+	}
+
+	//still moving the way it was, shots can't be guessed
+	WorldInput last = decodeInput(
+		remote_inputs[(remote_count - 1) % ROLLBACK_INPUTS]);
+	last.shoot = false;
+
+	return encodeInput(last);
+}
+
+
+
+void Rollback::resimulate(GameWorld& world)
+{
+	int depth = (int)(tick - wrong);
+
+	rollbacks++;
+	resimulated += depth;
+	deepest = std::max(deepest, depth);
+
+	//the first wrong tick's state is at most the window back
+	world.restore(states[wrong % ROLLBACK_STATES]);
+	world.events.setSilenced(true);
+
+	for (uint32_t i = wrong; i < tick; i++)
+	{
+		int slot = i % ROLLBACK_INPUTS;
+		stepped_with[slot] = (i < remote_count) ? remote_inputs[slot] :
+			guess();
+
+		world.step(SIM_TIME_STEP, mergeInputs(decodeInput(local_inputs[slot]),
+			decodeInput(stepped_with[slot])));
+		world.save(states[(i + 1) % ROLLBACK_STATES]);
+	}
+
+	world.events.setSilenced(false);
+	wrong = tick;
+}
+
+
+
+void Rollback::checkStates()
+{
+	//a state is final once every input before it is the peer's own
+	while ((next_check <= remote_count) && (next_check <= tick))
+	{
+		int slot = (next_check / ROLLBACK_CHECK_INTERVAL) % ROLLBACK_CHECKS;
+
+		checked[slot] = states[next_check % ROLLBACK_STATES];
+		local_checks[slot].tick = next_check;
+		local_checks[slot].hash = hashSnapshot(checked[slot]);
+
+		uint8_t message[HASH_MESSAGE];
+		std::memcpy(message, &next_check, sizeof(next_check));
+		std::memcpy(message + 4, &local_checks[slot].hash, sizeof(uint64_t));
+
+		connection.send(MessageType::PEER_HASH, message, sizeof(message));
+
+		if (remote_checks[slot].tick == next_check)
+		{
+			compare(next_check);
+		}
+
+		next_check += ROLLBACK_CHECK_INTERVAL;
+	}
+}
+
+
+
+void Rollback::compare(uint32_t check_tick)
+{
+	int slot = (check_tick / ROLLBACK_CHECK_INTERVAL) % ROLLBACK_CHECKS;
+
+	if (!desynced && (local_checks[slot].hash != remote_checks[slot].hash))
+	{
+		desynced = true;
+		dump(check_tick);
+	}
+}
+
+
+
+void Rollback::dump(uint32_t check_tick)
+{
+	int slot = (check_tick / ROLLBACK_CHECK_INTERVAL) % ROLLBACK_CHECKS;
+
+	//each side writes its own, diff the two to find what split
+	char name[64];
+	std::snprintf(name, sizeof(name), "desync_%s_%u.sav",
+		hosting ? "host" : "join", check_tick);
+
+	dump_path = name;
+
+	if (!saveSnapshot(name, checked[slot]))
+	{
+		dump_path.clear();
+	}
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+#include "Connection.h"
+#include "GameSnapshot.h"
+#include "GameWorld.h"
+
+/** @file Rollback.h
+    @brief   Two peers that step ahead on a guess of each other's input.
+    @details Same start and messages as Lockstep, but a tick never waits
+             for the other peer's input. Until it arrives the peer is
+             guessed to hold the move it last sent and not shoot. Every
+             tick's starting state is saved, so when the real input turns
+             out different from the guess the world is put back to the
+             first tick that was wrong and stepped forward again to the
+             present in the same frame. Nothing replays while it does, the
+             event bus is silenced so effect handlers don't see the ticks a
+             second time. A peer can only be ROLLBACK_WINDOW ticks ahead of
+             the other's input, past that it waits as in lockstep. State
+             hashes are only swapped for ticks whose input is confirmed.
+*/
+
+constexpr int ROLLBACK_WINDOW =  8;  /**< ticks stepped on guesses at most */
+constexpr int ROLLBACK_STATES =  16; /**< saved states, more than the window */
+constexpr int ROLLBACK_INPUTS =  64; /**< ticks of input held */
+constexpr int ROLLBACK_CHECK_INTERVAL = 30; /**< ticks between state hashes */
+constexpr int ROLLBACK_CHECKS =  4;  /**< hashes held waiting for the peer's */
+
+static_assert(ROLLBACK_STATES > ROLLBACK_WINDOW,
+	"the first guessed tick's state has to still be saved");
+static_assert(ROLLBACK_INPUTS > 2 * ROLLBACK_WINDOW,
+	"a peer can be up to twice the window ahead");
+
+class Rollback
+{
+public:
+	Rollback() = default;
+	~Rollback() = default;
+
+	const bool host(uint16_t port); //wait for a peer on loopback
+	const bool join(uint16_t port); //peer hosting on loopback
+	void close();
+
+	//take the peer, its input and hashes, the host sends its world as
+	//the starting point when the peer arrives and the peer restores it
+	void poll(GameWorld& world);
+
+	//this frame's input, a shot is kept until a tick is stepped
+	void setInput(const WorldInput& local);
+
+	//correct any ticks stepped on a wrong guess, then step up to ticks
+	//new ones, returns how many were stepped
+	const int update(GameWorld& world, int ticks);
+
+	//over as of the newest state every input is in for, a game over
+	//stepped on a guess can still be taken back
+	const bool isGameOver();
+
+	const bool isStarted(); //both peers have the starting snapshot
+	const bool isConnected();
+	const bool isDesynced(); //a state hash didn't match the peer's
+	const uint32_t getTick(); //ticks stepped since the start
+	const uint16_t getPort(); //hosting port, the one picked by host(0)
+	const std::string& getDumpPath(); //desync dump, empty if none
+	const uint64_t getBytesSent();
+
+	const uint64_t getRollbacks(); //corrections made
+	const uint64_t getResimulated(); //ticks stepped again
+	const int getDeepest(); //most ticks a correction went back
+
+private:
+	struct Check
+	{
+		uint32_t tick = 0; //0 if the slot is empty
+		uint64_t hash = 0;
+	};
+
+	void start(GameWorld& world); //reset tick, inputs and saved states
+	const uint8_t guess(); //the other peer's input, as far as we know
+	void resimulate(GameWorld& world); //from the first wrong guess
+	void checkStates(); //hash states whose input is all confirmed
+	void compare(uint32_t tick); //both hashes for tick are in
+	void dump(uint32_t tick); //write the state at tick
+
+	Socket listener;
+	Connection connection;
+	bool hosting = false;
+	bool started = false;
+	bool desynced = false;
+	std::string dump_path;
+
+	int move =   0;     //held move
+	bool shoot = false; //shot not yet stepped
+
+	uint8_t local_inputs[ROLLBACK_INPUTS] = {};  //encoded, by tick
+	uint8_t remote_inputs[ROLLBACK_INPUTS] = {}; //encoded, by tick
+	uint8_t stepped_with[ROLLBACK_INPUTS] = {};  //remote input each tick used
+	uint32_t remote_count = 0; //ticks with the peer's input in
+	uint32_t tick =         0; //next tick to step
+	uint32_t wrong =        0; //first tick stepped on a wrong guess
+	uint32_t next_check =   0; //tick of the next state hash
+
+	GameSnapshot states[ROLLBACK_STATES]; //state before each tick
+
+	Check local_checks[ROLLBACK_CHECKS];
+	Check remote_checks[ROLLBACK_CHECKS];
+	GameSnapshot checked[ROLLBACK_CHECKS]; //state each local hash is of
+
+	uint64_t rollbacks =   0;
+	uint64_t resimulated = 0;
+	int deepest =          0;
+};
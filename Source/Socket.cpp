@@ -0,0 +1,324 @@
+#include "Socket.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+
+using socklen_t = int;
+#else
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <cstring>
+
+namespace
+{
+	constexpr SocketHandle CLOSED = (SocketHandle)-1;
+
+#if defined(_WIN32)
+	//winsock has to be started once before the first socket
+	struct Winsock
+	{
+		Winsock()
+		{
+			WSADATA data;
+			WSAStartup(MAKEWORD(2, 2), &data);
+		}
+
+		~Winsock()
+		{
+			WSACleanup();
+		}
+	};
+
+	void startSockets()
+	{
+		static Winsock winsock;
+	}
+
+	bool wouldBlock()
+	{
+		return WSAGetLastError() == WSAEWOULDBLOCK;
+	}
+
+	void closeHandle(SocketHandle socket_handle)
+	{
+		closesocket(socket_handle);
+	}
+#else
+	void startSockets()
+	{
+	}
+
+	bool wouldBlock()
+	{
+		return (errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR);
+	}
+
+	void closeHandle(SocketHandle socket_handle)
+	{
+		::close(socket_handle);
+	}
+#endif
+
+	sockaddr_in loopback(uint16_t port)
+	{
+		sockaddr_in address;
+		std::memset(&address, 0, sizeof(address));
+		address.sin_family = AF_INET;
+		address.sin_port = htons(port);
+		address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+		return address;
+	}
+}
+
+
+
+Socket::Socket(SocketHandle socket_handle)
+	: handle(socket_handle)
+{
+}
+
+
+
+Socket::~Socket()
+{
+	close();
+}
+
+
+
+Socket::Socket(Socket&& other) noexcept
+	: handle(other.handle)
+{
+	other.handle = CLOSED;
+}
+
+
+
+Socket& Socket::operator=(Socket&& other) noexcept
+{
+	if (this != &other)
+	{
+		close();
+		handle = other.handle;
+		other.handle = CLOSED;
+	}
+
+	return *this;
+}
+
+
+
+const bool Socket::listen(uint16_t port, int backlog)
+{
+	close();
+	startSockets();
+
+	handle = (SocketHandle)::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+	if (handle == CLOSED)
+	{
+		return false;
+	}
+
+	//a restarted host can take its port straight back
+	int reuse = 1;
+	setsockopt(handle, SOL_SOCKET, SO_REUSEADDR, (const char*)&reuse,
+		sizeof(reuse));
+
+	sockaddr_in address = loopback(port);
+
+	if ((::bind(handle, (const sockaddr*)&address, sizeof(address)) != 0) ||
+		(::listen(handle, backlog) != 0) || !configure())
+	{
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+
+
+const bool Socket::connect(uint16_t port)
+{
+	close();
+	startSockets();
+
+	handle = (SocketHandle)::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+	if (handle == CLOSED)
+	{
+		return false;
+	}
+
+	//blocking until connected, only non-blocking after
+	sockaddr_in address = loopback(port);
+
+	if ((::connect(handle, (const sockaddr*)&address, sizeof(address)) != 0) ||
+		!configure())
+	{
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+
+
+Socket Socket::accept()
+{
+	if (handle == CLOSED)
+	{
+		return Socket();
+	}
+
+	Socket client((SocketHandle)::accept(handle, nullptr, nullptr));
+
+	if (client.isOpen() && !client.configure())
+	{
+		client.close();
+	}
+
+	return client;
+}
+
+
+
+void Socket::close()
+{
+	if (handle != CLOSED)
+	{
+		closeHandle(handle);
+		handle = CLOSED;
+	}
+}
+
+
+
+const int Socket::send(const void* data, int size)
+{
+	if (handle == CLOSED)
+	{
+		return -1;
+	}
+
+#if defined(MSG_NOSIGNAL)
+	//a peer that has gone shouldn't raise SIGPIPE
+	int sent = (int)::send(handle, (const char*)data, size, MSG_NOSIGNAL);
+#else
+	int sent = (int)::send(handle, (const char*)data, size, 0);
+#endif
+
+	if (sent < 0)
+	{
+		return wouldBlock() ? 0 : -1;
+	}
+
+	return sent;
+}
+
+
+
+const int Socket::receive(void* data, int size)
+{
+	if (handle == CLOSED)
+	{
+		return -1;
+	}
+
+	int received = (int)::recv(handle, (char*)data, size, 0);
+
+	//zero bytes is the peer closing
+	if (received == 0)
+	{
+		return -1;
+	}
+
+	if (received < 0)
+	{
+		return wouldBlock() ? 0 : -1;
+	}
+
+	return received;
+}
+
+
+
+const bool Socket::setSendBuffer(int bytes)
+{
+	return (handle != CLOSED) && (setsockopt(handle, SOL_SOCKET, SO_SNDBUF,
+		(const char*)&bytes, sizeof(bytes)) == 0);
+}
+
+
+
+const bool Socket::setReceiveBuffer(int bytes)
+{
+	return (handle != CLOSED) && (setsockopt(handle, SOL_SOCKET, SO_RCVBUF,
+		(const char*)&bytes, sizeof(bytes)) == 0);
+}
+
+
+
+const bool Socket::isOpen()
+{
+	return handle != CLOSED;
+}
+
+
+
+const uint16_t Socket::getPort()
+{
+	sockaddr_in address;
+	socklen_t size = sizeof(address);
+
+	if ((handle == CLOSED) ||
+		(getsockname(handle, (sockaddr*)&address, &size) != 0))
+	{
+		return 0;
+	}
+
+	return ntohs(address.sin_port);
+}
+
+
+
+const SocketHandle Socket::getHandle()
+{
+	return handle;
+}
+
+
+
+const bool Socket::configure()
+{
+	int no_delay = 1;
+	setsockopt(handle, IPPROTO_TCP, TCP_NODELAY, (const char*)&no_delay,
+		sizeof(no_delay));
+
+#if defined(SO_NOSIGPIPE)
+	int no_signal = 1;
+	setsockopt(handle, SOL_SOCKET, SO_NOSIGPIPE, &no_signal,
+		sizeof(no_signal));
+#endif
+
+#if defined(_WIN32)
+	u_long non_blocking = 1;
+	return ioctlsocket(handle, FIONBIO, &non_blocking) == 0;
+#else
+	int flags = fcntl(handle, F_GETFL, 0);
+	return (flags >= 0) && (fcntl(handle, F_SETFL, flags | O_NONBLOCK) == 0);
+#endif
+}
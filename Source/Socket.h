@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+
+/** @file Socket.h
+    @brief   Non-blocking TCP sockets on the loopback interface.
+    @details Just enough of the BSD socket API for the network modes, the
+             same on Winsock and POSIX. Every socket is non-blocking with
+             Nagle's delay off, a call that would block returns at once
+             having done nothing. Connections are only made to 127.0.0.1,
+             networked play across machines isn't supported.
+*/
+
+#if defined(_WIN32)
+using SocketHandle = uintptr_t;
+#else
+using SocketHandle = int;
+#endif
+
+class Socket
+{
+public:
+	Socket() = default;
+	~Socket();
+
+	Socket(Socket&& other) noexcept;
+	Socket& operator=(Socket&& other) noexcept;
+
+	Socket(const Socket&) = delete;
+	Socket& operator=(const Socket&) = delete;
+
+	//accept loopback connections on port, 0 picks a free one
+	const bool listen(uint16_t port, int backlog = 64);
+
+	//connect to a loopback port, which completes at once on loopback
+	const bool connect(uint16_t port);
+
+	Socket accept(); //next waiting connection, a closed socket if none
+	void close();
+
+	//bytes moved, 0 if it would block, -1 once the connection is gone
+	const int send(const void* data, int size);
+	const int receive(void* data, int size);
+
+	//cap the kernel's queues, bytes, so a slow reader only holds so much
+	//memory
+	const bool setSendBuffer(int bytes);
+	const bool setReceiveBuffer(int bytes);
+
+	const bool isOpen();
+	const uint16_t getPort(); //local port, the one picked by listen(0)
+	const SocketHandle getHandle(); //for waiting on many sockets at once
+
+private:
+	explicit Socket(SocketHandle socket_handle);
+
+	const bool configure(); //non-blocking, no delay
+
+	SocketHandle handle = (SocketHandle)-1; //-1 when closed
+};
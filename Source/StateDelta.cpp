@@ -0,0 +1,285 @@
+#include "StateDelta.h"
+
+#include <cstring>
+
+namespace
+{
+	constexpr int COUNT_BITS = 8; //alien_count, MAX_ALIENS fits
+
+	static_assert(MAX_ALIENS < (1 << COUNT_BITS), "alien count is 8 bits");
+
+	void encodeField(int32_t base, int32_t value, BitWriter& writer)
+	{
+		writer.writeBool(value != base);
+
+		if (value != base)
+		{
+			writer.writeSigned(value - base);
+		}
+	}
+
+	int32_t decodeField(int32_t base, BitReader& reader)
+	{
+		return reader.readBool() ? base + reader.readSigned() : base;
+	}
+
+	//everything but position, which aliens write their own way
+	void encodeStatus(const ActorState& base, const ActorState& state,
+		BitWriter& writer)
+	{
+		encodeField(base.health, state.health, writer);
+		writer.writeBool(state.alive != 0);
+		writer.writeBool(state.flag != 0);
+		encodeField(base.direction, state.direction, writer);
+	}
+
+	void decodeStatus(const ActorState& base, BitReader& reader,
+		ActorState& state)
+	{
+		state.health = (int8_t)decodeField(base.health, reader);
+		state.alive = reader.readBool() ? 1 : 0;
+		state.flag = reader.readBool() ? 1 : 0;
+		state.direction = (int8_t)decodeField(base.direction, reader);
+	}
+
+	bool isSame(const ActorState& base, const ActorState& state)
+	{
+		return std::memcmp(&base, &state, sizeof(ActorState)) == 0;
+	}
+
+	void encodeActor(const ActorState& base, const ActorState& state,
+		BitWriter& writer)
+	{
+		writer.writeBool(!isSame(base, state));
+
+		if (!isSame(base, state))
+		{
+			encodeField(base.x, state.x, writer);
+			encodeField(base.y, state.y, writer);
+			encodeStatus(base, state, writer);
+		}
+	}
+
+	void decodeActor(const ActorState& base, BitReader& reader,
+		ActorState& state)
+	{
+		state = base;
+
+		if (reader.readBool())
+		{
+			state.x = (int16_t)decodeField(base.x, reader);
+			state.y = (int16_t)decodeField(base.y, reader);
+			decodeStatus(base, reader, state);
+		}
+	}
+
+	//a group of actors costs one bit while none of them change
+	void encodeGroup(const ActorState* base, const ActorState* state,
+		int count, BitWriter& writer)
+	{
+		bool changed = std::memcmp(base, state,
+			sizeof(ActorState) * count) != 0;
+
+		writer.writeBool(changed);
+
+		for (int i = 0; changed && (i < count); i++)
+		{
+			encodeActor(base[i], state[i], writer);
+		}
+	}
+
+	void decodeGroup(const ActorState* base, BitReader& reader,
+		ActorState* state, int count)
+	{
+		bool changed = reader.readBool();
+
+		for (int i = 0; i < count; i++)
+		{
+			if (changed)
+			{
+				decodeActor(base[i], reader, state[i]);
+			}
+			else
+			{
+				state[i] = base[i];
+			}
+		}
+	}
+}
+
+
+
+void keepReplicated(GameSnapshot& snapshot)
+{
+	snapshot.rng_state = 0;
+	snapshot.death_counter = 0;
+	snapshot.mothership_spawn_timer = 0;
+	snapshot.alien_move_counter = 0;
+	snapshot.alien_move_speed = 0;
+	snapshot.alarm_counter = 0;
+	snapshot.alien_shoot_speed = 0;
+}
+
+
+
+void encodeDelta(const GameSnapshot& base, const GameSnapshot& state,
+	BitWriter& writer)
+{
+	writer.writeSigned((int32_t)(state.frame - base.frame));
+	encodeField(base.score, state.score, writer);
+	encodeField(base.multiplier, state.multiplier, writer);
+	encodeField(base.alien_start_y, state.alien_start_y, writer);
+	writer.write((uint32_t)state.alien_count, COUNT_BITS);
+
+	encodeActor(base.player, state.player, writer);
+	encodeActor(base.player_bullet, state.player_bullet, writer);
+	encodeActor(base.mothership, state.mothership, writer);
+
+	//aliens, mostly the whole formation stepping the same way at once
+	int count = state.alien_count;
+	bool aliens_changed = std::memcmp(base.aliens, state.aliens,
+		sizeof(ActorState) * count) != 0;
+
+	writer.writeBool(aliens_changed);
+
+	int32_t step_x = 0;
+	int32_t step_y = 0;
+
+	for (int i = 0; aliens_changed && (i < count); i++)
+	{
+		const ActorState& from = base.aliens[i];
+		const ActorState& to = state.aliens[i];
+
+		writer.writeBool(!isSame(from, to));
+
+		if (isSame(from, to))
+		{
+			continue;
+		}
+
+		int32_t x = to.x - from.x;
+		int32_t y = to.y - from.y;
+
+		writer.writeBool((x == step_x) && (y == step_y));
+
+		if ((x != step_x) || (y != step_y))
+		{
+			encodeField(from.x, to.x, writer);
+			encodeField(from.y, to.y, writer);
+			step_x = x;
+			step_y = y;
+		}
+
+		encodeStatus(from, to, writer);
+	}
+
+	encodeGroup(base.bullets, state.bullets, 5, writer);
+	encodeGroup(base.barriers, state.barriers, 3, writer);
+
+	//barrier pixels, only rows that were chipped
+	for (int i = 0; i < 3; i++)
+	{
+		bool changed = std::memcmp(base.barrier_rows[i], state.barrier_rows[i],
+			sizeof(state.barrier_rows[i])) != 0;
+
+		writer.writeBool(changed);
+
+		for (int row = 0; changed && (row < BARRIER_HEIGHT); row++)
+		{
+			uint64_t bits = state.barrier_rows[i][row];
+
+			writer.writeBool(bits != base.barrier_rows[i][row]);
+
+			if (bits != base.barrier_rows[i][row])
+			{
+				writer.write((uint32_t)bits, 32);
+				writer.write((uint32_t)(bits >> 32), 32);
+			}
+		}
+	}
+}
+
+
+
+bool decodeDelta(const GameSnapshot& base, BitReader& reader,
+	GameSnapshot& state)
+{
+	std::memset(&state, 0, sizeof(state));
+
+	state.magic = SNAPSHOT_MAGIC;
+	state.version = SNAPSHOT_VERSION;
+	state.frame = base.frame + (uint32_t)reader.readSigned();
+	state.score = decodeField(base.score, reader);
+	state.multiplier = decodeField(base.multiplier, reader);
+	state.alien_start_y = decodeField(base.alien_start_y, reader);
+	state.alien_count = (int32_t)reader.read(COUNT_BITS);
+
+	if (state.alien_count > MAX_ALIENS)
+	{
+		return false;
+	}
+
+	decodeActor(base.player, reader, state.player);
+	decodeActor(base.player_bullet, reader, state.player_bullet);
+	decodeActor(base.mothership, reader, state.mothership);
+
+	bool aliens_changed = reader.readBool();
+
+	int32_t step_x = 0;
+	int32_t step_y = 0;
+
+	for (int i = 0; i < state.alien_count; i++)
+	{
+		const ActorState& from = base.aliens[i];
+		ActorState& to = state.aliens[i];
+
+		to = from;
+
+		if (!aliens_changed || !reader.readBool())
+		{
+			continue;
+		}
+
+		if (reader.readBool())
+		{
+			to.x = (int16_t)(from.x + step_x);
+			to.y = (int16_t)(from.y + step_y);
+		}
+		else
+		{
+			to.x = (int16_t)decodeField(from.x, reader);
+			to.y = (int16_t)decodeField(from.y, reader);
+			step_x = to.x - from.x;
+			step_y = to.y - from.y;
+		}
+
+		decodeStatus(from, reader, to);
+	}
+
+	decodeGroup(base.bullets, reader, state.bullets, 5);
+	decodeGroup(base.barriers, reader, state.barriers, 3);
+
+	for (int i = 0; i < 3; i++)
+	{
+		std::memcpy(state.barrier_rows[i], base.barrier_rows[i],
+			sizeof(state.barrier_rows[i]));
+
+		if (!reader.readBool())
+		{
+			continue;
+		}
+
+		for (int row = 0; row < BARRIER_HEIGHT; row++)
+		{
+			if (reader.readBool())
+			{
+				uint64_t low = reader.read(32);
+				uint64_t high = reader.read(32);
+
+				state.barrier_rows[i][row] = low | (high << 32);
+			}
+		}
+	}
+
+	return !reader.isOverrun();
+}
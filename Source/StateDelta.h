@@ -0,0 +1,31 @@
+#pragma once
+#include "BitStream.h"
+#include "GameSnapshot.h"
+
+/** @file StateDelta.h
+    @brief   Bit packed difference between two game states.
+    @details What a client needs to draw the game is the replicated part
+             of a GameSnapshot: positions, health and status of every
+             actor, barrier pixels, score and the frame, all already
+             quantized to whole pixels and small integers by save(). The
+             timers and random state only matter to whoever steps the
+             world, so they are never sent. A delta is written against a
+             base the receiver already has, each group, actor and field
+             costs a bit when it hasn't changed and a short signed
+             difference when it has. Aliens march together, so an alien
+             that moved as far as the last one that moved costs one bit
+             more. An all zero base makes the delta a keyframe.
+*/
+
+//clear everything that isn't replicated, so a decoded state and the
+//state it was encoded from hash the same
+void keepReplicated(GameSnapshot& snapshot);
+
+//write state's replicated fields as changes from base
+void encodeDelta(const GameSnapshot& base, const GameSnapshot& state,
+	BitWriter& writer);
+
+//rebuild state from base and a delta, false if the delta is cut short or
+//doesn't fit a GameSnapshot
+bool decodeDelta(const GameSnapshot& base, BitReader& reader,
+	GameSnapshot& state);
@@ -0,0 +1,61 @@
+#pragma once
+#include "AssetRegistry.h"
+
+/** @file TextureScales.h
+    @brief   How large each texture is drawn, relative to its file.
+    @details The game creates its sprites at these scales and
+             Tools/TextureImporter shrinks every texture drawn smaller than
+             its file down to the size it is drawn at, into
+             Resources/Imported. Those files shadow the originals, so a
+             sprite's scale is taken against the file that was actually
+             loaded and ends up the same size on screen either way. The
+             importer also writes the solid pixels of every texture marked
+             solid to HitMasks.h, at the size it is drawn.
+*/
+
+/** @struct TextureScale
+*   @brief the size a texture is drawn at
+*/
+struct TextureScale
+{
+	Asset texture;
+	float scale;   /**< drawn size over the original file's size */
+	bool solid;    /**< bullets hit it, a hit mask is generated */
+};
+
+constexpr TextureScale TEXTURE_SCALES[] =
+{
+	{ TEXTURE_ALIEN1,                 0.07f, true },
+	{ TEXTURE_ALIEN2,                 0.12f, true },
+	{ TEXTURE_BARRIER_PIXEL,          1.0f,  false },
+	{ TEXTURE_BULLET,                 4.0f,  false },
+	{ TEXTURE_EXPLOSION,              0.02f, false },
+	{ TEXTURE_PLAYER,                 0.05f, true },
+	{ TEXTURE_SPACESHIP,              0.05f, true },
+	{ TEXTURE_COMPUTER_KEY_A,         0.5f,  false },
+	{ TEXTURE_COMPUTER_KEY_D,         0.5f,  false },
+	{ TEXTURE_COMPUTER_KEY_ESC,       0.5f,  false },
+	{ TEXTURE_COMPUTER_KEY_P,         0.5f,  false },
+	{ TEXTURE_COMPUTER_KEY_SPACE_BAR, 0.5f,  false },
+	{ TEXTURE_COMPUTER_KEY_NUM_ROW_1, 0.5f,  false },
+	{ TEXTURE_COMPUTER_KEY_NUM_ROW_2, 0.5f,  false },
+	{ TEXTURE_COMPUTER_KEY_NUM_ROW_3, 0.5f,  false }
+};
+
+/**
+*   @brief   Scale texture is drawn at.
+*   @param   texture any texture asset
+*   @return  its scale against the original file, 1 if it isn't listed
+*/
+constexpr float getTextureScale(Asset texture)
+{
+	for (const TextureScale& entry : TEXTURE_SCALES)
+	{
+		if (entry.texture == texture)
+		{
+			return entry.scale;
+		}
+	}
+
+	return 1.0f;
+}
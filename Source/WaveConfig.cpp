@@ -0,0 +1,429 @@
+#include "WaveConfig.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+	std::string trim(const std::string& text)
+	{
+		size_t first = text.find_first_not_of(" \t\r");
+
+		if (first == std::string::npos)
+		{
+			return "";
+		}
+
+		size_t last = text.find_last_not_of(" \t\r");
+
+		return text.substr(first, last - first + 1);
+	}
+
+	bool toInt(const std::string& text, int32_t& value)
+	{
+		char* end = nullptr;
+		long parsed = std::strtol(text.c_str(), &end, 10);
+
+		if (text.empty() || (*end != '\0'))
+		{
+			return false;
+		}
+
+		value = (int32_t)parsed;
+		return true;
+	}
+
+	bool toFloat(const std::string& text, float& value)
+	{
+		char* end = nullptr;
+		float parsed = std::strtof(text.c_str(), &end);
+
+		if (text.empty() || (*end != '\0'))
+		{
+			return false;
+		}
+
+		value = parsed;
+		return true;
+	}
+
+	//what is wrong with the field just set, empty if nothing, fields
+	//without limits are always fine
+	std::string checkRange(const WaveTable& table, const int32_t* int_field,
+		const float* float_field)
+	{
+		if ((int_field == &table.rows) &&
+			((table.rows < 1) || (table.rows > MAX_WAVE_ROWS)))
+		{
+			return "must be 1-" + std::to_string(MAX_WAVE_ROWS);
+		}
+
+		if ((int_field == &table.columns) &&
+			((table.columns < 1) || (table.columns > MAX_WAVE_COLUMNS)))
+		{
+			return "must be 1-" + std::to_string(MAX_WAVE_COLUMNS);
+		}
+
+		//the snapshot keeps each alien's step in a signed byte
+		if ((int_field == &table.step_x) &&
+			((table.step_x < -INT8_MAX) || (table.step_x > INT8_MAX)))
+		{
+			return "must be within " + std::to_string(INT8_MAX) +
+				" either way";
+		}
+
+		for (const DifficultyStep& step : table.difficulty)
+		{
+			//1 in shoot_odds, a random number is taken modulo it
+			if ((int_field == &step.shoot_odds) && (step.shoot_odds < 1))
+			{
+				return "must be at least 1";
+			}
+
+			//also refuses NaN
+			if ((float_field == &step.move_interval) &&
+				!(step.move_interval > 0))
+			{
+				return "must be more than 0";
+			}
+		}
+
+		return "";
+	}
+}
+
+
+
+const WaveTable defaultWaves()
+{
+	WaveTable table;
+	std::memset(&table, 0, sizeof(table));
+
+	table.magic = WAVE_MAGIC;
+	table.version = WAVE_VERSION;
+
+	//5x11 formation, 50x40 apart
+	table.rows = 5;
+	table.columns = 11;
+	table.origin_x = 300;
+	table.spacing_x = 50;
+	table.spacing_y = 40;
+	table.step_x = 10;
+	table.drop_y = 30;
+	table.left_edge = 30;
+	table.right_edge = 970;
+	table.invade_y = 620;
+
+	//each wave starts 50 lower, down to 450
+	table.start_y = 100;
+	table.start_y_step = 50;
+	table.start_y_max = 450;
+
+	table.mothership_score = 200;
+	table.mothership_interval = 30;
+	table.mothership_speed = 300;
+
+	//aliens shoot more often as they come down
+	table.difficulty_count = 4;
+	table.difficulty[0] = { 0,   0.4f, 20000 };
+	table.difficulty[1] = { 190, 0.4f, 15000 };
+	table.difficulty[2] = { 370, 0.4f, 10000 };
+	table.difficulty[3] = { 430, 0.4f, 5000 };
+
+	//two rows of large aliens above three rows of small ones
+	table.row[0] = { 30, 1, 3 };
+	table.row[1] = { 30, 1, 3 };
+	table.row[2] = { 10, 0, 0 };
+	table.row[3] = { 10, 0, 0 };
+	table.row[4] = { 10, 0, 0 };
+
+	return table;
+}
+
+
+
+const bool parseWaves(const std::string& text, WaveTable& table,
+	std::string& error)
+{
+	//anything not given keeps its default
+	WaveTable parsed = defaultWaves();
+
+	std::istringstream lines(text);
+	std::string line;
+	std::string section;
+	int line_number = 0;
+
+	//repeated sections replace the default lists
+	int rows = 0;
+	int steps = 0;
+	int step_lines[MAX_DIFFICULTY_STEPS] = {}; //where each step's min_y is
+
+	while (std::getline(lines, line))
+	{
+		line_number++;
+
+		size_t comment = line.find('#');
+		if (comment != std::string::npos)
+		{
+			line.erase(comment);
+		}
+
+		line = trim(line);
+
+		if (line.empty())
+		{
+			continue;
+		}
+
+		std::string where = "line " + std::to_string(line_number) + ": ";
+
+		//[section]
+		if (line.front() == '[')
+		{
+			if (line.back() != ']')
+			{
+				error = where + "unterminated section";
+				return false;
+			}
+
+			section = trim(line.substr(1, line.size() - 2));
+
+			if (section == "row")
+			{
+				if (rows == MAX_WAVE_ROWS)
+				{
+					error = where + "more than " +
+						std::to_string(MAX_WAVE_ROWS) + " rows";
+					return false;
+				}
+
+				parsed.row[rows] = { 10, 0, 0 };
+				rows++;
+			}
+
+			else if (section == "difficulty")
+			{
+				if (steps == MAX_DIFFICULTY_STEPS)
+				{
+					error = where + "more than " +
+						std::to_string(MAX_DIFFICULTY_STEPS) +
+						" difficulty steps";
+					return false;
+				}
+
+				parsed.difficulty[steps] = { 0, 0.4f, 20000 };
+				step_lines[steps] = line_number;
+				steps++;
+			}
+
+			else if ((section != "formation") && (section != "mothership"))
+			{
+				error = where + "unknown section [" + section + "]";
+				return false;
+			}
+
+			continue;
+		}
+
+		//key = value
+		size_t equals = line.find('=');
+
+		if ((equals == std::string::npos) || section.empty())
+		{
+			error = where + "expected key = value inside a section";
+			return false;
+		}
+
+		std::string key = trim(line.substr(0, equals));
+		std::string value = trim(line.substr(equals + 1));
+
+		int32_t* int_field = nullptr;
+		float* float_field = nullptr;
+
+		if (section == "formation")
+		{
+			if (key == "rows") int_field = &parsed.rows;
+			else if (key == "columns") int_field = &parsed.columns;
+			else if (key == "origin_x") int_field = &parsed.origin_x;
+			else if (key == "spacing_x") int_field = &parsed.spacing_x;
+			else if (key == "spacing_y") int_field = &parsed.spacing_y;
+			else if (key == "step_x") int_field = &parsed.step_x;
+			else if (key == "drop_y") int_field = &parsed.drop_y;
+			else if (key == "left_edge") int_field = &parsed.left_edge;
+			else if (key == "right_edge") int_field = &parsed.right_edge;
+			else if (key == "invade_y") int_field = &parsed.invade_y;
+			else if (key == "start_y") int_field = &parsed.start_y;
+			else if (key == "start_y_step") int_field = &parsed.start_y_step;
+			else if (key == "start_y_max") int_field = &parsed.start_y_max;
+		}
+
+		else if (section == "mothership")
+		{
+			if (key == "score") int_field = &parsed.mothership_score;
+			else if (key == "interval") float_field = &parsed.mothership_interval;
+			else if (key == "speed") float_field = &parsed.mothership_speed;
+		}
+
+		else if (section == "row")
+		{
+			WaveRow& row = parsed.row[rows - 1];
+
+			if (key == "score") int_field = &row.score;
+			else if (key == "sprite") int_field = &row.sprite;
+			else if (key == "offset_x") int_field = &row.offset_x;
+		}
+
+		else if (section == "difficulty")
+		{
+			DifficultyStep& step = parsed.difficulty[steps - 1];
+
+			if (key == "min_y") int_field = &step.min_y;
+			else if (key == "move_interval") float_field = &step.move_interval;
+			else if (key == "shoot_odds") int_field = &step.shoot_odds;
+		}
+
+		if (!int_field && !float_field)
+		{
+			error = where + "unknown key '" + key + "' in [" + section + "]";
+			return false;
+		}
+
+		if ((int_field && !toInt(value, *int_field)) ||
+			(float_field && !toFloat(value, *float_field)))
+		{
+			error = where + "bad value '" + value + "' for " + key;
+			return false;
+		}
+
+		//an out of order step is blamed on its min_y if it has one
+		if ((section == "difficulty") && (key == "min_y"))
+		{
+			step_lines[steps - 1] = line_number;
+		}
+
+		//values the world divides by or squeezes into the snapshot
+		std::string range = checkRange(parsed, int_field, float_field);
+
+		if (!range.empty())
+		{
+			error = where + key + " " + range;
+			return false;
+		}
+	}
+
+	//steps are searched from the bottom up so must be in order
+	for (int i = 1; i < steps; i++)
+	{
+		if (parsed.difficulty[i].min_y < parsed.difficulty[i - 1].min_y)
+		{
+			error = "line " + std::to_string(step_lines[i]) +
+				": difficulty min_y is lower than the step before";
+			return false;
+		}
+	}
+
+	if (rows > 0)
+	{
+		//rows not listed default to the last one given
+		for (int i = rows; i < parsed.rows && i < MAX_WAVE_ROWS; i++)
+		{
+			parsed.row[i] = parsed.row[rows - 1];
+		}
+	}
+
+	if (steps > 0)
+	{
+		parsed.difficulty_count = steps;
+	}
+
+	//anything the checks above can't pin on a line
+	if (!isWaveTableValid(parsed))
+	{
+		error = "formation must be 1-" + std::to_string(MAX_WAVE_ROWS) +
+			" rows of 1-" + std::to_string(MAX_WAVE_COLUMNS) +
+			" columns, with difficulty steps in increasing min_y order";
+		return false;
+	}
+
+	table = parsed;
+	return true;
+}
+
+
+
+const bool isWaveTableValid(const WaveTable& table)
+{
+	if ((table.magic != WAVE_MAGIC) || (table.version != WAVE_VERSION) ||
+		(table.rows < 1) || (table.rows > MAX_WAVE_ROWS) ||
+		(table.columns < 1) || (table.columns > MAX_WAVE_COLUMNS) ||
+		(table.difficulty_count < 1) ||
+		(table.difficulty_count > MAX_DIFFICULTY_STEPS))
+	{
+		return false;
+	}
+
+	if (!checkRange(table, &table.rows, nullptr).empty() ||
+		!checkRange(table, &table.columns, nullptr).empty() ||
+		!checkRange(table, &table.step_x, nullptr).empty())
+	{
+		return false;
+	}
+
+	//steps are searched from the bottom up so must be in order
+	for (int i = 0; i < table.difficulty_count; i++)
+	{
+		const DifficultyStep& step = table.difficulty[i];
+
+		if (!checkRange(table, &step.shoot_odds, nullptr).empty() ||
+			!checkRange(table, nullptr, &step.move_interval).empty() ||
+			((i > 0) && (step.min_y < table.difficulty[i - 1].min_y)))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+
+const bool loadWaves(const char* path, WaveTable& table)
+{
+	std::ifstream file(path, std::ios::binary);
+
+	if (!file)
+	{
+		return false;
+	}
+
+	//read into a temporary so a bad file leaves the caller's copy alone
+	WaveTable loaded;
+
+	if (!file.read(reinterpret_cast<char*>(&loaded), sizeof(loaded)) ||
+		!isWaveTableValid(loaded))
+	{
+		return false;
+	}
+
+	table = loaded;
+
+	return true;
+}
+
+
+
+const bool saveWaves(const char* path, const WaveTable& table)
+{
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+	if (!file)
+	{
+		return false;
+	}
+
+	file.write(reinterpret_cast<const char*>(&table), sizeof(table));
+
+	return (bool)file;
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+/** @file WaveConfig.h
+    @brief   Alien formation, difficulty curve and scoring as data.
+    @details Waves are written as text in Resources/Config/Waves.txt and
+             compiled by the WaveCompiler tool into Resources/Waves.bin,
+             which is a WaveTable written out byte for byte. The game
+             reads that file once at start up with a single read, no text
+             is parsed at runtime. If it is missing the built in defaults,
+             which match Waves.txt as shipped, are used instead.
+*/
+
+constexpr uint32_t WAVE_MAGIC =   0x56415749; /**< "IWAV" little endian */
+constexpr uint32_t WAVE_VERSION = 1;          /**< layout version */
+
+constexpr int MAX_WAVE_ROWS =        8;   /**< most rows in a formation */
+constexpr int MAX_WAVE_COLUMNS =     16;  /**< most aliens in a row */
+constexpr int MAX_DIFFICULTY_STEPS = 8;   /**< most difficulty steps */
+constexpr int MAX_ALIENS = MAX_WAVE_ROWS * MAX_WAVE_COLUMNS;
+
+/** @struct WaveRow
+*   @brief one row of the formation, top row first
+*/
+struct WaveRow
+{
+	int32_t score;    /**< points for shooting an alien in this row */
+	int32_t sprite;   /**< 0 small alien, 1 large alien */
+	int32_t offset_x; /**< extra x offset to centre the sprite */
+};
+
+/** @struct DifficultyStep
+*   @brief alien pace once the formation has come down to min_y
+*/
+struct DifficultyStep
+{
+	int32_t min_y;       /**< formation height the step starts at */
+	float move_interval; /**< seconds between formation moves */
+	int32_t shoot_odds;  /**< 1 in shoot_odds chance per alien per bullet */
+};
+
+/** @struct WaveTable
+*   @brief everything the world needs to build and run a wave
+*/
+struct WaveTable
+{
+	uint32_t magic;       /**< WAVE_MAGIC */
+	uint32_t version;     /**< WAVE_VERSION */
+
+	int32_t rows;         /**< rows in the formation */
+	int32_t columns;      /**< aliens per row */
+	int32_t origin_x;     /**< x of the left column */
+	int32_t spacing_x;    /**< distance between columns */
+	int32_t spacing_y;    /**< distance between rows */
+	int32_t step_x;       /**< sideways move per tick */
+	int32_t drop_y;       /**< move down when changing direction */
+	int32_t left_edge;    /**< change direction past this x */
+	int32_t right_edge;   /**< change direction past this x */
+	int32_t invade_y;     /**< game over if a live alien drops below */
+
+	int32_t start_y;      /**< top row height on the first wave */
+	int32_t start_y_step; /**< each cleared wave starts this much lower */
+	int32_t start_y_max;  /**< lowest a wave will start */
+
+	int32_t mothership_score;       /**< points for the mothership */
+	float mothership_interval;      /**< seconds between motherships */
+	float mothership_speed;         /**< pixels per second */
+
+	int32_t difficulty_count;       /**< steps in use, first is the start */
+	DifficultyStep difficulty[MAX_DIFFICULTY_STEPS]; /**< lowest min_y first */
+	WaveRow row[MAX_WAVE_ROWS];     /**< per row data */
+};
+
+static_assert(std::is_trivially_copyable<WaveTable>::value,
+	"wave tables are read as raw bytes");
+
+//table matching the original hard coded formation
+const WaveTable defaultWaves();
+
+//parse Waves.txt source, error describes the first problem found
+const bool parseWaves(const std::string& text, WaveTable& table,
+	std::string& error);
+
+//sizes and counts are within the fixed table limits and every value the
+//world divides by or keeps in a snapshot fits
+const bool isWaveTableValid(const WaveTable& table);
+
+//read a compiled table, false if missing, corrupt or another version
+const bool loadWaves(const char* path, WaveTable& table);
+
+//write a compiled table
+const bool saveWaves(const char* path, const WaveTable& table);
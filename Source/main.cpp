@@ -1,18 +1,66 @@
-//int main(int argc, char **argv)
-//{
-//	return 0;
-//}
-
-#define WIN32_LEAN_AND_MEAN
-#include <Windows.h>
 #include <Engine/Platform.h>
 
+#include <cstdlib>
+#include <cstring>
+
 #include "Game.h"
 
-int WINAPI WinMain(
-	HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR pScmdline, int iCmdshow)
+//--host, --join, --lockstep-host, --lockstep-join, --rollback-host,
+//--rollback-join, --broadcast or --spectate <port>, for loopback
+//multiplayer
+static void readNetwork(InvadersGame& game, int argc, char** argv)
+{
+	for (int i = 1; i + 1 < argc; i++)
+	{
+		uint16_t port = (uint16_t)std::atoi(argv[i + 1]);
+
+		if (std::strcmp(argv[i], "--host") == 0)
+		{
+			game.setNetwork(InvadersGame::NetworkMode::HOST, port);
+		}
+
+		else if (std::strcmp(argv[i], "--join") == 0)
+		{
+			game.setNetwork(InvadersGame::NetworkMode::JOIN, port);
+		}
+
+		else if (std::strcmp(argv[i], "--lockstep-host") == 0)
+		{
+			game.setNetwork(InvadersGame::NetworkMode::LOCKSTEP_HOST, port);
+		}
+
+		else if (std::strcmp(argv[i], "--lockstep-join") == 0)
+		{
+			game.setNetwork(InvadersGame::NetworkMode::LOCKSTEP_JOIN, port);
+		}
+
+		else if (std::strcmp(argv[i], "--rollback-host") == 0)
+		{
+			game.setNetwork(InvadersGame::NetworkMode::ROLLBACK_HOST, port);
+		}
+
+		else if (std::strcmp(argv[i], "--rollback-join") == 0)
+		{
+			game.setNetwork(InvadersGame::NetworkMode::ROLLBACK_JOIN, port);
+		}
+
+		else if (std::strcmp(argv[i], "--broadcast") == 0)
+		{
+			game.setNetwork(InvadersGame::NetworkMode::BROADCAST, port);
+		}
+
+		else if (std::strcmp(argv[i], "--spectate") == 0)
+		{
+			game.setNetwork(InvadersGame::NetworkMode::SPECTATE, port);
+		}
+	}
+}
+
+static int runGame(int argc, char** argv)
 {
 	InvadersGame game;
+	readNetwork(game, argc, argv);
+
 	if (game.init())
 	{
 		return game.run();
@@ -23,4 +71,21 @@ int WINAPI WinMain(
 	{
 		return -1;
 	}
-}
\ No newline at end of file
+}
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+int WINAPI WinMain(
+	HINSTANCE hInstance, HINSTANCE hPrevInstance, PSTR pScmdline, int iCmdshow)
+{
+	return runGame(__argc, __argv);
+}
+
+#else
+int main(int argc, char **argv)
+{
+	return runGame(argc, argv);
+}
+#endif
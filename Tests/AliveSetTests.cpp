@@ -0,0 +1,74 @@
+#include "Tests.h"
+#include "AliveSet.h"
+#include "Components.h"
+
+namespace
+{
+	void testAliveSet()
+	{
+		AliveSet set;
+		set.reset(5, 11);
+
+		CHECK(set.getCount() == 55);
+		CHECK(!set.isEmpty());
+		CHECK(set.getRow(4) == 0x7FF);
+
+		set.kill(0);
+		set.kill(12);
+		set.kill(54);
+
+		CHECK(set.getCount() == 52);
+		CHECK(!set.isAlive(12) && set.isAlive(13));
+		CHECK(set.getRow(1) == (0x7FFu & ~2u));
+		CHECK(set.next(0) == 1);
+		CHECK(set.next(12) == 13);
+		CHECK(set.next(54) == -1);
+
+		//visiting every living alien
+		int visited = 0;
+
+		for (int i = set.next(0); i >= 0; i = set.next(i + 1))
+		{
+			visited++;
+		}
+
+		CHECK(visited == 52);
+
+		//rebuilt from the alive flags, as a restore does
+		Life life[MAX_ALIENS] = {};
+
+		for (int i = 0; i < 24; i++)
+		{
+			life[i].alive = (i % 3) == 0;
+		}
+
+		AliveSet rebuilt;
+		rebuilt.rebuild(life, 2, 12);
+
+		CHECK(rebuilt.getCount() == 8);
+		CHECK(rebuilt.isAlive(21) && !rebuilt.isAlive(22));
+
+		for (int i = 0; i < 24; i++)
+		{
+			if (rebuilt.isAlive(i))
+			{
+				rebuilt.kill(i);
+			}
+		}
+
+		CHECK(rebuilt.isEmpty());
+		CHECK(rebuilt.next(0) == -1);
+
+		//the biggest formation crosses word boundaries
+		AliveSet biggest;
+		biggest.reset(MAX_WAVE_ROWS, MAX_WAVE_COLUMNS);
+		CHECK(biggest.getCount() == MAX_ALIENS);
+		biggest.kill(63);
+		CHECK(biggest.next(63) == 64);
+	}
+
+
+
+
+	const TestCase registered("alive_set", testAliveSet);
+}
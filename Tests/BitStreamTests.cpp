@@ -0,0 +1,68 @@
+#include "Tests.h"
+#include "BitStream.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+	void testBitStream()
+	{
+		std::vector<uint8_t> buffer;
+		BitWriter writer(buffer);
+
+		const int32_t signed_values[] =
+		{
+			0, 1, -1, 2, -2, 63, -64, 1000, -1000, INT32_MAX, INT32_MIN,
+			INT32_MAX - 1, INT32_MIN + 1, 1 << 30, -(1 << 30)
+		};
+
+		for (int bits = 1; bits <= 32; bits++)
+		{
+			writer.write(0xA5C3E1F7u, bits);
+			writer.writeBool((bits & 1) != 0);
+		}
+
+		for (int32_t value : signed_values)
+		{
+			writer.writeSigned(value);
+		}
+
+		int bits = writer.getBits();
+		writer.finish();
+
+		CHECK((int)buffer.size() == (bits + 7) / 8);
+
+		BitReader reader(buffer.data(), (int)buffer.size());
+
+		for (int bits = 1; bits <= 32; bits++)
+		{
+			uint32_t mask = (bits == 32) ? ~0u : ((1u << bits) - 1);
+
+			CHECK(reader.read(bits) == (0xA5C3E1F7u & mask));
+			CHECK(reader.readBool() == ((bits & 1) != 0));
+		}
+
+		for (int32_t value : signed_values)
+		{
+			CHECK(reader.readSigned() == value);
+		}
+
+		CHECK(!reader.isOverrun());
+
+		//past the end reads zeros and says so
+		reader.read(16);
+		CHECK(reader.isOverrun());
+
+		//small changes stay short
+		std::vector<uint8_t> small;
+		BitWriter small_writer(small);
+		small_writer.writeSigned(0);
+		CHECK(small_writer.getBits() == 5);
+	}
+
+
+
+
+	const TestCase registered("bitstream", testBitStream);
+}
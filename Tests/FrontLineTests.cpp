@@ -0,0 +1,64 @@
+#include "Tests.h"
+#include "AliveSet.h"
+#include "FrontLine.h"
+
+#include <cstring>
+
+namespace
+{
+	void testFrontLine()
+	{
+		AliveSet alive;
+		FrontLine front;
+		alive.reset(5, 11);
+		front.reset(5, 11);
+
+		//the bottom row shoots, left first
+		CHECK(front.getCount() == 11);
+
+		for (int c = 0; c < 11; c++)
+		{
+			CHECK(front.getShooters()[c] == 44 + c);
+		}
+
+		//the alien above takes over, one further up only once it's next
+		alive.kill(33);
+		front.kill(33, alive);
+		CHECK(front.isShooter(44));
+
+		alive.kill(47);
+		front.kill(47, alive);
+		CHECK(front.isShooter(36) && !front.isShooter(47));
+
+		alive.kill(36);
+		front.kill(36, alive);
+		CHECK(front.isShooter(25));
+
+		//a cleared column drops out of the list
+		for (int row = 0; row < 5; row++)
+		{
+			int alien = row * 11 + 5;
+			alive.kill(alien);
+			front.kill(alien, alive);
+		}
+
+		CHECK(front.getCount() == 10);
+
+		for (int s = 0; s < front.getCount(); s++)
+		{
+			CHECK(front.getShooters()[s] % 11 != 5);
+		}
+
+		//a rebuild finds the same front
+		FrontLine rebuilt;
+		rebuilt.rebuild(alive, 5, 11);
+		CHECK(rebuilt.getCount() == front.getCount());
+		CHECK(std::memcmp(rebuilt.getShooters(), front.getShooters(),
+			sizeof(int) * front.getCount()) == 0);
+	}
+
+
+
+
+	const TestCase registered("front_line", testFrontLine);
+}
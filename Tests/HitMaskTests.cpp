@@ -0,0 +1,85 @@
+#include "Tests.h"
+#include "HitMask.h"
+
+#include <cstdint>
+
+namespace
+{
+	//the plain answer, any solid pixel of the mask inside the box
+	bool slowHit(const HitMask& mask, int x, int y, int left, int top,
+		int right, int bottom)
+	{
+		for (int row = 0; row < mask.height; row++)
+		{
+			for (int column = 0; column < mask.width; column++)
+			{
+				int px = x + mask.left + column;
+				int py = y + mask.top + row;
+
+				if (((mask.rows[row] >> column) & 1) && (px >= left) &&
+					(px <= right) && (py >= top) && (py <= bottom))
+				{
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
+
+
+
+	void testHitTest()
+	{
+		const Asset solid[] = { TEXTURE_ALIEN1, TEXTURE_ALIEN2,
+			TEXTURE_PLAYER, TEXTURE_SPACESHIP };
+
+		for (Asset texture : solid)
+		{
+			const HitMask& mask = getHitMask(texture);
+
+			CHECK(mask.texture == texture);
+			CHECK((mask.width > 0) && (mask.width <= HIT_MASK_MAX));
+			CHECK((mask.height > 0) && (mask.height <= HIT_MASK_MAX));
+
+			//every single pixel, then boxes of every size around the mask
+			for (int py = -2; py < mask.top + mask.height + 2; py++)
+			{
+				for (int px = -2; px < mask.left + mask.width + 2; px++)
+				{
+					CHECK(hitTest(mask, 10, 20, 10 + px, 20 + py, 10 + px,
+						20 + py) == slowHit(mask, 10, 20, 10 + px, 20 + py,
+						10 + px, 20 + py));
+				}
+			}
+
+			uint32_t seed = 12345;
+
+			for (int i = 0; i < 2000; i++)
+			{
+				seed = seed * 1664525u + 1013904223u;
+
+				int left = (int)(seed >> 8) % 90 - 20;
+				int top = (int)(seed >> 16) % 90 - 20;
+				int right = left + (int)(seed >> 4) % 40;
+				int bottom = top + (int)(seed >> 20) % 40;
+
+				CHECK(hitTest(mask, 0, 0, left, top, right, bottom) ==
+					slowHit(mask, 0, 0, left, top, right, bottom));
+			}
+
+			//nowhere near
+			CHECK(!hitTest(mask, 0, 0, 500, 500, 505, 505));
+		}
+
+		//textures that aren't solid never hit
+		const HitMask& none = getHitMask(TEXTURE_BULLET);
+		CHECK(!hitTest(none, 0, 0, -100, -100, 100, 100));
+	}
+
+
+
+
+	const TestCase registered("hit_test", testHitTest);
+}
@@ -0,0 +1,77 @@
+#include "Tests.h"
+#include "GameSnapshot.h"
+#include "GameWorld.h"
+#include "JobSystem.h"
+
+#include <memory>
+#include <vector>
+
+namespace
+{
+	void testJobSystem()
+	{
+		JobSystem jobs(3);
+
+		for (int round = 0; round < 500; round++)
+		{
+			//a job after its dependency sees what it wrote
+			JobCounter first;
+			JobCounter second;
+			int written = 0;
+			int seen = -1;
+
+			jobs.run([&written]()
+			{
+				written = 1;
+			}, first);
+
+			jobs.runAfter(first, [&written, &seen]()
+			{
+				seen = written;
+			}, second);
+
+			jobs.wait(second);
+			CHECK(seen == 1);
+
+			//every index exactly once
+			std::vector<int> hits(1000, 0);
+
+			jobs.parallelFor(0, (int)hits.size(), 16, [&hits](int begin,
+				int end)
+			{
+				for (int i = begin; i < end; i++)
+				{
+					hits[i]++;
+				}
+			});
+
+			int wrong = 0;
+
+			for (int hit : hits)
+			{
+				wrong += (hit != 1) ? 1 : 0;
+			}
+
+			CHECK(wrong == 0);
+		}
+
+		//a world stepped on jobs plays exactly as one stepped alone
+		std::unique_ptr<GameWorld> alone = std::make_unique<GameWorld>(5);
+		std::unique_ptr<GameWorld> spread =
+			std::make_unique<GameWorld>(5, &jobs);
+
+		play(*alone, 0, 900);
+		play(*spread, 0, 900);
+
+		GameSnapshot expected;
+		GameSnapshot result;
+		alone->save(expected);
+		spread->save(result);
+		CHECK(hashSnapshot(result) == hashSnapshot(expected));
+	}
+
+
+
+
+	const TestCase registered("job_system", testJobSystem);
+}
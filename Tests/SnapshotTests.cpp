@@ -0,0 +1,75 @@
+#include "Tests.h"
+#include "GameSnapshot.h"
+#include "GameWorld.h"
+
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+namespace
+{
+	void testSnapshot()
+	{
+		std::unique_ptr<GameWorld> worlds[2] =
+		{
+			std::make_unique<GameWorld>(7),
+			std::make_unique<GameWorld>(7)
+		};
+
+		//same seed and input, same game
+		play(*worlds[0], 0, 600);
+		play(*worlds[1], 0, 600);
+
+		GameSnapshot first;
+		GameSnapshot second;
+		worlds[0]->save(first);
+		worlds[1]->save(second);
+
+		CHECK(isSnapshotValid(first));
+		CHECK(hashSnapshot(first) == hashSnapshot(second));
+		CHECK(std::memcmp(&first, &second, sizeof(first)) == 0);
+
+		//going back and playing the same ticks again ends the same
+		play(*worlds[0], 600, 300);
+
+		GameSnapshot ahead;
+		worlds[0]->save(ahead);
+		CHECK(hashSnapshot(ahead) != hashSnapshot(first));
+
+		CHECK(worlds[0]->restore(first));
+
+		GameSnapshot restored;
+		worlds[0]->save(restored);
+		CHECK(hashSnapshot(restored) == hashSnapshot(first));
+
+		play(*worlds[0], 600, 300);
+
+		GameSnapshot again;
+		worlds[0]->save(again);
+		CHECK(hashSnapshot(again) == hashSnapshot(ahead));
+
+		//any byte changes the hash
+		GameSnapshot nudged = first;
+		nudged.score++;
+		CHECK(hashSnapshot(nudged) != hashSnapshot(first));
+
+		//a snapshot from another build is refused
+		GameSnapshot foreign = first;
+		foreign.version++;
+		CHECK(!isSnapshotValid(foreign));
+		CHECK(!worlds[1]->restore(foreign));
+
+		//through a file
+		const char* path = "invaders_tests.sav";
+		GameSnapshot loaded;
+		CHECK(saveSnapshot(path, first));
+		CHECK(loadSnapshot(path, loaded));
+		CHECK(hashSnapshot(loaded) == hashSnapshot(first));
+		std::remove(path);
+	}
+
+
+
+
+	const TestCase registered("snapshot", testSnapshot);
+}
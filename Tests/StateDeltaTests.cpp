@@ -0,0 +1,80 @@
+#include "Tests.h"
+#include "BitStream.h"
+#include "GameSnapshot.h"
+#include "GameWorld.h"
+#include "StateDelta.h"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace
+{
+	void testStateDelta()
+	{
+		std::unique_ptr<GameWorld> world = std::make_unique<GameWorld>(3);
+
+		//a few states far enough apart for kills, shots and barrier damage
+		std::vector<GameSnapshot> states(4);
+
+		for (GameSnapshot& state : states)
+		{
+			play(*world, (int)world->getFrame(), 400);
+			world->save(state);
+			keepReplicated(state);
+		}
+
+		GameSnapshot empty;
+		std::memset(&empty, 0, sizeof(empty));
+
+		for (size_t i = 0; i < states.size(); i++)
+		{
+			//against the state before it, and against nothing as a keyframe
+			const GameSnapshot* bases[2] =
+			{
+				(i > 0) ? &states[i - 1] : &empty, &empty
+			};
+
+			for (const GameSnapshot* base : bases)
+			{
+				std::vector<uint8_t> buffer;
+				BitWriter writer(buffer);
+				encodeDelta(*base, states[i], writer);
+				writer.finish();
+
+				GameSnapshot decoded;
+				BitReader reader(buffer.data(), (int)buffer.size());
+
+				CHECK(decodeDelta(*base, reader, decoded));
+				CHECK(hashSnapshot(decoded) == hashSnapshot(states[i]));
+
+				//cut short is refused rather than half applied
+				BitReader cut(buffer.data(), (int)buffer.size() / 2);
+				GameSnapshot partial;
+				CHECK(!decodeDelta(*base, cut, partial));
+			}
+		}
+
+		//nothing changed costs next to nothing
+		std::vector<uint8_t> same;
+		BitWriter writer(same);
+		encodeDelta(states[0], states[0], writer);
+		writer.finish();
+		CHECK(same.size() < 16);
+
+		//replication leaves out what only the stepping side needs
+		GameSnapshot state;
+		world->save(state);
+		GameSnapshot kept = state;
+		keepReplicated(kept);
+		keepReplicated(kept);
+		GameSnapshot twice = kept;
+		keepReplicated(twice);
+		CHECK(hashSnapshot(twice) == hashSnapshot(kept));
+	}
+
+
+
+
+	const TestCase registered("state_delta", testStateDelta);
+}
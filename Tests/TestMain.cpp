@@ -0,0 +1,105 @@
+#include "Tests.h"
+#include "Constants.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+*   Unit tests for the parts of the simulation replays and the network
+*   modes rely on being exact. Registered with CTest one test per case,
+*   the replay and network checks are CTest cases running ReplayTool and
+*   NetTool over a small bot corpus.
+*
+*   usage: InvadersTests [test]
+*
+*   Runs the named test, or every test, and prints each failed check with
+*   its line. Exits 1 if any check failed or the test isn't known.
+*/
+
+namespace
+{
+	struct Registered
+	{
+		const char* name;
+		void (*run)();
+	};
+
+	//built as the static TestCases are, before main
+	std::vector<Registered>& registry()
+	{
+		static std::vector<Registered> tests;
+		return tests;
+	}
+
+	int failures = 0;
+}
+
+TestCase::TestCase(const char* name, void (*run)())
+{
+	registry().push_back({ name, run });
+}
+
+
+
+void checkTest(bool passed, const char* condition, const char* file, int line)
+{
+	if (!passed)
+	{
+		std::cout << "  " << file << ":" << line << ": " << condition << "\n";
+		failures++;
+	}
+}
+
+
+
+WorldInput botInput(int tick)
+{
+	WorldInput input;
+	input.move = (tick / 40) % 3 - 1;
+	input.shoot = (tick % 9) == 0;
+
+	return input;
+}
+
+
+
+void play(GameWorld& world, int first, int ticks)
+{
+	for (int i = first; i < first + ticks; i++)
+	{
+		world.step(SIM_TIME_STEP, botInput(i));
+	}
+}
+
+
+
+int main(int argc, char** argv)
+{
+	std::string wanted = (argc > 1) ? argv[1] : "";
+	bool found = wanted.empty();
+
+	for (const Registered& test : registry())
+	{
+		if (!wanted.empty() && (wanted != test.name))
+		{
+			continue;
+		}
+
+		int before = failures;
+		found = true;
+
+		test.run();
+
+		std::cout << test.name << ": " <<
+			((failures == before) ? "ok" : "FAILED") << "\n";
+	}
+
+	if (!found)
+	{
+		std::cerr << "usage: InvadersTests [test]\n";
+		return 1;
+	}
+
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include "GameWorld.h"
+
+/** @file Tests.h
+    @brief   What every InvadersTests case is written with.
+    @details Each case is a function registered under a name with a
+             static TestCase in its own file, CTest runs them one name at
+             a time. CHECK records a failed condition with its file and
+             line and carries on, so one run reports every failure.
+*/
+
+#define CHECK(condition) checkTest((condition), #condition, __FILE__, __LINE__)
+
+/** @struct TestCase
+*   @brief registers run as the test called name
+*/
+struct TestCase
+{
+	TestCase(const char* name, void (*run)());
+};
+
+//count and print a failed check
+void checkTest(bool passed, const char* condition, const char* file, int line);
+
+//scripted input, the same for every run
+WorldInput botInput(int tick);
+
+//step world through ticks of botInput starting at first
+void play(GameWorld& world, int first, int ticks);
@@ -0,0 +1,102 @@
+#include "Tests.h"
+#include "WaveConfig.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace
+{
+	void testWaveConfig()
+	{
+		WaveTable table;
+		std::string error;
+
+		//an empty file is the built in defaults
+		WaveTable defaults = defaultWaves();
+		CHECK(isWaveTableValid(defaults));
+		CHECK(parseWaves("", table, error));
+		CHECK(std::memcmp(&table, &defaults, sizeof(table)) == 0);
+
+		const char* text =
+			"[formation]\n"
+			"rows = 3 # comment\n"
+			"columns = 6\n"
+			"step_x = 12\n"
+			"[row]\n"
+			"score = 50\n"
+			"sprite = 1\n"
+			"[difficulty]\n"
+			"min_y = 0\n"
+			"move_interval = 0.5\n"
+			"shoot_odds = 100\n"
+			"[difficulty]\n"
+			"min_y = 200\n"
+			"move_interval = 0.25\n"
+			"shoot_odds = 50\n";
+
+		CHECK(parseWaves(text, table, error));
+		CHECK((table.rows == 3) && (table.columns == 6));
+		CHECK(table.step_x == 12);
+		CHECK(table.difficulty_count == 2);
+		CHECK(table.difficulty[1].shoot_odds == 50);
+
+		//rows not listed copy the last one given
+		CHECK((table.row[2].score == 50) && (table.row[2].sprite == 1));
+
+		//errors name the line
+		struct Bad
+		{
+			const char* text;
+			const char* error;
+		};
+
+		const Bad bad[] =
+		{
+			{ "[difficulty]\nshoot_odds = -1\n", "line 2" },
+			{ "[difficulty]\nshoot_odds = 0\n", "line 2" },
+			{ "[difficulty]\nmove_interval = 0\n", "line 2" },
+			{ "[difficulty]\nmove_interval = nan\n", "line 2" },
+			{ "[formation]\nstep_x = 128\n", "line 2" },
+			{ "[formation]\nrows = 9\n", "line 2" },
+			{ "[formation]\ncolumns = 0\n", "line 2" },
+			{ "[formation]\n\nspeed = 1\n", "line 3" },
+			{ "[formation]\nrows = three\n", "line 2" },
+			{ "[nothing]\n", "line 1" },
+			{ "[row\n", "line 1" },
+			{ "rows = 3\n", "line 1" },
+			{ "[difficulty]\nmin_y = 10\n[difficulty]\nmin_y = 5\n", "line 4" }
+		};
+
+		for (const Bad& entry : bad)
+		{
+			WaveTable untouched = defaults;
+			error.clear();
+
+			CHECK(!parseWaves(entry.text, untouched, error));
+			CHECK(error.find(entry.error) == 0);
+			CHECK(std::memcmp(&untouched, &defaults, sizeof(untouched)) == 0);
+		}
+
+		//a compiled table round trips, a damaged one is refused
+		const char* path = "invaders_tests.bin";
+		WaveTable loaded;
+
+		CHECK(saveWaves(path, table));
+		CHECK(loadWaves(path, loaded));
+		CHECK(std::memcmp(&loaded, &table, sizeof(loaded)) == 0);
+
+		WaveTable broken = table;
+		broken.difficulty[0].shoot_odds = -1;
+		CHECK(!isWaveTableValid(broken));
+		CHECK(saveWaves(path, broken));
+		CHECK(!loadWaves(path, loaded));
+
+		std::remove(path);
+	}
+
+
+
+
+	const TestCase registered("wave_config", testWaveConfig);
+}
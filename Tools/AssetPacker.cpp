@@ -0,0 +1,266 @@
+#include "AssetPack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+*   Asset packer. Builds Resources.pak from the Resources directory.
+*
+*   usage: AssetPacker <resources dir> <output file>
+*
+*   WAV files are decoded to signed 16-bit PCM so the game can hand the
+*   samples to irrKlang directly, anything else under Audio is stored as is.
+*   Textures and fonts are not packed because ASGE only loads those from a
+*   file path.
+*/
+
+namespace fs = std::filesystem;
+
+struct PackedFile
+{
+	PackEntry entry;
+	std::vector<unsigned char> payload;
+};
+
+
+
+static uint32_t readU32(const unsigned char* bytes)
+{
+	return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) |
+		((uint32_t)bytes[3] << 24);
+}
+
+
+
+static uint16_t readU16(const unsigned char* bytes)
+{
+	return (uint16_t)(bytes[0] | (bytes[1] << 8));
+}
+
+
+
+static bool readFile(const fs::path& path, std::vector<unsigned char>& bytes)
+{
+	std::ifstream file(path, std::ios::binary);
+
+	if (!file)
+	{
+		return false;
+	}
+
+	bytes.assign(std::istreambuf_iterator<char>(file),
+		std::istreambuf_iterator<char>());
+
+	return true;
+}
+
+
+
+static bool decodeWav(const std::vector<unsigned char>& file, PackedFile& out)
+{
+	//walk the riff chunks looking for fmt and data
+	if ((file.size() < 12) || (memcmp(file.data(), "RIFF", 4) != 0) ||
+		(memcmp(file.data() + 8, "WAVE", 4) != 0))
+	{
+		return false;
+	}
+
+	uint16_t format_tag = 0;
+	uint16_t channels = 0;
+	uint32_t sample_rate = 0;
+	uint16_t bits = 0;
+	const unsigned char* samples = nullptr;
+	uint32_t sample_bytes = 0;
+
+	size_t pos = 12;
+	while (pos + 8 <= file.size())
+	{
+		const unsigned char* chunk = file.data() + pos;
+		uint32_t chunk_size = readU32(chunk + 4);
+
+		if (pos + 8 + chunk_size > file.size())
+		{
+			chunk_size = (uint32_t)(file.size() - pos - 8);
+		}
+
+		if ((memcmp(chunk, "fmt ", 4) == 0) && (chunk_size >= 16))
+		{
+			format_tag = readU16(chunk + 8);
+			channels = readU16(chunk + 10);
+			sample_rate = readU32(chunk + 12);
+			bits = readU16(chunk + 22);
+		}
+
+		else if (memcmp(chunk, "data", 4) == 0)
+		{
+			samples = chunk + 8;
+			sample_bytes = chunk_size;
+		}
+
+		//chunks are word aligned
+		pos += 8 + chunk_size + (chunk_size & 1);
+	}
+
+	//1 = integer pcm, 0xFFFE = extensible (assumed integer pcm)
+	bool integer_pcm = (format_tag == 1) || (format_tag == 0xFFFE);
+
+	if (!integer_pcm || !samples || (channels < 1) || (channels > 2) ||
+		((bits != 8) && (bits != 16) && (bits != 24) && (bits != 32)))
+	{
+		return false;
+	}
+
+	uint32_t bytes_per_sample = bits / 8;
+	uint32_t sample_count = sample_bytes / bytes_per_sample;
+	sample_count -= sample_count % channels;
+
+	out.payload.resize(sample_count * 2);
+
+	//convert every sample to signed 16-bit little endian
+	for (uint32_t i = 0; i < sample_count; i++)
+	{
+		const unsigned char* sample = samples + i * bytes_per_sample;
+		int16_t value = 0;
+
+		if (bits == 8)
+		{
+			value = (int16_t)((sample[0] - 128) << 8);
+		}
+
+		else
+		{
+			//keep the two most significant bytes
+			value = (int16_t)readU16(sample + bytes_per_sample - 2);
+		}
+
+		out.payload[i * 2] = (unsigned char)(value & 0xFF);
+		out.payload[i * 2 + 1] = (unsigned char)((value >> 8) & 0xFF);
+	}
+
+	out.entry.type = (uint32_t)PackEntryType::PCM;
+	out.entry.sample_rate = sample_rate;
+	out.entry.channels = channels;
+	out.entry.frames = sample_count / channels;
+
+	return true;
+}
+
+
+
+int main(int argc, char** argv)
+{
+	if (argc != 3)
+	{
+		std::cerr << "usage: AssetPacker <resources dir> <output file>\n";
+		return 1;
+	}
+
+	fs::path root = argv[1];
+	std::vector<PackedFile> files;
+
+	if (!fs::is_directory(root / "Audio"))
+	{
+		std::cerr << "no Audio directory under " << root << "\n";
+		return 1;
+	}
+
+	for (const auto& item : fs::recursive_directory_iterator(root / "Audio"))
+	{
+		if (!item.is_regular_file())
+		{
+			continue;
+		}
+
+		std::string name = item.path().lexically_relative(root).generic_string();
+
+		if (name.size() >= sizeof(PackEntry::name))
+		{
+			std::cerr << "name too long for archive index: " << name << "\n";
+			return 1;
+		}
+
+		std::vector<unsigned char> bytes;
+		if (!readFile(item.path(), bytes))
+		{
+			std::cerr << "failed to read " << item.path() << "\n";
+			return 1;
+		}
+
+		PackedFile packed;
+		memset(&packed.entry, 0, sizeof(PackEntry));
+		strcpy(packed.entry.name, name.c_str());
+
+		std::string extension = item.path().extension().string();
+		std::transform(extension.begin(), extension.end(),
+			extension.begin(), ::tolower);
+
+		if ((extension != ".wav") || !decodeWav(bytes, packed))
+		{
+			//irrKlang decodes these itself through the file factory
+			packed.entry.type = (uint32_t)PackEntryType::RAW;
+			packed.payload = std::move(bytes);
+		}
+
+		packed.entry.size = (uint32_t)packed.payload.size();
+		files.push_back(std::move(packed));
+	}
+
+	//the game binary searches the index by name
+	std::sort(files.begin(), files.end(),
+		[](const PackedFile& a, const PackedFile& b)
+	{
+		return strcmp(a.entry.name, b.entry.name) < 0;
+	});
+
+	std::ofstream out(argv[2], std::ios::binary);
+	if (!out)
+	{
+		std::cerr << "failed to create " << argv[2] << "\n";
+		return 1;
+	}
+
+	PackHeader header;
+	memcpy(header.magic, "IPAK", 4);
+	header.version = PACK_VERSION;
+	header.entry_count = (uint32_t)files.size();
+	header.index_offset = 0;
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	//payloads first, each aligned, index last
+	uint32_t offset = sizeof(PackHeader);
+	const char padding[PACK_ALIGNMENT] = { 0 };
+
+	for (auto& file : files)
+	{
+		uint32_t aligned = (offset + PACK_ALIGNMENT - 1) & ~(PACK_ALIGNMENT - 1);
+		out.write(padding, aligned - offset);
+
+		file.entry.offset = aligned;
+		out.write(reinterpret_cast<const char*>(file.payload.data()),
+			file.payload.size());
+
+		offset = aligned + file.entry.size;
+	}
+
+	header.index_offset = (offset + PACK_ALIGNMENT - 1) & ~(PACK_ALIGNMENT - 1);
+	out.write(padding, header.index_offset - offset);
+
+	for (const auto& file : files)
+	{
+		out.write(reinterpret_cast<const char*>(&file.entry), sizeof(PackEntry));
+
+		std::cout << file.entry.name << " " << file.entry.size << " bytes" <<
+			(file.entry.type == (uint32_t)PackEntryType::PCM ? " pcm" : " raw")
+			<< "\n";
+	}
+
+	out.seekp(0);
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	return out ? 0 : 1;
+}
@@ -0,0 +1,534 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+*   Asset registry generator. Writes AssetRegistry.h, the enum and
+*   metadata table every asset reference in the game goes through.
+*
+*   usage: AssetRegistry <resources dir> <source dir> <output header>
+*          [generated file]...
+*
+*   Every file under the resources dir gets an enumerator named after its
+*   kind and file name, Textures/Alien2.png is TEXTURE_ALIEN2 and
+*   Audio/Laser1.wav is SOUND_LASER1. Anything that isn't a texture, sound
+*   or font is DATA_ plus its whole path, so Config/Waves.txt can't clash
+*   with Waves.bin. Generated files, which may not exist yet when this
+*   runs, are named on the command line and get no metadata. Imported is
+*   left out, TextureImporter's copies go by their originals' names.
+*
+*   Only enumerators some source file under the source dir mentions are
+*   written, unused assets never reach the game and a reference to a file
+*   that isn't there fails to compile. The header is only rewritten when
+*   it changes so regenerating doesn't rebuild the game.
+*/
+
+namespace fs = std::filesystem;
+
+struct Asset
+{
+	std::string name;       //path relative to Resources
+	std::string enumerator; //TEXTURE_ALIEN2
+	std::string format;     //AssetFormat enumerator
+	uint32_t width =        0;
+	uint32_t height =       0;
+	uint32_t duration_ms =  0;
+};
+
+
+
+static uint32_t readU32(const unsigned char* bytes)
+{
+	return bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) |
+		((uint32_t)bytes[3] << 24);
+}
+
+
+
+static uint32_t readBigU32(const unsigned char* bytes)
+{
+	return ((uint32_t)bytes[0] << 24) | (bytes[1] << 16) | (bytes[2] << 8) |
+		bytes[3];
+}
+
+
+
+static uint16_t readBigU16(const unsigned char* bytes)
+{
+	return (uint16_t)((bytes[0] << 8) | bytes[1]);
+}
+
+
+
+static bool readFile(const fs::path& path, std::vector<unsigned char>& bytes)
+{
+	std::ifstream file(path, std::ios::binary);
+
+	if (!file)
+	{
+		return false;
+	}
+
+	bytes.assign(std::istreambuf_iterator<char>(file),
+		std::istreambuf_iterator<char>());
+
+	return true;
+}
+
+
+
+static bool readPng(const std::vector<unsigned char>& file, Asset& asset)
+{
+	//signature then IHDR, which always comes first
+	static const unsigned char SIGNATURE[8] =
+		{ 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+	if ((file.size() < 24) || (memcmp(file.data(), SIGNATURE, 8) != 0) ||
+		(memcmp(file.data() + 12, "IHDR", 4) != 0))
+	{
+		return false;
+	}
+
+	asset.width = readBigU32(file.data() + 16);
+	asset.height = readBigU32(file.data() + 20);
+
+	return true;
+}
+
+
+
+static bool readJpeg(const std::vector<unsigned char>& file, Asset& asset)
+{
+	if ((file.size() < 4) || (file[0] != 0xFF) || (file[1] != 0xD8))
+	{
+		return false;
+	}
+
+	//walk the segments to the first start of frame
+	size_t pos = 2;
+
+	while (pos + 9 <= file.size())
+	{
+		if (file[pos] != 0xFF)
+		{
+			return false;
+		}
+
+		unsigned char marker = file[pos + 1];
+		uint16_t length = readBigU16(file.data() + pos + 2);
+
+		//SOF0 to SOF15 apart from DHT, JPG and DAC
+		bool frame = (marker >= 0xC0) && (marker <= 0xCF) &&
+			(marker != 0xC4) && (marker != 0xC8) && (marker != 0xCC);
+
+		if (frame)
+		{
+			asset.height = readBigU16(file.data() + pos + 5);
+			asset.width = readBigU16(file.data() + pos + 7);
+			return true;
+		}
+
+		pos += 2 + length;
+	}
+
+	return false;
+}
+
+
+
+static bool readWav(const std::vector<unsigned char>& file, Asset& asset)
+{
+	//walk the riff chunks looking for fmt and data
+	if ((file.size() < 12) || (memcmp(file.data(), "RIFF", 4) != 0) ||
+		(memcmp(file.data() + 8, "WAVE", 4) != 0))
+	{
+		return false;
+	}
+
+	uint32_t byte_rate = 0;
+	uint32_t sample_bytes = 0;
+
+	size_t pos = 12;
+	while (pos + 8 <= file.size())
+	{
+		const unsigned char* chunk = file.data() + pos;
+		uint32_t chunk_size = readU32(chunk + 4);
+
+		if (pos + 8 + chunk_size > file.size())
+		{
+			chunk_size = (uint32_t)(file.size() - pos - 8);
+		}
+
+		if ((memcmp(chunk, "fmt ", 4) == 0) && (chunk_size >= 16))
+		{
+			byte_rate = readU32(chunk + 16);
+		}
+
+		else if (memcmp(chunk, "data", 4) == 0)
+		{
+			sample_bytes = chunk_size;
+		}
+
+		//chunks are word aligned
+		pos += 8 + chunk_size + (chunk_size & 1);
+	}
+
+	if (byte_rate == 0)
+	{
+		return false;
+	}
+
+	asset.duration_ms = (uint32_t)((uint64_t)sample_bytes * 1000 / byte_rate);
+
+	return true;
+}
+
+
+
+//upper case, camel case and punctuation split with underscores
+static std::string toEnumerator(const std::string& text)
+{
+	std::string out;
+
+	for (size_t i = 0; i < text.size(); i++)
+	{
+		unsigned char c = (unsigned char)text[i];
+
+		if (!std::isalnum(c))
+		{
+			if (!out.empty() && (out.back() != '_'))
+			{
+				out += '_';
+			}
+
+			continue;
+		}
+
+		if ((i > 0) && std::isupper(c) &&
+			std::islower((unsigned char)text[i - 1]) && (out.back() != '_'))
+		{
+			out += '_';
+		}
+
+		out += (char)std::toupper(c);
+	}
+
+	while (!out.empty() && (out.back() == '_'))
+	{
+		out.pop_back();
+	}
+
+	return out;
+}
+
+
+
+static Asset describe(const std::string& name)
+{
+	Asset asset;
+	asset.name = name;
+
+	fs::path path(name);
+	std::string extension = path.extension().string();
+	std::transform(extension.begin(), extension.end(),
+		extension.begin(), ::tolower);
+
+	std::string stem = path.stem().string();
+
+	if (extension == ".png")
+	{
+		asset.enumerator = "TEXTURE_" + toEnumerator(stem);
+		asset.format = "PNG";
+	}
+
+	else if ((extension == ".jpg") || (extension == ".jpeg"))
+	{
+		asset.enumerator = "TEXTURE_" + toEnumerator(stem);
+		asset.format = "JPEG";
+	}
+
+	else if (extension == ".wav")
+	{
+		asset.enumerator = "SOUND_" + toEnumerator(stem);
+		asset.format = "WAV";
+	}
+
+	else if (extension == ".ttf")
+	{
+		asset.enumerator = "FONT_" + toEnumerator(stem);
+		asset.format = "TTF";
+	}
+
+	else
+	{
+		std::string whole = (path.parent_path() / path.stem()).generic_string();
+		asset.enumerator = "DATA_" + toEnumerator(whole);
+		asset.format = "DATA";
+	}
+
+	return asset;
+}
+
+
+
+//every identifier in the game's sources
+static void collectIdentifiers(const fs::path& source_dir,
+	const fs::path& output, std::set<std::string>& identifiers)
+{
+	std::error_code error;
+
+	for (const auto& item : fs::recursive_directory_iterator(source_dir, error))
+	{
+		std::string extension = item.path().extension().string();
+
+		if (!item.is_regular_file() ||
+			((extension != ".cpp") && (extension != ".h")) ||
+			fs::equivalent(item.path(), output, error))
+		{
+			continue;
+		}
+
+		std::vector<unsigned char> bytes;
+		readFile(item.path(), bytes);
+
+		std::string word;
+
+		for (unsigned char c : bytes)
+		{
+			if (std::isalnum(c) || (c == '_'))
+			{
+				word += (char)c;
+			}
+
+			else if (!word.empty())
+			{
+				identifiers.insert(word);
+				word.clear();
+			}
+		}
+
+		if (!word.empty())
+		{
+			identifiers.insert(word);
+		}
+	}
+}
+
+
+
+static std::string generate(const std::vector<Asset>& used,
+	const std::vector<std::string>& stripped)
+{
+	std::ostringstream out;
+
+	out <<
+		"#pragma once\n"
+		"#include <cstdint>\n"
+		"\n"
+		"/** @file AssetRegistry.h\n"
+		"    @brief   Every asset the game uses, generated by Tools/AssetRegistry.\n"
+		"    @details Do not edit, the build regenerates this from Resources and\n"
+		"             the enumerators mentioned in Source. An Asset is also the\n"
+		"             AssetId its name interns to, InvadersGame interns them in\n"
+		"             order at start up.\n"
+		"*/\n"
+		"\n"
+		"/** @enum AssetFormat\n"
+		"*   @brief what an asset's bytes are\n"
+		"*/\n"
+		"enum class AssetFormat : uint8_t\n"
+		"{\n"
+		"\tDATA = 0, /**< anything else, or generated by the build */\n"
+		"\tPNG =  1,\n"
+		"\tJPEG = 2,\n"
+		"\tWAV =  3,\n"
+		"\tTTF =  4\n"
+		"};\n"
+		"\n"
+		"/** @struct AssetInfo\n"
+		"*   @brief what the generator read from an asset's file\n"
+		"*/\n"
+		"struct AssetInfo\n"
+		"{\n"
+		"\tconst char* name;      /**< path relative to Resources */\n"
+		"\tAssetFormat format;\n"
+		"\tuint16_t    width;     /**< textures only, pixels */\n"
+		"\tuint16_t    height;    /**< textures only, pixels */\n"
+		"\tuint32_t    duration;  /**< sounds only, milliseconds */\n"
+		"};\n"
+		"\n"
+		"enum Asset : int32_t\n"
+		"{\n";
+
+	for (size_t i = 0; i < used.size(); i++)
+	{
+		out << "\t" << used[i].enumerator << (i == 0 ? " = 0" : "") << ",\n";
+	}
+
+	out <<
+		"\tASSET_COUNT\n"
+		"};\n"
+		"\n"
+		"constexpr AssetInfo ASSET_INFO[ASSET_COUNT] =\n"
+		"{\n";
+
+	for (size_t i = 0; i < used.size(); i++)
+	{
+		const Asset& asset = used[i];
+
+		out << "\t{ \"" << asset.name << "\", AssetFormat::" << asset.format <<
+			", " << asset.width << ", " << asset.height << ", " <<
+			asset.duration_ms << " }" << (i + 1 < used.size() ? "," : "") << "\n";
+	}
+
+	out << "};\n";
+
+	if (!stripped.empty())
+	{
+		out << "\n//not referenced by the game, stripped\n";
+
+		for (const std::string& name : stripped)
+		{
+			out << "//  " << name << "\n";
+		}
+	}
+
+	return out.str();
+}
+
+
+
+int main(int argc, char** argv)
+{
+	if (argc < 4)
+	{
+		std::cerr << "usage: AssetRegistry <resources dir> <source dir> "
+			"<output header> [generated file]...\n";
+		return 1;
+	}
+
+	fs::path root = argv[1];
+	fs::path output = argv[3];
+
+	if (!fs::is_directory(root))
+	{
+		std::cerr << "no resources directory " << root << "\n";
+		return 1;
+	}
+
+	//names in path order so ids are stable between runs
+	std::set<std::string> names;
+
+	for (auto item = fs::recursive_directory_iterator(root);
+		item != fs::recursive_directory_iterator(); ++item)
+	{
+		if (item->is_directory() && (item.depth() == 0) &&
+			(item->path().filename() == "Imported"))
+		{
+			item.disable_recursion_pending();
+		}
+
+		else if (item->is_regular_file())
+		{
+			names.insert(item->path().lexically_relative(root).generic_string());
+		}
+	}
+
+	for (int i = 4; i < argc; i++)
+	{
+		names.insert(fs::path(argv[i]).generic_string());
+	}
+
+	std::set<std::string> identifiers;
+	collectIdentifiers(argv[2], output, identifiers);
+
+	std::vector<Asset> used;
+	std::vector<std::string> stripped;
+	std::map<std::string, std::string> owners;
+
+	for (const std::string& name : names)
+	{
+		Asset asset = describe(name);
+
+		if (owners.count(asset.enumerator))
+		{
+			std::cerr << name << " and " << owners[asset.enumerator] <<
+				" are both " << asset.enumerator << "\n";
+			return 1;
+		}
+
+		owners[asset.enumerator] = name;
+
+		if (!identifiers.count(asset.enumerator))
+		{
+			stripped.push_back(name);
+			continue;
+		}
+
+		//generated files may not have been built yet
+		std::vector<unsigned char> bytes;
+
+		if (readFile(root / name, bytes))
+		{
+			bool read = true;
+
+			if (asset.format == "PNG")
+			{
+				read = readPng(bytes, asset);
+			}
+
+			else if (asset.format == "JPEG")
+			{
+				read = readJpeg(bytes, asset);
+			}
+
+			else if (asset.format == "WAV")
+			{
+				read = readWav(bytes, asset);
+			}
+
+			if (!read)
+			{
+				std::cerr << "can't read " << asset.format << " header of " <<
+					name << "\n";
+				return 1;
+			}
+		}
+
+		used.push_back(asset);
+	}
+
+	std::string header = generate(used, stripped);
+
+	//leave the file alone if nothing changed
+	std::vector<unsigned char> existing;
+
+	if (readFile(output, existing) &&
+		(std::string(existing.begin(), existing.end()) == header))
+	{
+		return 0;
+	}
+
+	std::ofstream out(output, std::ios::binary | std::ios::trunc);
+	out << header;
+
+	if (!out)
+	{
+		std::cerr << "failed to write " << output << "\n";
+		return 1;
+	}
+
+	std::cout << output.string() << ": " << used.size() << " assets, " <<
+		stripped.size() << " stripped\n";
+
+	return 0;
+}
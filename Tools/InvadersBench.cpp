@@ -0,0 +1,239 @@
+#include "BatchSim.h"
+#include "Constants.h"
+#include "GameWorld.h"
+#include "JobSystem.h"
+#include "ParticleSystem.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+*   Benchmarks for the parts of the game that run every frame, without a
+*   window or sound so they can run on build machines.
+*
+*   usage: InvadersBench [seconds per case]
+*
+*   Each case is repeated until it has run for the given time (half a
+*   second by default) and reports the mean cost of one operation.
+*/
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	double seconds_per_case = 0.5;
+
+	//run body until the time is up, body returns operations it performed
+	void measure(const std::string& name, std::function<long long()> body)
+	{
+		long long operations = 0;
+		Clock::time_point start = Clock::now();
+		double elapsed = 0;
+
+		while (elapsed < seconds_per_case)
+		{
+			operations += body();
+			elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+		}
+
+		double nanoseconds = elapsed * 1e9 / operations;
+
+		std::cout << std::left << std::setw(24) << name << std::right <<
+			std::fixed << std::setprecision(1) << std::setw(12) <<
+			nanoseconds << " ns/op" << std::setw(14) << std::setprecision(0) <<
+			operations / elapsed << " op/s\n";
+	}
+
+	//scripted player, sweeps side to side while firing
+	WorldInput scriptedInput(uint32_t frame)
+	{
+		WorldInput input;
+		input.move = ((frame / 90) % 2) ? 1 : -1;
+		input.shoot = true;
+		return input;
+	}
+
+	void benchWorld(JobSystem* jobs, const std::string& name)
+	{
+		GameWorld world(42, jobs);
+		world.reset();
+
+		measure(name, [&world]()
+		{
+			for (int i = 0; i < 1000; i++)
+			{
+				world.step(SIM_TIME_STEP, scriptedInput(world.getFrame()));
+
+				if (world.isGameOver())
+				{
+					world.reset();
+				}
+			}
+
+			return 1000LL;
+		});
+	}
+
+	void benchBatch(int count)
+	{
+		InvadersBatch* batch = invaders_batch_create(count, 42);
+
+		int size = invaders_batch_observation_size();
+		std::vector<float> observations((size_t)size * count);
+		std::vector<float> rewards(count);
+		std::vector<uint8_t> dones(count);
+		std::vector<uint8_t> actions(count, INVADERS_RIGHT | INVADERS_SHOOT);
+
+		invaders_batch_reset(batch, observations.data());
+
+		measure("batch step x" + std::to_string(count), [&]()
+		{
+			for (int i = 0; i < 16; i++)
+			{
+				invaders_batch_step(batch, actions.data(), observations.data(),
+					rewards.data(), dones.data());
+			}
+
+			//one operation is one instance stepped
+			return 16LL * count;
+		});
+
+		invaders_batch_destroy(batch);
+	}
+
+	void benchSnapshots()
+	{
+		GameWorld world(42);
+		world.reset();
+
+		for (int i = 0; i < 3000; i++)
+		{
+			world.step(SIM_TIME_STEP, scriptedInput(world.getFrame()));
+		}
+
+		GameSnapshot snapshot;
+
+		measure("snapshot save", [&]()
+		{
+			for (int i = 0; i < 1000; i++)
+			{
+				world.save(snapshot);
+			}
+
+			return 1000LL;
+		});
+
+		measure("snapshot restore", [&]()
+		{
+			for (int i = 0; i < 1000; i++)
+			{
+				world.restore(snapshot);
+			}
+
+			return 1000LL;
+		});
+
+		measure("snapshot hash", [&]()
+		{
+			volatile uint64_t hash = 0;
+
+			for (int i = 0; i < 1000; i++)
+			{
+				hash = hash + hashSnapshot(snapshot);
+			}
+
+			return 1000LL;
+		});
+	}
+
+	void benchParticles()
+	{
+		//too big for the stack
+		std::unique_ptr<ParticleSystem> particles =
+			std::make_unique<ParticleSystem>();
+
+		measure("particles full update", [&]()
+		{
+			//long lived so the pool stays full
+			while (particles->getCount() < MAX_PARTICLES)
+			{
+				particles->spawnBurst(640, 100, MAX_PARTICLES, 100, 100);
+			}
+
+			for (int i = 0; i < 100; i++)
+			{
+				particles->update(0.0001f);
+			}
+
+			return 100LL;
+		});
+	}
+
+	void benchBarriers()
+	{
+		Barrier barrier;
+		int shot = 0;
+
+		measure("barrier hit and erode", [&]()
+		{
+			for (int i = 0; i < 1000; i++)
+			{
+				if (!barrier.getAlive())
+				{
+					barrier.resetBarrier();
+				}
+
+				//walk shots across the barrier from alternate sides
+				int x = (shot * 7) % BARRIER_WIDTH;
+				int row = barrier.hitTest(x, 0, x + 5, BARRIER_HEIGHT,
+					(shot & 1) != 0);
+
+				if (row >= 0)
+				{
+					barrier.erode(x + 2, row);
+				}
+
+				shot++;
+			}
+
+			return 1000LL;
+		});
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc > 2)
+	{
+		std::cerr << "usage: InvadersBench [seconds per case]\n";
+		return 1;
+	}
+
+	if (argc == 2)
+	{
+		seconds_per_case = std::atof(argv[1]);
+
+		if (seconds_per_case <= 0)
+		{
+			std::cerr << "seconds per case must be positive\n";
+			return 1;
+		}
+	}
+
+	JobSystem jobs;
+
+	benchWorld(nullptr, "world step");
+	benchWorld(&jobs, "world step jobs");
+	benchBatch(256);
+	benchSnapshots();
+	benchParticles();
+	benchBarriers();
+
+	return 0;
+}
@@ -0,0 +1,704 @@
+#include "Broadcast.h"
+#include "Constants.h"
+#include "GameWorld.h"
+#include "Lockstep.h"
+#include "Replay.h"
+#include "Replication.h"
+#include "Rollback.h"
+#include "Socket.h"
+#include "StateDelta.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+*   Network tool. Plays recorded games through the network modes on the
+*   loopback interface and checks what arrives.
+*
+*   usage: NetTool replicate <clients> <replay or dir>...
+*          NetTool lockstep [--desync <tick>] <replay or dir>...
+*          NetTool rollback [--lag <ticks>] <replay or dir>...
+*          NetTool spectate [--stall <viewers>] <viewers> <replay or dir>...
+*
+*   replicate steps each replay on a host that serves the given number
+*   of clients, every one its own connection in this process. After each
+*   tick every client that has the newest state must hold exactly the
+*   host's replicated state, a state that never arrives or differs is a
+*   failure. It reports the bytes each client was sent per tick, framing
+*   included, against the size of a raw snapshot, and what the host spent
+*   encoding and sending per client per tick.
+*
+*   lockstep plays each replay's input on a hosting peer with a second
+*   peer joined to it, each stepping its own world. The game passes when
+*   both worlds finish in the same state with no desync reported, and
+*   the bytes each peer sent per tick are reported, the host's starting
+*   snapshot left out. With --desync the joined peer's score is nudged at
+*   that tick instead, and the game passes when both peers report the
+*   desync and write their dumps.
+*
+*   rollback gives both peers each replay's input, which merges back to
+*   the replay's own, and has each read the other only every lag ticks,
+*   4 by default, so they step ahead on guesses and correct them. Both
+*   worlds have to finish in the state a plain world stepped through the
+*   same input ends in. It reports how often and how far they went back
+*   and the worst time a frame spent going back and stepping forward.
+*
+*   spectate broadcasts each replay to the given number of viewers, each
+*   reading its own connection after every tick. Every viewer that has
+*   the newest tick must hold exactly the broadcast state, and a viewer
+*   more than a keyframe interval behind is a failure. With --stall that
+*   many more viewers connect and never read, they have to be dropped
+*   without holding up the rest. It reports the bytes each viewer was
+*   sent per tick and what the broadcast spent per viewer per tick.
+*/
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	//expand directories into the replays inside them, sorted
+	std::vector<std::string> collect(int count, char** paths)
+	{
+		std::vector<std::string> files;
+
+		for (int i = 0; i < count; i++)
+		{
+			std::error_code error;
+
+			if (fs::is_directory(paths[i], error))
+			{
+				for (const fs::directory_entry& entry :
+					fs::directory_iterator(paths[i], error))
+				{
+					if (entry.path().extension() == ".rpl")
+					{
+						files.push_back(entry.path().string());
+					}
+				}
+			}
+
+			else
+			{
+				files.push_back(paths[i]);
+			}
+		}
+
+		std::sort(files.begin(), files.end());
+
+		return files;
+	}
+
+	int replicate(int client_count, const std::vector<std::string>& files)
+	{
+		std::unique_ptr<GameWorld> world = std::make_unique<GameWorld>();
+		ReplicationHost host;
+
+		if (!host.start(0))
+		{
+			std::cerr << "could not listen on loopback\n";
+			return 1;
+		}
+
+		std::vector<std::unique_ptr<ReplicationClient>> clients;
+
+		for (int i = 0; i < client_count; i++)
+		{
+			clients.push_back(std::make_unique<ReplicationClient>());
+
+			if (!clients.back()->connect(host.getPort()))
+			{
+				std::cerr << "client " << i << " could not connect\n";
+				return 1;
+			}
+
+			//take them as they come, the listen backlog is only so long
+			if ((i % 32) == 31)
+			{
+				host.update(*world);
+			}
+		}
+
+		int failed = 0;
+		uint64_t ticks = 0;
+		Clock::duration host_time{};
+		GameSnapshot expected;
+
+		for (const std::string& file : files)
+		{
+			Replay replay;
+
+			if (!replay.load(file.c_str()) || !replay.rewind(*world))
+			{
+				std::cout << file << ": unusable\n";
+				failed++;
+				continue;
+			}
+
+			int behind = 0;
+			int differ = 0;
+
+			for (int i = 0; i < replay.getTicks(); i++)
+			{
+				Clock::time_point start = Clock::now();
+
+				WorldInput input = host.mergeInput(replay.getInput(i));
+				world->step(replay.getTimeStep(i), input);
+				host.update(*world);
+
+				host_time += Clock::now() - start;
+
+				world->save(expected);
+				keepReplicated(expected);
+				uint64_t hash = hashSnapshot(expected);
+
+				for (std::unique_ptr<ReplicationClient>& client : clients)
+				{
+					client->update(WorldInput());
+
+					if (client->getSequence() != host.getSequence())
+					{
+						behind++;
+					}
+
+					else if (hashSnapshot(client->getState()) != hash)
+					{
+						differ++;
+					}
+				}
+			}
+
+			//replication mustn't change how the game plays out
+			GameSnapshot result;
+			world->save(result);
+
+			bool match = (hashSnapshot(result) == replay.getFinalHash()) &&
+				(behind == 0) && (differ == 0);
+			failed += match ? 0 : 1;
+			ticks += replay.getTicks();
+
+			std::cout << file << ": " << replay.getTicks() << " ticks, " <<
+				behind << " behind, " << differ << " differ, " <<
+				(match ? "ok" : "FAILED") << "\n";
+		}
+
+		if (ticks > 0)
+		{
+			double per_client = (double)ticks * client_count;
+			double nanoseconds = (double)std::chrono::duration_cast<
+				std::chrono::nanoseconds>(host_time).count();
+
+			std::cout << client_count << " clients, " <<
+				host.getBytesSent() / per_client << " bytes per tick each, " <<
+				"raw snapshot " << sizeof(GameSnapshot) << " bytes, host " <<
+				nanoseconds / per_client << " ns per client per tick\n";
+		}
+
+		return failed ? 1 : 0;
+	}
+
+	//poll then step at most one tick, as a frame of the game would
+	void advance(Lockstep& peer, GameWorld& world)
+	{
+		peer.poll(world);
+
+		WorldInput merged;
+
+		if (peer.nextInput(merged))
+		{
+			world.step(SIM_TIME_STEP, merged);
+			peer.endTick(world);
+		}
+	}
+
+	int lockstep(int desync_tick, const std::vector<std::string>& files)
+	{
+		std::unique_ptr<GameWorld> worlds[2] =
+		{
+			std::make_unique<GameWorld>(),
+			std::make_unique<GameWorld>()
+		};
+
+		int failed = 0;
+		uint64_t ticks = 0;
+		uint64_t bytes[2] = {};
+
+		for (const std::string& file : files)
+		{
+			Replay replay;
+
+			if (!replay.load(file.c_str()) || !replay.rewind(*worlds[0]))
+			{
+				std::cout << file << ": unusable\n";
+				failed++;
+				continue;
+			}
+
+			//the joined world starts anywhere, the host's start replaces it
+			worlds[1]->reset();
+
+			Lockstep peers[2];
+
+			if (!peers[0].host(0) || !peers[1].join(peers[0].getPort()))
+			{
+				std::cerr << "could not connect the peers\n";
+				return 1;
+			}
+
+			for (int spin = 0; (spin < 1000) &&
+				!(peers[0].isStarted() && peers[1].isStarted()); spin++)
+			{
+				peers[0].poll(*worlds[0]);
+				peers[1].poll(*worlds[1]);
+			}
+
+			uint64_t start_bytes[2] =
+			{
+				peers[0].getBytesSent(), peers[1].getBytesSent()
+			};
+
+			bool stalled = false;
+
+			for (int i = 0; (i < replay.getTicks()) && !stalled; i++)
+			{
+				if (i == desync_tick)
+				{
+					GameSnapshot nudged;
+					worlds[1]->save(nudged);
+					nudged.score++;
+					worlds[1]->restore(nudged);
+				}
+
+				peers[0].setInput(replay.getInput(i));
+				peers[1].setInput(WorldInput());
+
+				int spin = 0;
+
+				while ((peers[0].getTick() <= (uint32_t)i ||
+					peers[1].getTick() <= (uint32_t)i) && (spin++ < 1000))
+				{
+					advance(peers[0], *worlds[0]);
+					advance(peers[1], *worlds[1]);
+				}
+
+				stalled = spin > 1000;
+			}
+
+			//the last hashes may still be on their way
+			peers[0].poll(*worlds[0]);
+			peers[1].poll(*worlds[1]);
+
+			GameSnapshot results[2];
+			worlds[0]->save(results[0]);
+			worlds[1]->save(results[1]);
+
+			bool same = hashSnapshot(results[0]) == hashSnapshot(results[1]);
+			bool reported = peers[0].isDesynced() && peers[1].isDesynced();
+			bool quiet = !peers[0].isDesynced() && !peers[1].isDesynced();
+			bool match = !stalled && ((desync_tick < 0) ? (same && quiet) :
+				(!same && reported));
+
+			failed += match ? 0 : 1;
+			ticks += replay.getTicks();
+
+			for (int i = 0; i < 2; i++)
+			{
+				bytes[i] += peers[i].getBytesSent() - start_bytes[i];
+			}
+
+			std::cout << file << ": " << replay.getTicks() << " ticks, " <<
+				(stalled ? "stalled, " : "") <<
+				(same ? "same state" : "different states");
+
+			if (reported)
+			{
+				std::cout << ", desync in " << peers[0].getDumpPath() <<
+					" and " << peers[1].getDumpPath();
+			}
+
+			std::cout << ", " << (match ? "ok" : "FAILED") << "\n";
+		}
+
+		if (ticks > 0)
+		{
+			std::cout << "host " << (double)bytes[0] / ticks << ", join " <<
+				(double)bytes[1] / ticks << " bytes per tick, delay " <<
+				LOCKSTEP_DELAY << " ticks\n";
+		}
+
+		return failed ? 1 : 0;
+	}
+
+	int rollback(int lag, const std::vector<std::string>& files)
+	{
+		//two peers and the world they should both end up matching
+		std::unique_ptr<GameWorld> worlds[3] =
+		{
+			std::make_unique<GameWorld>(),
+			std::make_unique<GameWorld>(),
+			std::make_unique<GameWorld>()
+		};
+
+		int failed = 0;
+		uint64_t ticks = 0;
+		uint64_t rollbacks = 0;
+		uint64_t resimulated = 0;
+		int deepest = 0;
+		std::vector<Clock::duration> corrections; //frames that went back
+
+		for (const std::string& file : files)
+		{
+			Replay replay;
+
+			if (!replay.load(file.c_str()) || !replay.rewind(*worlds[0]) ||
+				!replay.rewind(*worlds[2]))
+			{
+				std::cout << file << ": unusable\n";
+				failed++;
+				continue;
+			}
+
+			worlds[1]->reset();
+
+			std::unique_ptr<Rollback> peers[2] =
+			{
+				std::make_unique<Rollback>(),
+				std::make_unique<Rollback>()
+			};
+
+			if (!peers[0]->host(0) || !peers[1]->join(peers[0]->getPort()))
+			{
+				std::cerr << "could not connect the peers\n";
+				return 1;
+			}
+
+			for (int spin = 0; (spin < 1000) &&
+				!(peers[0]->isStarted() && peers[1]->isStarted()); spin++)
+			{
+				peers[0]->poll(*worlds[0]);
+				peers[1]->poll(*worlds[1]);
+			}
+
+			bool stalled = false;
+
+			for (int i = 0; (i < replay.getTicks()) && !stalled; i++)
+			{
+				WorldInput input = replay.getInput(i);
+				worlds[2]->step(SIM_TIME_STEP, input);
+
+				for (int p = 0; p < 2; p++)
+				{
+					//each hears from the other half a lag apart
+					if (((i + p * lag / 2) % lag) == 0)
+					{
+						peers[p]->poll(*worlds[p]);
+					}
+
+					uint64_t before = peers[p]->getResimulated();
+					Clock::time_point start = Clock::now();
+
+					peers[p]->setInput(input);
+					stalled = stalled || (peers[p]->update(*worlds[p], 1) != 1);
+
+					if (peers[p]->getResimulated() != before)
+					{
+						corrections.push_back(Clock::now() - start);
+					}
+				}
+			}
+
+			//hear the last inputs and correct the last guesses
+			for (int pass = 0; pass < 2; pass++)
+			{
+				for (int p = 0; p < 2; p++)
+				{
+					peers[p]->poll(*worlds[p]);
+					peers[p]->update(*worlds[p], 0);
+				}
+			}
+
+			GameSnapshot results[3];
+			bool same = true;
+
+			for (int p = 0; p < 3; p++)
+			{
+				worlds[p]->save(results[p]);
+				same = same && (hashSnapshot(results[p]) ==
+					hashSnapshot(results[0]));
+			}
+
+			bool quiet = !peers[0]->isDesynced() && !peers[1]->isDesynced();
+			bool match = !stalled && same && quiet;
+			failed += match ? 0 : 1;
+			ticks += replay.getTicks();
+
+			for (int p = 0; p < 2; p++)
+			{
+				rollbacks += peers[p]->getRollbacks();
+				resimulated += peers[p]->getResimulated();
+				deepest = std::max(deepest, peers[p]->getDeepest());
+			}
+
+			std::cout << file << ": " << replay.getTicks() << " ticks, " <<
+				(stalled ? "stalled, " : "") <<
+				(same ? "same state" : "different states") <<
+				(quiet ? "" : ", desync reported") << ", " <<
+				(match ? "ok" : "FAILED") << "\n";
+		}
+
+		if (rollbacks > 0)
+		{
+			std::sort(corrections.begin(), corrections.end());
+
+			auto microseconds = [&](double at)
+			{
+				Clock::duration duration =
+					corrections[(size_t)(at * (corrections.size() - 1))];
+
+				return std::chrono::duration<double, std::micro>(
+					duration).count();
+			};
+
+			std::cout << rollbacks << " rollbacks over " << ticks <<
+				" ticks, " << (double)resimulated / rollbacks <<
+				" ticks back on average, " << deepest << " at most\n" <<
+				"frame going back and forward: p50 " << microseconds(0.5) <<
+				" us, p99 " << microseconds(0.99) << " us, max " <<
+				microseconds(1.0) << " us\n";
+		}
+
+		return failed ? 1 : 0;
+	}
+	int spectate(int viewer_count, int stall_count,
+		const std::vector<std::string>& files)
+	{
+		std::unique_ptr<GameWorld> world = std::make_unique<GameWorld>();
+		std::unique_ptr<Broadcast> broadcast = std::make_unique<Broadcast>();
+
+		if (!broadcast->start(0))
+		{
+			std::cerr << "could not listen on loopback\n";
+			return 1;
+		}
+
+		std::vector<std::unique_ptr<ReplicationClient>> viewers;
+		std::vector<Socket> stalled; //connected, never read
+
+		for (int i = 0; i < viewer_count + stall_count; i++)
+		{
+			bool connected;
+
+			if (i < viewer_count)
+			{
+				viewers.push_back(std::make_unique<ReplicationClient>());
+				connected = viewers.back()->connect(broadcast->getPort());
+			}
+
+			else
+			{
+				//a small window fills in seconds rather than minutes
+				stalled.emplace_back();
+				connected = stalled.back().connect(broadcast->getPort()) &&
+					stalled.back().setReceiveBuffer(4096);
+			}
+
+			if (!connected)
+			{
+				std::cerr << "viewer " << i << " could not connect\n";
+				return 1;
+			}
+
+			//take them as they come, the listen backlog is only so long
+			if ((i % 256) == 255)
+			{
+				broadcast->update(*world);
+			}
+		}
+
+		//the last to connect have their first turn
+		for (int i = 0; i <= BROADCAST_BATCH; i++)
+		{
+			broadcast->update(*world);
+		}
+
+		int failed = 0;
+		uint64_t ticks = 0;
+		uint64_t start_bytes = broadcast->getBytesSent();
+		Clock::duration host_time{};
+		GameSnapshot expected;
+		uint64_t hashes[BROADCAST_BATCH] = {}; //of the latest ticks
+
+		for (const std::string& file : files)
+		{
+			Replay replay;
+
+			if (!replay.load(file.c_str()) || !replay.rewind(*world))
+			{
+				std::cout << file << ": unusable\n";
+				failed++;
+				continue;
+			}
+
+			int behind = 0;
+			int differ = 0;
+			uint32_t first = broadcast->getSequence() + 1; //of this replay
+
+			for (int i = 0; i < replay.getTicks(); i++)
+			{
+				world->step(replay.getTimeStep(i), replay.getInput(i));
+
+				Clock::time_point start = Clock::now();
+				broadcast->update(*world);
+				host_time += Clock::now() - start;
+
+				world->save(expected);
+				keepReplicated(expected);
+				hashes[broadcast->getSequence() % BROADCAST_BATCH] =
+					hashSnapshot(expected);
+
+				//each is sent to in turn, so up to a batch behind
+				for (std::unique_ptr<ReplicationClient>& viewer : viewers)
+				{
+					viewer->receive();
+
+					uint32_t sequence = viewer->getSequence();
+
+					if (broadcast->getSequence() - sequence >= BROADCAST_BATCH)
+					{
+						behind++;
+					}
+
+					else if ((sequence >= first) &&
+						(hashSnapshot(viewer->getState()) !=
+						hashes[sequence % BROADCAST_BATCH]))
+					{
+						differ++;
+					}
+				}
+			}
+
+			//broadcasting mustn't change how the game plays out
+			GameSnapshot result;
+			world->save(result);
+
+			bool match = (hashSnapshot(result) == replay.getFinalHash()) &&
+				(behind == 0) && (differ == 0);
+			failed += match ? 0 : 1;
+			ticks += replay.getTicks();
+
+			std::cout << file << ": " << replay.getTicks() << " ticks, " <<
+				behind << " behind, " << differ << " differ, " <<
+				(match ? "ok" : "FAILED") << "\n";
+		}
+
+		//every stalled viewer has to have been let go
+		if (broadcast->getViewers() != viewer_count)
+		{
+			std::cout << broadcast->getViewers() - viewer_count <<
+				" stalled viewers still connected, FAILED\n";
+			failed++;
+		}
+
+		if (ticks > 0)
+		{
+			double per_viewer = (double)ticks * (viewer_count + stall_count);
+			double nanoseconds = (double)std::chrono::duration_cast<
+				std::chrono::nanoseconds>(host_time).count();
+
+			std::cout << viewer_count << " viewers, " <<
+				(broadcast->getBytesSent() - start_bytes) /
+				((double)ticks * viewer_count) << " bytes per tick each, " <<
+				broadcast->getSkips() << " skips, " << stall_count <<
+				" stalled, " << broadcast->getDropped() <<
+				" dropped, broadcast " << nanoseconds / per_viewer <<
+				" ns per viewer per tick\n";
+		}
+
+		return failed ? 1 : 0;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::string mode = (argc > 1) ? argv[1] : "";
+
+	if ((mode == "replicate") && (argc > 3) && (std::atoi(argv[2]) > 0))
+	{
+		std::vector<std::string> files = collect(argc - 3, argv + 3);
+
+		return replicate(std::atoi(argv[2]), files);
+	}
+
+	if ((mode == "lockstep") && (argc > 2))
+	{
+		int desync_tick = -1;
+		int first = 2;
+
+		if ((std::string(argv[2]) == "--desync") && (argc > 4))
+		{
+			desync_tick = std::atoi(argv[3]);
+			first = 4;
+		}
+
+		std::vector<std::string> files = collect(argc - first, argv + first);
+
+		return lockstep(desync_tick, files);
+	}
+
+	if ((mode == "rollback") && (argc > 2))
+	{
+		int lag = 4;
+		int first = 2;
+
+		if ((std::string(argv[2]) == "--lag") && (argc > 4))
+		{
+			lag = std::atoi(argv[3]);
+			first = 4;
+		}
+
+		//any later and a peer would run out of window waiting
+		if ((lag > 0) && (lag < ROLLBACK_WINDOW - 1))
+		{
+			std::vector<std::string> files = collect(argc - first,
+				argv + first);
+
+			return rollback(lag, files);
+		}
+	}
+
+	if ((mode == "spectate") && (argc > 3))
+	{
+		int stall_count = 0;
+		int first = 2;
+
+		if ((std::string(argv[2]) == "--stall") && (argc > 5))
+		{
+			stall_count = std::max(std::atoi(argv[3]), 0);
+			first = 4;
+		}
+
+		int viewer_count = std::atoi(argv[first]);
+
+		if ((viewer_count > 0) && (argc > first + 1))
+		{
+			std::vector<std::string> files = collect(argc - first - 1,
+				argv + first + 1);
+
+			return spectate(viewer_count, stall_count, files);
+		}
+	}
+
+	std::cerr << "usage: NetTool replicate <clients> <replay or dir>...\n"
+		"       NetTool lockstep [--desync <tick>] <replay or dir>...\n"
+		"       NetTool rollback [--lag <ticks>] <replay or dir>...\n"
+		"       NetTool spectate [--stall <viewers>] <viewers> "
+		"<replay or dir>...\n";
+	return 1;
+}
@@ -0,0 +1,822 @@
+#include "Constants.h"
+#include "GameWorld.h"
+#include "ParticleSystem.h"
+#include "Replay.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+*   Replay tool. Builds and plays the corpus of recorded games that the
+*   PGO build trains on.
+*
+*   usage: ReplayTool bot <output dir> <games> [max ticks]
+*          ReplayTool verify <replay or dir>...
+*          ReplayTool bench <replay or dir>...
+*          ReplayTool perf <report> <baseline> <threshold %> <replay or dir>...
+*
+*   bot records games played by a simple scripted player, as a stand in
+*   for human sessions, which the game writes to last_game.rpl at every
+*   game over. verify plays every replay and checks it ends in the state
+*   recorded. bench plays them as well and reports what one gameplay tick
+*   costs, the headless half of InvadersGame::updateGame: the world step
+*   plus the debris particles its explosions throw.
+*
+*   perf is the regression check. It plays the replays several times,
+*   timing each phase of the tick and counting the heap allocations made
+*   in it, and writes p50, p99 and max per phase to a JSON report. Between
+*   passes it also times a fixed reference loop that no change to the
+*   game touches. The report is compared against the baseline, a report
+*   kept from an earlier run, with the baseline's times scaled by how
+*   much slower or faster the reference ran here, so a baseline recorded
+*   on one machine holds on another. The check fails if a p50 or p99 is
+*   more than the threshold, and at least 50 ns, slower or any phase
+*   allocates more often. Max is reported but not compared as one
+*   preempted tick decides it. The corpus is kept with the baseline, the
+*   hashes of the states its games end in are reported and must match
+*   both what each replay recorded and what the baseline saw. Either
+*   differing means gameplay changed and the work timed with it, so the
+*   check fails until the corpus and baseline are recorded again. Without
+*   a baseline nothing is compared, copy a report over it to set one.
+*/
+
+//heap allocations made by this process, so ticks can be checked for them
+static std::atomic<uint64_t> allocations{ 0 };
+
+//these replace the global new and delete together, so memory from malloc
+//always goes back to free, GCC can't see the pair and warns otherwise
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(std::size_t size)
+{
+	allocations.fetch_add(1, std::memory_order_relaxed);
+
+	if (void* memory = std::malloc(size ? size : 1))
+	{
+		return memory;
+	}
+
+	throw std::bad_alloc();
+}
+
+
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+#pragma GCC diagnostic pop
+#endif
+
+namespace fs = std::filesystem;
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	/**
+	*   World and particles wired up the way InvadersGame wires them, so a
+	*   tick here costs what updateGame costs minus the rendering.
+	*/
+	struct Session
+	{
+		//context for one event type's debris subscription
+		struct Burst
+		{
+			Session* session;
+			int size;
+		};
+
+		GameWorld world;
+		ParticleSystem particles;
+		Burst bursts[4];
+
+		explicit Session(uint32_t seed = 1)
+			: world(seed)
+		{
+			subscribe(0, GameEventType::ALIEN_KILLED, DEBRIS_ALIEN);
+			subscribe(1, GameEventType::BARRIER_HIT, DEBRIS_BARRIER);
+			subscribe(2, GameEventType::MOTHERSHIP_KILLED, DEBRIS_MOTHERSHIP);
+			subscribe(3, GameEventType::PLAYER_HIT, DEBRIS_PLAYER);
+		}
+
+		Session(const Session&) = delete;
+		Session& operator=(const Session&) = delete;
+
+		void subscribe(int slot, GameEventType type, int size)
+		{
+			bursts[slot] = { this, size };
+
+			//same burst as InvadersGame::spawnExplosion
+			world.events.subscribeEffect(type,
+				[](void* context, const GameEvent* batch, int count)
+			{
+				Burst* burst = static_cast<Burst*>(context);
+
+				for (int i = 0; i < count; i++)
+				{
+					burst->session->particles.spawnBurst((float)batch[i].x,
+						(float)batch[i].y, burst->size, 4.0f * burst->size,
+						0.6f);
+				}
+			}, &bursts[slot]);
+		}
+
+		void tick(float dt, const WorldInput& input)
+		{
+			world.step(dt, input);
+			particles.update(dt);
+		}
+	};
+
+	//expand directories into the replays inside them, sorted
+	std::vector<std::string> collect(int count, char** paths)
+	{
+		std::vector<std::string> files;
+
+		for (int i = 0; i < count; i++)
+		{
+			std::error_code error;
+
+			if (fs::is_directory(paths[i], error))
+			{
+				for (const fs::directory_entry& entry :
+					fs::directory_iterator(paths[i], error))
+				{
+					if (entry.path().extension() == ".rpl")
+					{
+						files.push_back(entry.path().string());
+					}
+				}
+			}
+
+			else
+			{
+				files.push_back(paths[i]);
+			}
+		}
+
+		std::sort(files.begin(), files.end());
+
+		return files;
+	}
+
+	//heads for the lowest alien, steps out from under falling bullets,
+	//skill 0 never dodges and 8 always does
+	WorldInput botInput(GameWorld& world, uint32_t& rng, int skill)
+	{
+		rng ^= rng << 13;
+		rng ^= rng >> 17;
+		rng ^= rng << 5;
+
+		WorldInput input;
+		input.shoot = (rng % 8) != 0;
+
+		EntityStore& entities = world.entities;
+		int centre = entities.get<Position>(GameWorld::PLAYER)->x + 25;
+
+		//dodge first, careless bots only look up now and then
+		bool alert = (int)((rng >> 20) % 8) < skill;
+
+		const Position* bullet = entities.get<Position>(GameWorld::ALIEN_SHOTS);
+		const Life* bullet_life = entities.get<Life>(GameWorld::ALIEN_SHOTS);
+
+		for (int i = 0; i < entities.getCount(GameWorld::ALIEN_SHOTS); i++)
+		{
+			int offset = bullet[i].x - centre;
+
+			if (alert && bullet_life[i].alive && (bullet[i].y > 480) &&
+				(std::abs(offset) < 40))
+			{
+				input.move = (offset > 0) ? -1 : 1;
+				return input;
+			}
+		}
+
+		//now and then wander off so games don't all look alike
+		if (((rng >> 8) % 32) == 0)
+		{
+			input.move = ((rng >> 16) & 1) ? 1 : -1;
+			return input;
+		}
+
+		int target = -1;
+		int lowest = -1;
+
+		const Position* alien = entities.get<Position>(GameWorld::ALIENS);
+		AliveSet& alive = world.live_aliens;
+
+		for (int i = alive.next(0); i >= 0; i = alive.next(i + 1))
+		{
+			if (alien[i].y >= lowest)
+			{
+				int x = alien[i].x + 17;
+
+				if ((alien[i].y > lowest) ||
+					(std::abs(x - centre) < std::abs(target - centre)))
+				{
+					target = x;
+					lowest = alien[i].y;
+				}
+			}
+		}
+
+		if ((target >= 0) && (std::abs(target - centre) > 8))
+		{
+			input.move = (target > centre) ? 1 : -1;
+		}
+
+		return input;
+	}
+
+	int recordBots(const fs::path& directory, int games, int max_ticks)
+	{
+		std::error_code error;
+		fs::create_directories(directory, error);
+
+		for (int i = 0; i < games; i++)
+		{
+			//each game gets its own aliens' aim and its own bot habits,
+			//sessions are too big for the stack
+			std::unique_ptr<Session> session = std::make_unique<Session>(i + 1);
+			GameWorld& world = session->world;
+			world.reset();
+
+			uint32_t rng = 0x2545F491u * (i + 1);
+			int skill = (i * 3) % 9;
+			Replay replay;
+			replay.begin(world);
+
+			int ticks = 0;
+
+			while ((ticks < max_ticks) && !world.isGameOver())
+			{
+				WorldInput input = botInput(world, rng, skill);
+
+				session->tick(SIM_TIME_STEP, input);
+				replay.record(SIM_TIME_STEP, input);
+				ticks++;
+			}
+
+			replay.finish(world);
+
+			char name[32];
+			std::snprintf(name, sizeof(name), "bot_%03d.rpl", i);
+			fs::path path = directory / name;
+
+			if (!replay.save(path.string().c_str()))
+			{
+				std::cerr << "failed to write " << path.string() << "\n";
+				return 1;
+			}
+
+			std::cout << path.string() << ": " << ticks << " ticks, score " <<
+				world.entities.get<Pilot>(GameWorld::PLAYER)->score << "\n";
+		}
+
+		return 0;
+	}
+
+	int verify(const std::vector<std::string>& files)
+	{
+		int failed = 0;
+		std::unique_ptr<Session> session = std::make_unique<Session>();
+
+		for (const std::string& file : files)
+		{
+			Replay replay;
+
+			if (!replay.load(file.c_str()))
+			{
+				std::cout << file << ": unreadable\n";
+				failed++;
+				continue;
+			}
+
+			if (!replay.rewind(session->world))
+			{
+				std::cout << file << ": formation doesn't match\n";
+				failed++;
+				continue;
+			}
+
+			for (int i = 0; i < replay.getTicks(); i++)
+			{
+				session->tick(replay.getTimeStep(i), replay.getInput(i));
+			}
+
+			GameSnapshot result;
+			session->world.save(result);
+
+			bool match = hashSnapshot(result) == replay.getFinalHash();
+			failed += match ? 0 : 1;
+
+			std::cout << file << ": " << replay.getTicks() << " ticks, " <<
+				(match ? "ok" : "DESYNC") << "\n";
+		}
+
+		return failed ? 1 : 0;
+	}
+
+	int bench(const std::vector<std::string>& files)
+	{
+		std::unique_ptr<Session> session = std::make_unique<Session>();
+		std::vector<double> costs;
+
+		for (const std::string& file : files)
+		{
+			Replay replay;
+
+			if (!replay.load(file.c_str()) || !replay.rewind(session->world))
+			{
+				std::cerr << file << ": can't be played\n";
+				return 1;
+			}
+
+			session->particles.clear();
+
+			for (int i = 0; i < replay.getTicks(); i++)
+			{
+				float dt = replay.getTimeStep(i);
+				WorldInput input = replay.getInput(i);
+
+				Clock::time_point start = Clock::now();
+				session->tick(dt, input);
+				costs.push_back(std::chrono::duration<double, std::nano>(
+					Clock::now() - start).count());
+			}
+		}
+
+		if (costs.empty())
+		{
+			std::cerr << "no ticks to measure\n";
+			return 1;
+		}
+
+		double total = 0;
+
+		for (double cost : costs)
+		{
+			total += cost;
+		}
+
+		std::sort(costs.begin(), costs.end());
+
+		auto percentile = [&costs](double p)
+		{
+			return costs[std::min(costs.size() - 1,
+				(size_t)(p * costs.size()))];
+		};
+
+		std::cout << std::fixed << std::setprecision(1) <<
+			files.size() << " replays, " << costs.size() << " ticks\n" <<
+			"tick mean " << total / costs.size() << " ns, p50 " <<
+			percentile(0.5) << " ns, p99 " << percentile(0.99) <<
+			" ns, max " << costs.back() << " ns\n";
+
+		return 0;
+	}
+
+	//timed passes over the corpus, after one that warms caches and the
+	//allocator
+	const int PERF_PASSES = 5;
+
+	//slowdowns smaller than this are timer and scheduler noise however
+	//large they are in percent, the input phase takes tens of ns
+	const double PERF_NOISE_NS = 50;
+
+	//iterations of the reference loop per timing, about a tick's worth of
+	//mixed arithmetic and cache hits over a table the size of a world
+	const int REFERENCE_STEPS = 4096;
+
+	//part of a tick timed on its own, tick is the whole of it
+	struct Phase
+	{
+		const char* name;
+		std::vector<double> costs; //ns, one per timed tick
+		uint64_t allocations = 0; //over every timed tick
+	};
+
+	//the "name": number pairs of a report, anything else is skipped
+	bool readMetrics(const char* path, std::map<std::string, double>& metrics)
+	{
+		std::ifstream file(path);
+
+		if (!file)
+		{
+			return false;
+		}
+
+		std::stringstream text;
+		text << file.rdbuf();
+		std::string json = text.str();
+
+		size_t pos = 0;
+
+		while ((pos = json.find('"', pos)) != std::string::npos)
+		{
+			size_t end = json.find('"', pos + 1);
+
+			if (end == std::string::npos)
+			{
+				break;
+			}
+
+			std::string key = json.substr(pos + 1, end - pos - 1);
+			size_t colon = json.find_first_not_of(" \t\r\n", end + 1);
+			pos = end + 1;
+
+			if ((colon == std::string::npos) || (json[colon] != ':'))
+			{
+				continue;
+			}
+
+			const char* number = json.c_str() + colon + 1;
+			char* after = nullptr;
+			double value = std::strtod(number, &after);
+
+			if (after != number)
+			{
+				metrics[key] = value;
+			}
+		}
+
+		return true;
+	}
+
+	//ns for the reference loop, the median of rounds timings so a
+	//preempted one doesn't count
+	double timeReference(int rounds)
+	{
+		static uint32_t table[16384];
+		std::vector<double> costs;
+		uint32_t rng = 2463534242u;
+		uint32_t sum = 0;
+
+		for (int round = 0; round < rounds; round++)
+		{
+			Clock::time_point start = Clock::now();
+
+			for (int i = 0; i < REFERENCE_STEPS; i++)
+			{
+				rng ^= rng << 13;
+				rng ^= rng >> 17;
+				rng ^= rng << 5;
+
+				uint32_t& slot = table[rng & 16383];
+				slot += rng >> 7;
+				sum ^= ((slot & 1) ? slot * 3 : slot >> 1) + table[sum & 16383];
+			}
+
+			costs.push_back(std::chrono::duration<double, std::nano>(
+				Clock::now() - start).count());
+		}
+
+		//keeps the loop from being optimised away
+		table[0] += sum;
+
+		std::sort(costs.begin(), costs.end());
+		return costs[costs.size() / 2];
+	}
+
+	int perf(const char* report_path, const char* baseline_path,
+		double threshold, const std::vector<std::string>& files)
+	{
+		std::unique_ptr<Session> session = std::make_unique<Session>();
+		std::vector<Replay> replays(files.size());
+		size_t ticks = 0;
+
+		for (size_t i = 0; i < files.size(); i++)
+		{
+			if (!replays[i].load(files[i].c_str()) ||
+				!replays[i].rewind(session->world))
+			{
+				std::cerr << files[i] << ": can't be played\n";
+				return 1;
+			}
+
+			ticks += replays[i].getTicks();
+		}
+
+		if (ticks == 0)
+		{
+			std::cerr << "no ticks to measure\n";
+			return 1;
+		}
+
+		Phase phases[4] =
+		{
+			{ "tick", {}, 0 }, { "update", {}, 0 }, { "input", {}, 0 },
+			{ "particles", {}, 0 }
+		};
+
+		for (Phase& phase : phases)
+		{
+			phase.costs.reserve(ticks * PERF_PASSES);
+		}
+
+		GameWorld& world = session->world;
+		ParticleSystem& particles = session->particles;
+		std::vector<double> references;
+
+		//states the games end in, folded in corpus order
+		uint64_t corpus_hash = 0;
+		int changed = 0;
+
+		for (int pass = 0; pass <= PERF_PASSES; pass++)
+		{
+			for (Replay& replay : replays)
+			{
+				//interleaved with the games so clock changes and
+				//neighbours on the machine slow both alike
+				references.push_back(timeReference(101));
+
+				replay.rewind(world);
+				particles.clear();
+
+				for (int i = 0; i < replay.getTicks(); i++)
+				{
+					float dt = replay.getTimeStep(i);
+					WorldInput input = replay.getInput(i);
+
+					//the phases of Session::tick, one at a time
+					uint64_t counts[4];
+					Clock::time_point times[4];
+
+					counts[0] = allocations.load(std::memory_order_relaxed);
+					times[0] = Clock::now();
+					world.update(dt);
+
+					counts[1] = allocations.load(std::memory_order_relaxed);
+					times[1] = Clock::now();
+					world.applyInput(dt, input);
+
+					counts[2] = allocations.load(std::memory_order_relaxed);
+					times[2] = Clock::now();
+					particles.update(dt);
+
+					times[3] = Clock::now();
+					counts[3] = allocations.load(std::memory_order_relaxed);
+
+					if (pass == 0)
+					{
+						continue;
+					}
+
+					phases[0].costs.push_back(std::chrono::duration<double,
+						std::nano>(times[3] - times[0]).count());
+					phases[0].allocations += counts[3] - counts[0];
+
+					for (int phase = 1; phase < 4; phase++)
+					{
+						phases[phase].costs.push_back(std::chrono::duration<
+							double, std::nano>(times[phase] - times[phase - 1]).count());
+						phases[phase].allocations += counts[phase] - counts[phase - 1];
+					}
+				}
+
+				if (pass == 0)
+				{
+					GameSnapshot result;
+					world.save(result);
+
+					uint64_t hash = hashSnapshot(result);
+					changed += (hash == replay.getFinalHash()) ? 0 : 1;
+					corpus_hash = corpus_hash * 31 + hash;
+				}
+			}
+		}
+
+		//kept to 32 bits so the report's number holds it exactly
+		uint32_t corpus = (uint32_t)(corpus_hash ^ (corpus_hash >> 32));
+
+		std::sort(references.begin(), references.end());
+		double reference = references[references.size() / 2];
+
+		//this run's metrics, named as in the report
+		std::vector<std::pair<std::string, double>> metrics;
+
+		for (Phase& phase : phases)
+		{
+			std::vector<double>& costs = phase.costs;
+			std::sort(costs.begin(), costs.end());
+
+			auto percentile = [&costs](double p)
+			{
+				return costs[std::min(costs.size() - 1,
+					(size_t)(p * costs.size()))];
+			};
+
+			std::string name = phase.name;
+			metrics.emplace_back(name + ".p50_ns", percentile(0.5));
+			metrics.emplace_back(name + ".p99_ns", percentile(0.99));
+			metrics.emplace_back(name + ".max_ns", costs.back());
+			metrics.emplace_back(name + ".allocations_per_tick",
+				(double)phase.allocations / costs.size());
+		}
+
+		//slower percentiles beyond the threshold, any extra allocation
+		std::map<std::string, double> baseline;
+		bool compared = readMetrics(baseline_path, baseline);
+
+		//times scale with the machine, the reference says by how much
+		double scale = 1.0;
+
+		if (compared && (baseline["reference_ns"] > 0))
+		{
+			scale = reference / baseline["reference_ns"];
+		}
+
+		//games that don't end as they did mean the timed work changed
+		bool stale = (changed > 0) || (compared &&
+			((baseline["corpus_hash"] != (double)corpus) ||
+			(baseline["ticks"] != (double)ticks) ||
+			(baseline["replays"] != (double)files.size())));
+
+		struct Regression
+		{
+			std::string metric;
+			double baseline;
+			double current;
+		};
+
+		std::vector<Regression> regressions;
+
+		for (const auto& metric : metrics)
+		{
+			auto base = baseline.find(metric.first);
+
+			if (base == baseline.end())
+			{
+				continue;
+			}
+
+			const std::string& name = metric.first;
+			double expected = base->second;
+			bool timed = (name.find(".p50_ns") != std::string::npos) ||
+				(name.find(".p99_ns") != std::string::npos);
+			bool counted = name.find(".allocations_per_tick") != std::string::npos;
+
+			if (timed)
+			{
+				expected *= scale;
+			}
+
+			bool slower = (metric.second > expected * (1.0 + threshold / 100.0)) &&
+				(metric.second - expected > PERF_NOISE_NS);
+
+			if ((timed && slower) || (counted && (metric.second > expected + 1e-9)))
+			{
+				regressions.push_back({ name, expected, metric.second });
+			}
+		}
+
+		std::ofstream report(report_path, std::ios::trunc);
+		report << std::fixed << std::setprecision(3) <<
+			"{\n"
+			"\t\"replays\": " << files.size() << ",\n"
+			"\t\"ticks\": " << ticks << ",\n"
+			"\t\"passes\": " << PERF_PASSES << ",\n"
+			"\t\"threshold_percent\": " << threshold << ",\n"
+			"\t\"corpus_hash\": " << corpus << ",\n"
+			"\t\"reference_ns\": " << reference << ",\n"
+			"\t\"baseline_scale\": " << scale << ",\n"
+			"\t\"metrics\": {\n";
+
+		for (size_t i = 0; i < metrics.size(); i++)
+		{
+			report << "\t\t\"" << metrics[i].first << "\": " << metrics[i].second <<
+				(i + 1 < metrics.size() ? ",\n" : "\n");
+		}
+
+		report << "\t},\n\t\"regressions\": [";
+
+		for (size_t i = 0; i < regressions.size(); i++)
+		{
+			report << (i ? ",\n" : "\n") << "\t\t{ \"metric\": \"" <<
+				regressions[i].metric << "\", \"baseline\": " <<
+				regressions[i].baseline << ", \"current\": " <<
+				regressions[i].current << " }";
+		}
+
+		report << (regressions.empty() ? "],\n" : "\n\t],\n") <<
+			"\t\"compared\": " << (compared ? "true" : "false") << ",\n"
+			"\t\"stale_baseline\": " << (stale ? "true" : "false") << ",\n"
+			"\t\"passed\": " << ((regressions.empty() && !stale) ? "true" : "false") << "\n"
+			"}\n";
+
+		if (!report)
+		{
+			std::cerr << "failed to write " << report_path << "\n";
+			return 1;
+		}
+
+		//same numbers for whoever reads the log
+		std::cout << std::fixed << std::setprecision(1) << files.size() <<
+			" replays, " << ticks << " ticks x " << PERF_PASSES << " passes, reference " <<
+			reference << " ns\n";
+
+		for (size_t i = 0; i < metrics.size(); i += 4)
+		{
+			std::cout << std::left << std::setw(10) << phases[i / 4].name <<
+				std::right << " p50 " << std::setw(8) << metrics[i].second <<
+				" ns  p99 " << std::setw(8) << metrics[i + 1].second <<
+				" ns  max " << std::setw(10) << metrics[i + 2].second <<
+				" ns  " << std::setprecision(3) << metrics[i + 3].second <<
+				std::setprecision(1) << " allocations/tick\n";
+		}
+
+		if (stale)
+		{
+			if (changed > 0)
+			{
+				std::cout << "STALE CORPUS: " << changed << " of " << files.size() <<
+					" games no longer end as recorded, gameplay changed\n";
+			}
+
+			else
+			{
+				std::cout << "STALE BASELINE: recorded over another corpus\n";
+			}
+
+			std::cout << "record the corpus and the baseline again\n";
+			return 1;
+		}
+
+		if (!compared)
+		{
+			std::cout << "no baseline at " << baseline_path << ", nothing compared\n";
+			return 0;
+		}
+
+		std::cout << "baseline times scaled by " << std::setprecision(3) <<
+			scale << std::setprecision(1) << "\n";
+
+		for (const Regression& regression : regressions)
+		{
+			std::cout << "REGRESSION " << regression.metric << ": " <<
+				regression.baseline << " -> " << regression.current << "\n";
+		}
+
+		return regressions.empty() ? 0 : 1;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::string mode = (argc > 1) ? argv[1] : "";
+
+	if ((mode == "bot") && ((argc == 4) || (argc == 5)))
+	{
+		int games = std::atoi(argv[3]);
+		int max_ticks = (argc == 5) ? std::atoi(argv[4]) : 60 * 60 * 10;
+
+		return recordBots(argv[2], games, max_ticks);
+	}
+
+	if (((mode == "verify") || (mode == "bench")) && (argc > 2))
+	{
+		std::vector<std::string> files = collect(argc - 2, argv + 2);
+
+		return (mode == "verify") ? verify(files) : bench(files);
+	}
+
+	if ((mode == "perf") && (argc > 5))
+	{
+		std::vector<std::string> files = collect(argc - 5, argv + 5);
+
+		return perf(argv[2], argv[3], std::atof(argv[4]), files);
+	}
+
+	std::cerr << "usage: ReplayTool bot <output dir> <games> [max ticks]\n"
+		"       ReplayTool verify <replay or dir>...\n"
+		"       ReplayTool bench <replay or dir>...\n"
+		"       ReplayTool perf <report> <baseline> <threshold %> "
+		"<replay or dir>...\n";
+	return 1;
+}
@@ -0,0 +1,1198 @@
+#include "AssetRegistry.h"
+#include "HitMask.h"
+#include "TextureScales.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+*   Texture importer. Shrinks every texture the game draws smaller than its
+*   file to the size it is drawn at.
+*
+*   usage: TextureImporter <resources dir> <output dir> [hit mask header]
+*
+*   The scales come from Source/TextureScales.h, the same table the game
+*   creates its sprites from. Each texture drawn below its file's size is
+*   written under the output dir by the same name, Textures/Player.png
+*   drawn at 0.05 becomes Imported/Textures/Player.png at a twentieth of
+*   the size. The game mounts that directory ahead of Resources and scales
+*   sprites against the size of whichever file it loaded.
+*
+*   Pixels are averaged over the exact area each output pixel covers, in
+*   linear light with alpha premultiplied, so edges keep their colour
+*   rather than picking up the transparent black around them. Only 8-bit,
+*   non-interlaced PNGs are read, which is what the art is saved as.
+*   Output files are only rewritten when they change, and imports of
+*   textures no longer drawn smaller are removed.
+*
+*   Textures marked solid also get a hit mask, the tight box around their
+*   pixels of at least half opacity at the size they are drawn and a bit
+*   per pixel inside it. They are written to the header when one is given,
+*   which the game's collisions are compiled from.
+*/
+
+namespace fs = std::filesystem;
+
+struct Image
+{
+	uint32_t width =  0;
+	uint32_t height = 0;
+	std::vector<unsigned char> rgba; //straight alpha, rows top first
+};
+
+//inflate's view of a deflate stream, least significant bit first
+struct BitReader
+{
+	const unsigned char* data = nullptr;
+	size_t size =         0;
+	size_t pos =          0;
+	uint32_t buffer =     0;
+	int count =           0; //bits in buffer
+	bool overrun =        false;
+};
+
+//solid pixels of a texture at its drawn size
+struct Mask
+{
+	std::string enumerator; //TEXTURE_ALIEN1
+	int left =   0;         //tight box in the drawn texture
+	int top =    0;
+	int width =  0;
+	int height = 0;
+	std::vector<uint64_t> rows; //bit n is n pixels from left
+};
+
+//canonical huffman code, codes of each length and symbols in code order
+struct Huffman
+{
+	uint16_t count[16] = {};
+	uint16_t symbol[288] = {};
+};
+
+//alpha a pixel needs to be solid
+static const int MASK_ALPHA = 128;
+
+static const unsigned char PNG_SIGNATURE[8] =
+	{ 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+
+
+static uint32_t readBigU32(const unsigned char* bytes)
+{
+	return ((uint32_t)bytes[0] << 24) | (bytes[1] << 16) | (bytes[2] << 8) |
+		bytes[3];
+}
+
+
+
+static void writeBigU32(std::vector<unsigned char>& out, uint32_t value)
+{
+	out.push_back((unsigned char)(value >> 24));
+	out.push_back((unsigned char)(value >> 16));
+	out.push_back((unsigned char)(value >> 8));
+	out.push_back((unsigned char)value);
+}
+
+
+
+static bool readFile(const fs::path& path, std::vector<unsigned char>& bytes)
+{
+	std::ifstream file(path, std::ios::binary);
+
+	if (!file)
+	{
+		return false;
+	}
+
+	bytes.assign(std::istreambuf_iterator<char>(file),
+		std::istreambuf_iterator<char>());
+
+	return true;
+}
+
+
+
+static uint32_t crc32(const unsigned char* bytes, size_t size,
+	uint32_t crc = 0)
+{
+	static uint32_t table[256] = {};
+
+	if (table[1] == 0)
+	{
+		for (uint32_t i = 0; i < 256; i++)
+		{
+			uint32_t c = i;
+
+			for (int k = 0; k < 8; k++)
+			{
+				c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+			}
+
+			table[i] = c;
+		}
+	}
+
+	crc = ~crc;
+
+	for (size_t i = 0; i < size; i++)
+	{
+		crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+	}
+
+	return ~crc;
+}
+
+
+
+static uint32_t adler32(const unsigned char* bytes, size_t size)
+{
+	uint32_t a = 1;
+	uint32_t b = 0;
+
+	for (size_t i = 0; i < size; i++)
+	{
+		a = (a + bytes[i]) % 65521;
+		b = (b + a) % 65521;
+	}
+
+	return (b << 16) | a;
+}
+
+
+
+static uint32_t bits(BitReader& in, int needed)
+{
+	while (in.count < needed)
+	{
+		if (in.pos >= in.size)
+		{
+			in.overrun = true;
+			return 0;
+		}
+
+		in.buffer |= (uint32_t)in.data[in.pos++] << in.count;
+		in.count += 8;
+	}
+
+	uint32_t value = in.buffer & ((1u << needed) - 1);
+	in.buffer >>= needed;
+	in.count -= needed;
+
+	return value;
+}
+
+
+
+static void buildHuffman(Huffman& code, const uint8_t* lengths, int symbols)
+{
+	uint16_t offsets[16] = {};
+	std::memset(code.count, 0, sizeof(code.count));
+
+	for (int i = 0; i < symbols; i++)
+	{
+		code.count[lengths[i]]++;
+	}
+
+	code.count[0] = 0;
+
+	for (int length = 1; length < 15; length++)
+	{
+		offsets[length + 1] = offsets[length] + code.count[length];
+	}
+
+	for (int i = 0; i < symbols; i++)
+	{
+		if (lengths[i] != 0)
+		{
+			code.symbol[offsets[lengths[i]]++] = (uint16_t)i;
+		}
+	}
+}
+
+
+
+static int decodeSymbol(BitReader& in, const Huffman& code)
+{
+	//walk down one length at a time, codes of a length are consecutive
+	int value = 0;
+	int first = 0;
+	int index = 0;
+
+	for (int length = 1; length < 16; length++)
+	{
+		value |= (int)bits(in, 1);
+		int count = code.count[length];
+
+		if (value - first < count)
+		{
+			return code.symbol[index + value - first];
+		}
+
+		index += count;
+		first = (first + count) << 1;
+		value <<= 1;
+	}
+
+	return -1;
+}
+
+
+
+static bool inflateCodes(BitReader& in, const Huffman& lengths,
+	const Huffman& distances, std::vector<unsigned char>& out)
+{
+	static const uint16_t LENGTH_BASE[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11,
+		13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131,
+		163, 195, 227, 258 };
+	static const uint8_t LENGTH_EXTRA[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1,
+		1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+	static const uint16_t DISTANCE_BASE[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17,
+		25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049,
+		3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+	static const uint8_t DISTANCE_EXTRA[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3,
+		4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+	while (!in.overrun)
+	{
+		int symbol = decodeSymbol(in, lengths);
+
+		if ((symbol < 0) || (symbol > 285))
+		{
+			return false;
+		}
+
+		if (symbol < 256)
+		{
+			out.push_back((unsigned char)symbol);
+			continue;
+		}
+
+		if (symbol == 256)
+		{
+			return true;
+		}
+
+		//a copy of earlier output
+		symbol -= 257;
+		size_t length = LENGTH_BASE[symbol] + bits(in, LENGTH_EXTRA[symbol]);
+
+		int distance_symbol = decodeSymbol(in, distances);
+
+		if ((distance_symbol < 0) || (distance_symbol > 29))
+		{
+			return false;
+		}
+
+		size_t distance = DISTANCE_BASE[distance_symbol] +
+			bits(in, DISTANCE_EXTRA[distance_symbol]);
+
+		if (distance > out.size())
+		{
+			return false;
+		}
+
+		size_t from = out.size() - distance;
+
+		for (size_t i = 0; i < length; i++)
+		{
+			out.push_back(out[from + i]);
+		}
+	}
+
+	return false;
+}
+
+
+
+static bool inflateDynamic(BitReader& in, std::vector<unsigned char>& out)
+{
+	static const uint8_t ORDER[19] =
+		{ 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+	int length_count = (int)bits(in, 5) + 257;
+	int distance_count = (int)bits(in, 5) + 1;
+	int code_count = (int)bits(in, 4) + 4;
+
+	if ((length_count > 286) || (distance_count > 30))
+	{
+		return false;
+	}
+
+	//lengths of the code the code lengths are written in
+	uint8_t lengths[286 + 30] = {};
+
+	for (int i = 0; i < code_count; i++)
+	{
+		lengths[ORDER[i]] = (uint8_t)bits(in, 3);
+	}
+
+	Huffman code_lengths;
+	buildHuffman(code_lengths, lengths, 19);
+	std::memset(lengths, 0, sizeof(lengths));
+
+	int i = 0;
+
+	while (i < length_count + distance_count)
+	{
+		int symbol = decodeSymbol(in, code_lengths);
+
+		if ((symbol < 0) || in.overrun)
+		{
+			return false;
+		}
+
+		if (symbol < 16)
+		{
+			lengths[i++] = (uint8_t)symbol;
+			continue;
+		}
+
+		//runs of the previous length or of zeros
+		uint8_t repeated = 0;
+		int run = 0;
+
+		if (symbol == 16)
+		{
+			if (i == 0)
+			{
+				return false;
+			}
+
+			repeated = lengths[i - 1];
+			run = 3 + (int)bits(in, 2);
+		}
+
+		else if (symbol == 17)
+		{
+			run = 3 + (int)bits(in, 3);
+		}
+
+		else
+		{
+			run = 11 + (int)bits(in, 7);
+		}
+
+		if (i + run > length_count + distance_count)
+		{
+			return false;
+		}
+
+		while (run-- > 0)
+		{
+			lengths[i++] = repeated;
+		}
+	}
+
+	Huffman literal;
+	Huffman distance;
+	buildHuffman(literal, lengths, length_count);
+	buildHuffman(distance, lengths + length_count, distance_count);
+
+	return inflateCodes(in, literal, distance, out);
+}
+
+
+
+static bool inflateFixed(BitReader& in, std::vector<unsigned char>& out)
+{
+	static Huffman literal;
+	static Huffman distance;
+
+	if (literal.count[7] == 0)
+	{
+		uint8_t lengths[288];
+
+		std::fill(lengths, lengths + 144, (uint8_t)8);
+		std::fill(lengths + 144, lengths + 256, (uint8_t)9);
+		std::fill(lengths + 256, lengths + 280, (uint8_t)7);
+		std::fill(lengths + 280, lengths + 288, (uint8_t)8);
+		buildHuffman(literal, lengths, 288);
+
+		std::fill(lengths, lengths + 30, (uint8_t)5);
+		buildHuffman(distance, lengths, 30);
+	}
+
+	return inflateCodes(in, literal, distance, out);
+}
+
+
+
+static bool inflateZlib(const std::vector<unsigned char>& stream,
+	std::vector<unsigned char>& out)
+{
+	//two byte header, deflate with no preset dictionary
+	if ((stream.size() < 6) || ((stream[0] & 0x0F) != 8) ||
+		(((stream[0] << 8) | stream[1]) % 31 != 0) || (stream[1] & 0x20))
+	{
+		return false;
+	}
+
+	BitReader in;
+	in.data = stream.data() + 2;
+	in.size = stream.size() - 2;
+
+	bool last = false;
+
+	while (!last)
+	{
+		last = bits(in, 1) == 1;
+		uint32_t type = bits(in, 2);
+		bool read = false;
+
+		if (type == 0)
+		{
+			//stored, byte aligned with its length and complement
+			in.buffer = 0;
+			in.count = 0;
+
+			if (in.pos + 4 > in.size)
+			{
+				return false;
+			}
+
+			size_t length = in.data[in.pos] | (in.data[in.pos + 1] << 8);
+			in.pos += 4;
+
+			if (in.pos + length > in.size)
+			{
+				return false;
+			}
+
+			out.insert(out.end(), in.data + in.pos, in.data + in.pos + length);
+			in.pos += length;
+			read = true;
+		}
+
+		else if (type == 1)
+		{
+			read = inflateFixed(in, out);
+		}
+
+		else if (type == 2)
+		{
+			read = inflateDynamic(in, out);
+		}
+
+		if (!read || in.overrun)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+
+static unsigned char paeth(int left, int up, int up_left)
+{
+	int estimate = left + up - up_left;
+	int to_left = std::abs(estimate - left);
+	int to_up = std::abs(estimate - up);
+	int to_up_left = std::abs(estimate - up_left);
+
+	if ((to_left <= to_up) && (to_left <= to_up_left))
+	{
+		return (unsigned char)left;
+	}
+
+	return (unsigned char)((to_up <= to_up_left) ? up : up_left);
+}
+
+
+
+static bool decodePng(const std::vector<unsigned char>& file, Image& image)
+{
+	if ((file.size() < 8) || (memcmp(file.data(), PNG_SIGNATURE, 8) != 0))
+	{
+		return false;
+	}
+
+	int depth = 0;
+	int colour = 0;
+	int interlace = 0;
+	unsigned char palette[256][4] = {};
+	std::vector<unsigned char> compressed;
+
+	//chunks up to IEND, IDATs joined into one zlib stream
+	size_t pos = 8;
+
+	while (pos + 12 <= file.size())
+	{
+		uint32_t length = readBigU32(file.data() + pos);
+		const unsigned char* type = file.data() + pos + 4;
+		const unsigned char* data = file.data() + pos + 8;
+
+		if (pos + 12 + length > file.size())
+		{
+			return false;
+		}
+
+		if ((memcmp(type, "IHDR", 4) == 0) && (length >= 13))
+		{
+			image.width = readBigU32(data);
+			image.height = readBigU32(data + 4);
+			depth = data[8];
+			colour = data[9];
+			interlace = data[12];
+		}
+
+		else if (memcmp(type, "PLTE", 4) == 0)
+		{
+			for (uint32_t i = 0; (i < length / 3) && (i < 256); i++)
+			{
+				palette[i][0] = data[i * 3];
+				palette[i][1] = data[i * 3 + 1];
+				palette[i][2] = data[i * 3 + 2];
+				palette[i][3] = 255;
+			}
+		}
+
+		else if ((memcmp(type, "tRNS", 4) == 0) && (colour == 3))
+		{
+			for (uint32_t i = 0; (i < length) && (i < 256); i++)
+			{
+				palette[i][3] = data[i];
+			}
+		}
+
+		else if (memcmp(type, "IDAT", 4) == 0)
+		{
+			compressed.insert(compressed.end(), data, data + length);
+		}
+
+		else if (memcmp(type, "IEND", 4) == 0)
+		{
+			break;
+		}
+
+		pos += 12 + length;
+	}
+
+	static const int CHANNELS[7] = { 1, 0, 3, 1, 2, 0, 4 };
+
+	if ((depth != 8) || (interlace != 0) || (colour > 6) ||
+		(CHANNELS[colour] == 0) || (image.width == 0) || (image.height == 0))
+	{
+		return false;
+	}
+
+	std::vector<unsigned char> filtered;
+
+	int channels = CHANNELS[colour];
+	size_t stride = (size_t)image.width * channels;
+
+	if (!inflateZlib(compressed, filtered) ||
+		(filtered.size() < (stride + 1) * image.height))
+	{
+		return false;
+	}
+
+	//undo each row's filter in place, against the row above
+	std::vector<unsigned char> pixels(stride * image.height);
+
+	for (uint32_t y = 0; y < image.height; y++)
+	{
+		int filter = filtered[y * (stride + 1)];
+		const unsigned char* in = filtered.data() + y * (stride + 1) + 1;
+		unsigned char* row = pixels.data() + y * stride;
+		const unsigned char* above = y ? row - stride : nullptr;
+
+		for (size_t x = 0; x < stride; x++)
+		{
+			int left = (x >= (size_t)channels) ? row[x - channels] : 0;
+			int up = above ? above[x] : 0;
+			int up_left = (above && (x >= (size_t)channels)) ?
+				above[x - channels] : 0;
+
+			switch (filter)
+			{
+			case 0:
+				row[x] = in[x];
+				break;
+
+			case 1:
+				row[x] = (unsigned char)(in[x] + left);
+				break;
+
+			case 2:
+				row[x] = (unsigned char)(in[x] + up);
+				break;
+
+			case 3:
+				row[x] = (unsigned char)(in[x] + ((left + up) >> 1));
+				break;
+
+			case 4:
+				row[x] = (unsigned char)(in[x] + paeth(left, up, up_left));
+				break;
+
+			default:
+				return false;
+			}
+		}
+	}
+
+	//everything out as rgba
+	image.rgba.resize((size_t)image.width * image.height * 4);
+
+	for (size_t i = 0; i < (size_t)image.width * image.height; i++)
+	{
+		const unsigned char* in = pixels.data() + i * channels;
+		unsigned char* out = image.rgba.data() + i * 4;
+
+		switch (colour)
+		{
+		case 0:
+			out[0] = out[1] = out[2] = in[0];
+			out[3] = 255;
+			break;
+
+		case 2:
+			std::memcpy(out, in, 3);
+			out[3] = 255;
+			break;
+
+		case 3:
+			std::memcpy(out, palette[in[0]], 4);
+			break;
+
+		case 4:
+			out[0] = out[1] = out[2] = in[0];
+			out[3] = in[1];
+			break;
+
+		default:
+			std::memcpy(out, in, 4);
+			break;
+		}
+	}
+
+	return true;
+}
+
+
+
+static void writeChunk(std::vector<unsigned char>& out, const char* type,
+	const std::vector<unsigned char>& data)
+{
+	writeBigU32(out, (uint32_t)data.size());
+
+	size_t start = out.size();
+	out.insert(out.end(), type, type + 4);
+	out.insert(out.end(), data.begin(), data.end());
+
+	writeBigU32(out, crc32(out.data() + start, out.size() - start));
+}
+
+
+
+static std::vector<unsigned char> encodePng(const Image& image)
+{
+	std::vector<unsigned char> file(PNG_SIGNATURE, PNG_SIGNATURE + 8);
+
+	//8-bit rgba, not interlaced
+	std::vector<unsigned char> header;
+	writeBigU32(header, image.width);
+	writeBigU32(header, image.height);
+	header.insert(header.end(), { 8, 6, 0, 0, 0 });
+	writeChunk(file, "IHDR", header);
+
+	//rows unfiltered in stored deflate blocks, imports are small enough
+	//that compressing them isn't worth the code
+	size_t stride = (size_t)image.width * 4;
+	std::vector<unsigned char> raw;
+
+	for (uint32_t y = 0; y < image.height; y++)
+	{
+		raw.push_back(0);
+		raw.insert(raw.end(), image.rgba.begin() + y * stride,
+			image.rgba.begin() + (y + 1) * stride);
+	}
+
+	std::vector<unsigned char> stream = { 0x78, 0x01 };
+
+	for (size_t pos = 0; (pos < raw.size()) || (pos == 0); pos += 65535)
+	{
+		size_t length = std::min(raw.size() - pos, (size_t)65535);
+		bool last = pos + length == raw.size();
+
+		stream.push_back(last ? 1 : 0);
+		stream.push_back((unsigned char)length);
+		stream.push_back((unsigned char)(length >> 8));
+		stream.push_back((unsigned char)~length);
+		stream.push_back((unsigned char)(~length >> 8));
+		stream.insert(stream.end(), raw.begin() + pos,
+			raw.begin() + pos + length);
+	}
+
+	writeBigU32(stream, adler32(raw.data(), raw.size()));
+	writeChunk(file, "IDAT", stream);
+	writeChunk(file, "IEND", {});
+
+	return file;
+}
+
+
+
+static float toLinear(unsigned char value)
+{
+	float c = value / 255.0f;
+
+	return (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+
+
+static unsigned char toSrgb(float c)
+{
+	c = std::min(std::max(c, 0.0f), 1.0f);
+	c = (c <= 0.0031308f) ? c * 12.92f : 1.055f * std::pow(c, 1 / 2.4f) - 0.055f;
+
+	return (unsigned char)std::lround(c * 255.0f);
+}
+
+
+
+//weight of every source pixel in each output pixel along one axis, the
+//output pixel covering [i * ratio, (i + 1) * ratio) of the source
+struct Footprint
+{
+	uint32_t first = 0;
+	std::vector<float> weights;
+};
+
+
+
+static std::vector<Footprint> footprints(uint32_t from, uint32_t to)
+{
+	std::vector<Footprint> out(to);
+	double ratio = (double)from / to;
+
+	for (uint32_t i = 0; i < to; i++)
+	{
+		double start = i * ratio;
+		double end = std::min((i + 1) * ratio, (double)from);
+
+		out[i].first = (uint32_t)start;
+
+		for (uint32_t s = out[i].first; s < end; s++)
+		{
+			double covered = std::min(end, s + 1.0) - std::max(start, (double)s);
+			out[i].weights.push_back((float)(covered / ratio));
+		}
+	}
+
+	return out;
+}
+
+
+
+static Image downscale(const Image& source, uint32_t width, uint32_t height)
+{
+	//premultiplied linear light, so transparent pixels add no colour
+	float linear[256];
+
+	for (int i = 0; i < 256; i++)
+	{
+		linear[i] = toLinear((unsigned char)i);
+	}
+
+	std::vector<float> premultiplied((size_t)source.width * source.height * 4);
+
+	for (size_t i = 0; i < (size_t)source.width * source.height; i++)
+	{
+		const unsigned char* in = source.rgba.data() + i * 4;
+		float alpha = in[3] / 255.0f;
+
+		premultiplied[i * 4] = linear[in[0]] * alpha;
+		premultiplied[i * 4 + 1] = linear[in[1]] * alpha;
+		premultiplied[i * 4 + 2] = linear[in[2]] * alpha;
+		premultiplied[i * 4 + 3] = alpha;
+	}
+
+	//across then down, each pass a weighted sum over the footprint
+	std::vector<Footprint> across = footprints(source.width, width);
+	std::vector<Footprint> down = footprints(source.height, height);
+	std::vector<float> narrow((size_t)width * source.height * 4, 0.0f);
+
+	for (uint32_t y = 0; y < source.height; y++)
+	{
+		for (uint32_t x = 0; x < width; x++)
+		{
+			float* out = narrow.data() + ((size_t)y * width + x) * 4;
+			const float* in = premultiplied.data() +
+				((size_t)y * source.width + across[x].first) * 4;
+
+			for (float weight : across[x].weights)
+			{
+				for (int c = 0; c < 4; c++)
+				{
+					out[c] += in[c] * weight;
+				}
+
+				in += 4;
+			}
+		}
+	}
+
+	Image image;
+	image.width = width;
+	image.height = height;
+	image.rgba.resize((size_t)width * height * 4);
+
+	for (uint32_t y = 0; y < height; y++)
+	{
+		for (uint32_t x = 0; x < width; x++)
+		{
+			float sum[4] = {};
+			const float* in = narrow.data() +
+				((size_t)down[y].first * width + x) * 4;
+
+			for (float weight : down[y].weights)
+			{
+				for (int c = 0; c < 4; c++)
+				{
+					sum[c] += in[c] * weight;
+				}
+
+				in += (size_t)width * 4;
+			}
+
+			//back to straight alpha for the file
+			unsigned char* out = image.rgba.data() + ((size_t)y * width + x) * 4;
+			float alpha = std::min(sum[3], 1.0f);
+
+			for (int c = 0; c < 3; c++)
+			{
+				out[c] = (alpha > 0) ? toSrgb(sum[c] / alpha) : 0;
+			}
+
+			out[3] = (unsigned char)std::lround(alpha * 255.0f);
+		}
+	}
+
+	return image;
+}
+
+
+
+//nearest pixel, for textures drawn at or above their size
+static Image resample(const Image& source, uint32_t width, uint32_t height)
+{
+	Image image;
+	image.width = width;
+	image.height = height;
+	image.rgba.resize((size_t)width * height * 4);
+
+	for (uint32_t y = 0; y < height; y++)
+	{
+		uint32_t from_y = (uint32_t)((uint64_t)y * source.height / height);
+
+		for (uint32_t x = 0; x < width; x++)
+		{
+			uint32_t from_x = (uint32_t)((uint64_t)x * source.width / width);
+
+			std::memcpy(image.rgba.data() + ((size_t)y * width + x) * 4,
+				source.rgba.data() + ((size_t)from_y * source.width + from_x) * 4,
+				4);
+		}
+	}
+
+	return image;
+}
+
+
+
+static bool buildMask(const Image& image, Mask& mask)
+{
+	//tight box around the opaque pixels first
+	int left = (int)image.width;
+	int top = (int)image.height;
+	int right = -1;
+	int bottom = -1;
+
+	for (int y = 0; y < (int)image.height; y++)
+	{
+		for (int x = 0; x < (int)image.width; x++)
+		{
+			if (image.rgba[((size_t)y * image.width + x) * 4 + 3] >= MASK_ALPHA)
+			{
+				left = std::min(left, x);
+				top = std::min(top, y);
+				right = std::max(right, x);
+				bottom = std::max(bottom, y);
+			}
+		}
+	}
+
+	//nothing opaque, nothing to hit
+	if (right < 0)
+	{
+		return true;
+	}
+
+	mask.left = left;
+	mask.top = top;
+	mask.width = right - left + 1;
+	mask.height = bottom - top + 1;
+
+	if ((mask.width > HIT_MASK_MAX) || (mask.height > HIT_MASK_MAX))
+	{
+		return false;
+	}
+
+	for (int y = top; y <= bottom; y++)
+	{
+		uint64_t row = 0;
+
+		for (int x = left; x <= right; x++)
+		{
+			if (image.rgba[((size_t)y * image.width + x) * 4 + 3] >= MASK_ALPHA)
+			{
+				row |= 1ull << (x - left);
+			}
+		}
+
+		mask.rows.push_back(row);
+	}
+
+	return true;
+}
+
+
+
+//upper case, camel case and punctuation split with underscores, the same
+//names AssetRegistry gives
+static std::string toEnumerator(const std::string& text)
+{
+	std::string out;
+
+	for (size_t i = 0; i < text.size(); i++)
+	{
+		unsigned char c = (unsigned char)text[i];
+
+		if (!std::isalnum(c))
+		{
+			if (!out.empty() && (out.back() != '_'))
+			{
+				out += '_';
+			}
+
+			continue;
+		}
+
+		if ((i > 0) && std::isupper(c) &&
+			std::islower((unsigned char)text[i - 1]) && (out.back() != '_'))
+		{
+			out += '_';
+		}
+
+		out += (char)std::toupper(c);
+	}
+
+	while (!out.empty() && (out.back() == '_'))
+	{
+		out.pop_back();
+	}
+
+	return out;
+}
+
+
+
+static std::string generate(const std::vector<Mask>& masks)
+{
+	std::ostringstream out;
+
+	out <<
+		"#pragma once\n"
+		"#include \"HitMask.h\"\n"
+		"\n"
+		"/** @file HitMasks.h\n"
+		"    @brief   Solid pixels of the solid textures, generated by\n"
+		"             Tools/TextureImporter.\n"
+		"    @details Do not edit, the build regenerates this from the textures\n"
+		"             marked solid in TextureScales.h, at the size each is drawn.\n"
+		"             A pixel is solid from half opacity up. Only HitMask.cpp\n"
+		"             includes it.\n"
+		"*/\n";
+
+	for (const Mask& mask : masks)
+	{
+		if (mask.rows.empty())
+		{
+			continue;
+		}
+
+		out << "\nconstexpr uint64_t HIT_ROWS_" << mask.enumerator.substr(8) <<
+			"[" << mask.rows.size() << "] =\n{\n";
+
+		for (size_t i = 0; i < mask.rows.size(); i++)
+		{
+			char row[32];
+			std::snprintf(row, sizeof(row), "0x%016llxull",
+				(unsigned long long)mask.rows[i]);
+
+			out << "\t" << row << (i + 1 < mask.rows.size() ? "," : "") << "\n";
+		}
+
+		out << "};\n";
+	}
+
+	out << "\nconstexpr HitMask HIT_MASKS[] =\n{\n";
+
+	for (size_t i = 0; i < masks.size(); i++)
+	{
+		const Mask& mask = masks[i];
+
+		out << "\t{ " << mask.enumerator << ", " << mask.left << ", " <<
+			mask.top << ", " << mask.width << ", " << mask.height << ", " <<
+			(mask.rows.empty() ? "nullptr" : "HIT_ROWS_" + mask.enumerator.substr(8)) <<
+			" }" << (i + 1 < masks.size() ? "," : "") << "\n";
+	}
+
+	out << "};\n";
+
+	return out.str();
+}
+
+
+
+static bool writeIfChanged(const fs::path& path,
+	const std::vector<unsigned char>& bytes)
+{
+	std::vector<unsigned char> existing;
+
+	if (readFile(path, existing) && (existing == bytes))
+	{
+		return true;
+	}
+
+	std::error_code error;
+	fs::create_directories(path.parent_path(), error);
+
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	out.write((const char*)bytes.data(), bytes.size());
+
+	return (bool)out;
+}
+
+
+
+int main(int argc, char* argv[])
+{
+	if ((argc != 3) && (argc != 4))
+	{
+		std::cerr << "usage: TextureImporter <resources dir> <output dir> "
+			"[hit mask header]\n";
+		return 1;
+	}
+
+	fs::path root = argv[1];
+	fs::path output = argv[2];
+
+	int imported = 0;
+	std::vector<Mask> masks;
+
+	for (const TextureScale& entry : TEXTURE_SCALES)
+	{
+		const AssetInfo& info = ASSET_INFO[entry.texture];
+		fs::path target = output / info.name;
+
+		uint32_t width = (uint32_t)std::lround(info.width * entry.scale);
+		uint32_t height = (uint32_t)std::lround(info.height * entry.scale);
+
+		//drawn at or above its size, the original is used as it is
+		bool shrink = (info.format == AssetFormat::PNG) &&
+			(entry.scale < 1.0f) && (width < info.width) &&
+			(height < info.height);
+
+		if (!shrink)
+		{
+			std::error_code error;
+			fs::remove(target, error);
+
+			if (!entry.solid)
+			{
+				continue;
+			}
+		}
+
+		std::vector<unsigned char> bytes;
+		Image source;
+
+		if (!readFile(root / info.name, bytes) || !decodePng(bytes, source))
+		{
+			std::cerr << "can't read " << info.name << "\n";
+			return 1;
+		}
+
+		//sized from the file rather than the registry, it may be newer
+		width = std::max<uint32_t>(1, (uint32_t)std::lround(source.width * entry.scale));
+		height = std::max<uint32_t>(1, (uint32_t)std::lround(source.height * entry.scale));
+
+		Image image = shrink ? downscale(source, width, height) :
+			resample(source, width, height);
+
+		if (entry.solid)
+		{
+			Mask mask;
+
+			if (!buildMask(image, mask))
+			{
+				std::cerr << info.name << " is solid over more than " <<
+					HIT_MASK_MAX << " pixels\n";
+				return 1;
+			}
+
+			mask.enumerator = "TEXTURE_" +
+				toEnumerator(fs::path(info.name).stem().string());
+			masks.push_back(mask);
+		}
+
+		if (!shrink)
+		{
+			continue;
+		}
+
+		if (!writeIfChanged(target, encodePng(image)))
+		{
+			std::cerr << "failed to write " << target << "\n";
+			return 1;
+		}
+
+		std::cout << info.name << ": " << source.width << "x" <<
+			source.height << " to " << width << "x" << height << "\n";
+
+		imported++;
+	}
+
+	std::cout << output.string() << ": " << imported << " textures\n";
+
+	if (argc == 4)
+	{
+		std::string header = generate(masks);
+
+		if (!writeIfChanged(argv[3],
+			std::vector<unsigned char>(header.begin(), header.end())))
+		{
+			std::cerr << "failed to write " << argv[3] << "\n";
+			return 1;
+		}
+
+		std::cout << argv[3] << ": " << masks.size() << " hit masks\n";
+	}
+
+	return 0;
+}
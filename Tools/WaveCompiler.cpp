@@ -0,0 +1,56 @@
+#include "WaveConfig.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+/**
+*   Wave compiler. Turns the Waves.txt wave and difficulty definitions
+*   into the flat table the game loads at start up.
+*
+*   usage: WaveCompiler <Waves.txt> <Waves.bin>
+*
+*   The whole file is validated here so the game never has to report a
+*   typo in the config, it only has to check the header of the table.
+*/
+
+int main(int argc, char** argv)
+{
+	if (argc != 3)
+	{
+		std::cerr << "usage: WaveCompiler <Waves.txt> <Waves.bin>\n";
+		return 1;
+	}
+
+	std::ifstream source(argv[1]);
+	if (!source)
+	{
+		std::cerr << "failed to read " << argv[1] << "\n";
+		return 1;
+	}
+
+	std::stringstream text;
+	text << source.rdbuf();
+
+	WaveTable table;
+	std::string error;
+
+	if (!parseWaves(text.str(), table, error))
+	{
+		std::cerr << argv[1] << ": " << error << "\n";
+		return 1;
+	}
+
+	if (!saveWaves(argv[2], table))
+	{
+		std::cerr << "failed to write " << argv[2] << "\n";
+		return 1;
+	}
+
+	std::cout << argv[2] << ": " << table.rows << "x" << table.columns <<
+		" formation, " << table.difficulty_count << " difficulty steps, " <<
+		sizeof(table) << " bytes\n";
+
+	return 0;
+}
@@ -0,0 +1,37 @@
+#!/bin/sh
+# Builds the release and profile guided presets and compares what one
+# gameplay tick costs in each, playing the same replays through both.
+#
+# usage: Tools/pgo.sh [replay dir]
+#
+# The replays are what the instrumented build trains on. Without a
+# replay dir a bot corpus is recorded first. Run from the repository
+# root.
+set -e
+
+jobs=$(nproc 2>/dev/null || echo 4)
+replays=${1:-Builds/replays}
+
+cmake --preset release
+cmake --build --preset release -j "$jobs"
+
+if [ -z "$1" ]; then
+	Builds/release/ReplayTool bot "$replays" 24
+fi
+
+# the build tree is elsewhere, so pgo_train is given an absolute path
+replays=$(cd "$replays" && pwd)
+
+# instrument, train, rebuild from the profile in the same tree
+rm -rf Builds/pgo/profiles
+cmake --preset pgo-generate -DINVADERS_PGO_REPLAYS="$replays"
+cmake --build --preset pgo-generate -j "$jobs"
+cmake --build --preset pgo-generate --target pgo_train
+cmake --preset pgo-use
+cmake --build --preset pgo-use -j "$jobs"
+
+echo
+echo "release:"
+Builds/release/ReplayTool bench "$replays"
+echo "pgo:"
+Builds/pgo/ReplayTool bench "$replays"